@@ -10,6 +10,10 @@ macro(add_stringy_header header)
     list(APPEND HEADER_FILES $<BUILD_INTERFACE:${CMAKE_CURRENT_SOURCE_DIR}/include/stringy/${header}>)
 endmacro(add_stringy_header)
 
+macro(add_codey_header header)
+    list(APPEND HEADER_FILES $<BUILD_INTERFACE:${CMAKE_CURRENT_SOURCE_DIR}/include/codey/${header}>)
+endmacro(add_codey_header)
+
 macro(add_header header)
     add_funcy_header(${header})
     add_texy_header(${header})
@@ -21,6 +25,10 @@ macro(tmp_add_header header)
     add_texy_header(${header})
 endmacro(tmp_add_header)
 
+add_funcy_header(batch.hh HEADER_FILES)
+add_funcy_header(parallel_batch.hh HEADER_FILES)
+add_funcy_header(stateless.hh HEADER_FILES)
+add_funcy_header(profile.hh HEADER_FILES)
 add_funcy_header(concept_check.hh HEADER_FILES)
 add_funcy_header(concepts.hh HEADER_FILES)
 add_header(constant.hh HEADER_FILES)
@@ -35,6 +43,7 @@ add_header(variable.hh HEADER_FILES)
 
 add_header(cmath/arccos.hh HEADER_FILES)
 add_header(cmath/arcsine.hh HEADER_FILES)
+add_funcy_header(cmath/auto_diff.hh HEADER_FILES)
 add_header(cmath/cosine.hh HEADER_FILES)
 add_funcy_header(cmath/erf.hh HEADER_FILES)
 add_header(cmath/exp.hh HEADER_FILES)
@@ -55,16 +64,20 @@ add_funcy_header(examples/biomechanics/adipose_tissue_sommer_holzapfel.hh HEADER
 add_funcy_header(examples/biomechanics/muscle_tissue_martins.hh HEADER_FILES)
 add_funcy_header(examples/biomechanics/skin_tissue_hendriks.hh HEADER_FILES)
 
+add_funcy_header(linear_algebra/basis_direction.hh HEADER_FILES)
 tmp_add_header(linear_algebra/cofactor.hh HEADER_FILES)
 tmp_add_header(linear_algebra/determinant.hh HEADER_FILES)
 tmp_add_header(linear_algebra/deviator.hh HEADER_FILES)
 tmp_add_header(linear_algebra/deviatoric_invariants.hh HEADER_FILES)
 add_funcy_header(linear_algebra/dimension.hh HEADER_FILES)
 tmp_add_header(linear_algebra/frobenius_norm.hh HEADER_FILES)
+add_funcy_header(linear_algebra/isochoric_invariants.hh HEADER_FILES)
+add_funcy_header(linear_algebra/lu_decomposition.hh HEADER_FILES)
 tmp_add_header(linear_algebra/mixed_invariants.hh HEADER_FILES)
 tmp_add_header(linear_algebra/principal_invariants.hh HEADER_FILES)
 add_funcy_header(linear_algebra/rows_and_cols.hh HEADER_FILES)
 tmp_add_header(linear_algebra/strain_tensor.hh HEADER_FILES)
+add_funcy_header(linear_algebra/symmetric_matrix.hh HEADER_FILES)
 add_funcy_header(linear_algebra/tensor_product.hh HEADER_FILES)
 tmp_add_header(linear_algebra/trace.hh HEADER_FILES)
 tmp_add_header(linear_algebra/transpose.hh HEADER_FILES)
@@ -85,20 +98,35 @@ add_funcy_header(util/compute_chain.hh HEADER_FILES)
 add_funcy_header(util/compute_dot.hh HEADER_FILES)
 add_funcy_header(util/compute_product.hh HEADER_FILES)
 add_funcy_header(util/compute_sum.hh HEADER_FILES)
+add_funcy_header(util/derivative_cache.hh HEADER_FILES)
 add_funcy_header(util/derivative_wrappers.hh HEADER_FILES)
 add_funcy_header(util/evaluate_if_present.hh HEADER_FILES)
+add_funcy_header(util/evaluation_order.hh HEADER_FILES)
 add_funcy_header(util/exceptions.hh HEADER_FILES)
 add_funcy_header(util/extract_rows_and_cols.hh HEADER_FILES)
+add_funcy_header(util/fused_derivatives.hh HEADER_FILES)
 add_funcy_header(util/indexed_type.hh HEADER_FILES)
 add_funcy_header(util/macros.hh HEADER_FILES)
 add_funcy_header(util/mathop_traits.hh HEADER_FILES)
+add_funcy_header(util/node_state.hh HEADER_FILES)
+add_funcy_header(util/packed_storage.hh HEADER_FILES)
+add_funcy_header(util/simd.hh HEADER_FILES)
+add_funcy_header(util/simd_eigen.hh HEADER_FILES)
 add_funcy_header(util/static_checks.hh HEADER_FILES)
 add_funcy_header(util/static_checks_nrows_ncols.hh HEADER_FILES)
+add_funcy_header(util/storage.hh HEADER_FILES)
+add_funcy_header(util/taylor.hh HEADER_FILES)
 add_funcy_header(util/third.hh HEADER_FILES)
 add_funcy_header(util/traverse.hh HEADER_FILES)
 add_funcy_header(util/type_traits.hh HEADER_FILES)
+add_funcy_header(util/unit_directions.hh HEADER_FILES)
 add_funcy_header(util/voider.hh HEADER_FILES)
 add_funcy_header(util/zero.hh HEADER_FILES)
 
 add_texy_header(util/string.hh)
 add_stringy_header(util/string.hh)
+
+add_codey_header(codey.hh)
+add_codey_header(eigen.hh)
+add_codey_header(expression.hh)
+add_codey_header(kernel.hh)
@@ -0,0 +1,93 @@
+#include "benchmark.hh"
+
+#include <fung/cmath/exp.hh>
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/examples/rubber/neo_hooke.hh>
+#include <fung/finalize.hh>
+#include <fung/generate.hh>
+#include <fung/identity.hh>
+#include <fung/parallel_batch.hh>
+#include <fung/util/simd.hh>
+#include <fung/util/simd_eigen.hh>
+
+#include <Eigen/Dense>
+
+namespace
+{
+    using M = Eigen::Matrix< double, 3, 3 >;
+
+    FunG::Batch< M > generateBatch( std::size_t n )
+    {
+        FunG::Batch< M > x( n );
+        for ( std::size_t p = 0; p < n; ++p )
+        {
+            const auto s = 0.1 * p / n;
+            M F;
+            F << 1 + s, 0.1 * s, 0, 0.2 * s, 1, 0.1, 0, -0.1 * s, 1 - 0.1 * s;
+            x.set( p, F );
+        }
+        return x;
+    }
+
+    /// Value, gradient and hessian of the compressible neo-Hookean model at 2^14 points, using
+    /// state.range(0) threads. Reported times are per batch.
+    void parallelBatch( benchmark::State& state )
+    {
+        const auto f =
+            FunG::compressibleNeoHooke< FunG::Pow< 2 >, FunG::LN >( 1., 1., 1., M::Identity().eval() );
+        const auto x = generateBatch( 1 << 14 );
+        FunG::BatchResult< M > result;
+        for ( auto _ : state )
+        {
+            FunG::parallel_evaluate( f, x, result, state.range( 0 ) );
+            benchmark::DoNotOptimize( result.d2.component( 0 ) );
+        }
+        state.SetItemsProcessed( state.iterations() * x.size() );
+    }
+
+    /// Value, gradient and hessian of the compressible neo-Hookean model at 2^14 points, with
+    /// matrix entries of type Scalar. Reported times are per batch.
+    template < class Scalar >
+    void matrixBatch( benchmark::State& state )
+    {
+        using namespace FunG;
+        using Matrix = Eigen::Matrix< Scalar, 3, 3 >;
+        auto f = compressibleNeoHooke< Pow< 2, 1, Scalar >, CMath::LN< Scalar > >(
+            1., 1., 1., Matrix::Identity().eval() );
+        const auto x = generateBatch( 1 << 14 );
+        BatchResult< M > result;
+        for ( auto _ : state )
+        {
+            evaluate( f, x, result );
+            benchmark::DoNotOptimize( result.d2.component( 0 ) );
+        }
+        state.SetItemsProcessed( state.iterations() * x.size() );
+    }
+
+    /// Value, first and second derivative of \f$\exp(\sqrt{x})\log(x)\f$ at 2^14 points, with
+    /// arguments of type Scalar. Reported times are per batch.
+    template < class Scalar >
+    void scalarBatch( benchmark::State& state )
+    {
+        using namespace FunG;
+        auto f = finalize( CMath::Exp< Scalar >()( Pow< 1, 2, Scalar >()( identity( Scalar( 1. ) ) ) ) *
+                           CMath::LN< Scalar >()( identity( Scalar( 1. ) ) ) );
+        Batch< double > x( 1 << 14 );
+        for ( std::size_t p = 0; p < x.size(); ++p )
+            x.set( p, 1. + 0.01 * p );
+        BatchResult< double > result;
+        for ( auto _ : state )
+        {
+            evaluate( f, x, result );
+            benchmark::DoNotOptimize( result.d2.component( 0 ) );
+        }
+        state.SetItemsProcessed( state.iterations() * x.size() );
+    }
+}
+
+BENCHMARK_TEMPLATE( scalarBatch, double );
+BENCHMARK_TEMPLATE( scalarBatch, FunG::Simd< double, 4 > );
+BENCHMARK_TEMPLATE( matrixBatch, double );
+BENCHMARK_TEMPLATE( matrixBatch, FunG::Simd< double, 4 > );
+BENCHMARK( parallelBatch )->RangeMultiplier( 2 )->Range( 1, 64 )->UseRealTime();
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <fung/util/unit_directions.hh>
+
+#include <vector>
+
+/**
+ * Each benchmark iteration evaluates one point, thus the reported time is the time per point.
+ * The point of evaluation is hidden from the optimizer in each iteration.
+ * - value: update(x) and f()
+ * - gradient: value and the first directional derivatives in all unit directions
+ * - tangent: gradient and the second directional derivatives in all pairs (k,l), k<=l, of unit
+ *   directions, i.e. the upper triangle of the (symmetric) hessian
+ * - directional: value, first derivative in direction dx and second derivative in directions
+ *   (dx,dy), computed by separate calls
+ * - fused: as directional, but computed with update_and_derivatives
+ * - hessian: update(x) and packedHessian(), i.e. the upper triangle of the hessian assembled from
+ *   the second derivatives in basis directions (see FunG::LinearAlgebra::BasisDirection)
+ * - basisTangent: update(x) and d2 in all pairs (k,l), k<=l, of basis directions, called
+ *   separately, as in user code that assembles the hessian entry by entry
+ * - basisThird: update(x) and d3 in all triples (k,l,m), k<=l<=m, of basis directions
+ */
+
+/// Unit direction of a scalar argument.
+inline std::vector< double > unitDirections( double )
+{
+    return { 1. };
+}
+
+/// Unit directions \f$e_k\f$ of a fixed or dynamic size Eigen matrix, enumerated row-wise.
+template < class Matrix >
+std::vector< Matrix > unitDirections( const Matrix& A )
+{
+    std::vector< Matrix > e;
+    for ( auto i = 0; i < A.rows(); ++i )
+        for ( auto j = 0; j < A.cols(); ++j )
+        {
+            Matrix E = Matrix::Zero( A.rows(), A.cols() );
+            E( i, j ) = 1;
+            e.push_back( E );
+        }
+    return e;
+}
+
+template < class Function, class Arg >
+void value( benchmark::State& state, Function f, Arg x )
+{
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( x );
+        f.update( x );
+        benchmark::DoNotOptimize( f() );
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+template < class Function, class Arg >
+void gradient( benchmark::State& state, Function f, Arg x )
+{
+    const auto e = unitDirections( x );
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( x );
+        f.update( x );
+        benchmark::DoNotOptimize( f() );
+        for ( const auto& dx : e )
+            benchmark::DoNotOptimize( f.d1( dx ) );
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+template < class Function, class Arg >
+void tangent( benchmark::State& state, Function f, Arg x )
+{
+    const auto e = unitDirections( x );
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( x );
+        f.update( x );
+        benchmark::DoNotOptimize( f() );
+        for ( auto k = 0u; k < e.size(); ++k )
+        {
+            benchmark::DoNotOptimize( f.d1( e[ k ] ) );
+            for ( auto l = k; l < e.size(); ++l )
+                benchmark::DoNotOptimize( f.d2( e[ k ], e[ l ] ) );
+        }
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+template < class Function, class Arg >
+void directional( benchmark::State& state, Function f, Arg x )
+{
+    const auto e = unitDirections( x );
+    const auto& dx = e.front();
+    const auto& dy = e.back();
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( x );
+        f.update( x );
+        benchmark::DoNotOptimize( f() );
+        benchmark::DoNotOptimize( f.d1( dx ) );
+        benchmark::DoNotOptimize( f.d2( dx, dy ) );
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+template < class Function, class Arg >
+void fused( benchmark::State& state, Function f, Arg x )
+{
+    const auto e = unitDirections( x );
+    const auto& dx = e.front();
+    const auto& dy = e.back();
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( x );
+        benchmark::DoNotOptimize( f.update_and_derivatives( x, dx, dy ) );
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+template < class Function, class Arg >
+void hessian( benchmark::State& state, Function f, Arg x )
+{
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( x );
+        f.update( x );
+        benchmark::DoNotOptimize( f.template packedHessian< Arg >() );
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+template < class Function, class Arg >
+void basisTangent( benchmark::State& state, Function f, Arg x )
+{
+    const auto e = FunG::Detail::basisDirections< Arg >();
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( x );
+        f.update( x );
+        for ( auto k = 0u; k < e.size(); ++k )
+            for ( auto l = k; l < e.size(); ++l )
+                benchmark::DoNotOptimize( f.d2( e[ k ], e[ l ] ) );
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+template < class Function, class Arg >
+void basisThird( benchmark::State& state, Function f, Arg x )
+{
+    const auto e = FunG::Detail::basisDirections< Arg >();
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( x );
+        f.update( x );
+        for ( auto k = 0u; k < e.size(); ++k )
+            for ( auto l = k; l < e.size(); ++l )
+                for ( auto m = l; m < e.size(); ++m )
+                    benchmark::DoNotOptimize( f.d3( e[ k ], e[ l ], e[ m ] ) );
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+/// Register value, gradient and tangent benchmarks for the function and point given in __VA_ARGS__.
+#define FUNG_BENCHMARK( name, ... )                                                                \
+    BENCHMARK_CAPTURE( value, name, __VA_ARGS__ );                                                 \
+    BENCHMARK_CAPTURE( gradient, name, __VA_ARGS__ );                                              \
+    BENCHMARK_CAPTURE( tangent, name, __VA_ARGS__ )
+
+/// Register directional and fused benchmarks for the function and point given in __VA_ARGS__.
+#define FUNG_FUSED_BENCHMARK( name, ... )                                                          \
+    BENCHMARK_CAPTURE( directional, name, __VA_ARGS__ );                                           \
+    BENCHMARK_CAPTURE( fused, name, __VA_ARGS__ )
+
+/// Register hessian benchmark for the function and point given in __VA_ARGS__.
+#define FUNG_HESSIAN_BENCHMARK( name, ... ) BENCHMARK_CAPTURE( hessian, name, __VA_ARGS__ )
+
+/// Register basisTangent and basisThird benchmarks for the function and point given in
+/// __VA_ARGS__. Compare benchmarks and cached_benchmarks to see the effect of
+/// FUNG_CACHE_DERIVATIVES.
+#define FUNG_BASIS_BENCHMARK( name, ... )                                                          \
+    BENCHMARK_CAPTURE( basisTangent, name, __VA_ARGS__ );                                          \
+    BENCHMARK_CAPTURE( basisThird, name, __VA_ARGS__ )
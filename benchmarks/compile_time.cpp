@@ -0,0 +1,37 @@
+// Translation unit for measuring the compile-time cost of FunG models. It is not executed, thus
+// it is only built by the target compile_time (see CMakeLists.txt).
+
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/examples/biomechanics/adipose_tissue_sommer_holzapfel.hh>
+#include <fung/examples/biomechanics/muscle_tissue_martins.hh>
+#include <fung/examples/biomechanics/skin_tissue_hendriks.hh>
+#include <fung/examples/rubber/mooney_rivlin.hh>
+#include <fung/examples/rubber/neo_hooke.hh>
+
+#include <Eigen/Dense>
+
+namespace
+{
+    using FunG::LN;
+    using FunG::Pow;
+    using M = Eigen::Matrix< double, 3, 3 >;
+
+    // Instantiates update and all derivatives up to third order.
+    template < class F >
+    double evaluate( F f, const M& A )
+    {
+        f.update( A );
+        return f() + f.d1( A ) + f.d2( A, A ) + f.d3( A, A, A );
+    }
+}
+
+double compileTimeModels( const M& A, const M& F )
+{
+    return evaluate( FunG::compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., F ), A ) +
+           evaluate( FunG::compressibleMooneyRivlin< Pow< 2 >, LN >( 1., 1., 1., 1., F ), A ) +
+           evaluate( FunG::compressibleSkin_Hendriks< Pow< 2 >, LN >( 1., 1., F ), A ) +
+           evaluate( FunG::compressibleAdiposeTissue_SommerHolzapfel< Pow< 2 >, LN >( 1., 1., A, F ),
+                     A ) +
+           evaluate( FunG::compressibleMuscleTissue_Martins< Pow< 2 >, LN >( 1., 1., A, F ), A );
+}
@@ -0,0 +1,226 @@
+#include "benchmark.hh"
+
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/examples/biomechanics/adipose_tissue_sommer_holzapfel.hh>
+#include <fung/examples/biomechanics/muscle_tissue_martins.hh>
+#include <fung/examples/biomechanics/skin_tissue_hendriks.hh>
+#include <fung/examples/nonlinear_heat.hh>
+#include <fung/examples/rubber/mooney_rivlin.hh>
+#include <fung/examples/rubber/neo_hooke.hh>
+#include <fung/examples/yield_surface.hh>
+
+#include <Eigen/Dense>
+
+namespace
+{
+    using FunG::LN;
+    using FunG::Pow;
+    constexpr int dim = 3;
+    using M = Eigen::Matrix< double, dim, dim >;
+    using DM = Eigen::MatrixXd;
+    using V = Eigen::Matrix< double, dim, 1 >;
+    using DV = Eigen::VectorXd;
+
+    template < class Matrix >
+    Matrix deformationGradient()
+    {
+        Matrix F = Matrix::Zero( dim, dim );
+        F << 1.1, 0.1, 0, 0.2, 1, 0.1, 0, -0.1, 0.9;
+        return F;
+    }
+
+    template < class Matrix >
+    Matrix fiberTensor()
+    {
+        Matrix A = Matrix::Zero( dim, dim );
+        A( 0, 0 ) = 1;
+        return A;
+    }
+
+    template < class Matrix >
+    Matrix stressTensor()
+    {
+        Matrix sigma = Matrix::Zero( dim, dim );
+        sigma << 2, 0.5, 0, 0.5, 1, 0.2, 0, 0.2, -1;
+        return sigma;
+    }
+
+    template < class Matrix >
+    Matrix unitMatrix()
+    {
+        return Matrix::Identity( dim, dim );
+    }
+
+    /// The heat model depends on the two variables u (id 0) and du (id 1).
+    template < class Function, class Vector >
+    void heatModel( benchmark::State& state, Function f, double u, Vector du )
+    {
+        const auto e = unitDirections( du );
+        for ( auto _ : state )
+        {
+            benchmark::DoNotOptimize( u );
+            benchmark::DoNotOptimize( du );
+            f.template update< 0 >( u );
+            f.template update< 1 >( du );
+            benchmark::DoNotOptimize( f() );
+            if ( state.range( 0 ) < 1 )
+                continue;
+            benchmark::DoNotOptimize( f.template d1< 0 >( 1. ) );
+            for ( const auto& dx : e )
+                benchmark::DoNotOptimize( f.template d1< 1 >( dx ) );
+            if ( state.range( 0 ) < 2 )
+                continue;
+            benchmark::DoNotOptimize( f.template d2< 0, 0 >( 1., 1. ) );
+            for ( const auto& dx : e )
+                benchmark::DoNotOptimize( f.template d2< 0, 1 >( 1., dx ) );
+        }
+        state.SetItemsProcessed( state.iterations() );
+    }
+}
+
+// fixed size matrices
+FUNG_BENCHMARK( incompressibleNeoHooke, FunG::incompressibleNeoHooke( 1., unitMatrix< M >() ),
+                deformationGradient< M >() );
+FUNG_BENCHMARK( compressibleNeoHooke,
+                FunG::compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., unitMatrix< M >() ),
+                deformationGradient< M >() );
+FUNG_BENCHMARK( modifiedIncompressibleNeoHooke,
+                FunG::modifiedIncompressibleNeoHooke( 1., unitMatrix< M >() ),
+                deformationGradient< M >() );
+FUNG_BENCHMARK( modifiedCompressibleNeoHooke,
+                FunG::modifiedCompressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., unitMatrix< M >() ),
+                deformationGradient< M >() );
+FUNG_BENCHMARK( incompressibleMooneyRivlin,
+                FunG::incompressibleMooneyRivlin( 1., 1., unitMatrix< M >() ),
+                deformationGradient< M >() );
+FUNG_BENCHMARK( compressibleMooneyRivlin,
+                FunG::compressibleMooneyRivlin< Pow< 2 >, LN >( 1., 1., 1., 1., unitMatrix< M >() ),
+                deformationGradient< M >() );
+FUNG_BENCHMARK( incompressibleSkin_Hendriks,
+                FunG::incompressibleSkin_Hendriks( unitMatrix< M >() ),
+                deformationGradient< M >() );
+FUNG_BENCHMARK( compressibleSkin_Hendriks,
+                FunG::compressibleSkin_Hendriks< Pow< 2 >, LN >( 1., 1., unitMatrix< M >() ),
+                deformationGradient< M >() );
+FUNG_BENCHMARK( incompressibleAdiposeTissue_SommerHolzapfel,
+                FunG::incompressibleAdiposeTissue_SommerHolzapfel( fiberTensor< M >(),
+                                                                   unitMatrix< M >() ),
+                deformationGradient< M >() );
+FUNG_BENCHMARK( compressibleAdiposeTissue_SommerHolzapfel,
+                FunG::compressibleAdiposeTissue_SommerHolzapfel< Pow< 2 >, LN >(
+                    1., 1., fiberTensor< M >(), unitMatrix< M >() ),
+                deformationGradient< M >() );
+FUNG_BENCHMARK( incompressibleMuscleTissue_Martins,
+                FunG::incompressibleMuscleTissue_Martins( fiberTensor< M >(), unitMatrix< M >() ),
+                deformationGradient< M >() );
+FUNG_BENCHMARK( compressibleMuscleTissue_Martins,
+                FunG::compressibleMuscleTissue_Martins< Pow< 2 >, LN >( 1., 1., fiberTensor< M >(),
+                                                                        unitMatrix< M >() ),
+                deformationGradient< M >() );
+FUNG_BENCHMARK( yieldSurface, FunG::yieldSurface< M >( 1., 1. ), stressTensor< M >() );
+BENCHMARK_CAPTURE( heatModel, fixed, FunG::heatModel( 1., 2., 1., V( 1, 2, 3 ) ), 2.,
+                   V( 1, 2, 3 ) )
+    ->Arg( 0 )
+    ->Arg( 1 )
+    ->Arg( 2 );
+
+// dynamic size matrices
+FUNG_BENCHMARK( incompressibleNeoHooke_Dynamic,
+                FunG::incompressibleNeoHooke< DM, dim >( 1., unitMatrix< DM >() ),
+                deformationGradient< DM >() );
+FUNG_BENCHMARK( compressibleNeoHooke_Dynamic,
+                FunG::compressibleNeoHooke< Pow< 2 >, LN, DM, dim >( 1., 1., 1.,
+                                                                     unitMatrix< DM >() ),
+                deformationGradient< DM >() );
+FUNG_BENCHMARK( modifiedIncompressibleNeoHooke_Dynamic,
+                FunG::modifiedIncompressibleNeoHooke< DM, dim >( 1., unitMatrix< DM >() ),
+                deformationGradient< DM >() );
+FUNG_BENCHMARK( modifiedCompressibleNeoHooke_Dynamic,
+                FunG::modifiedCompressibleNeoHooke< Pow< 2 >, LN, DM, dim >( 1., 1., 1.,
+                                                                             unitMatrix< DM >() ),
+                deformationGradient< DM >() );
+FUNG_BENCHMARK( incompressibleMooneyRivlin_Dynamic,
+                FunG::incompressibleMooneyRivlin< DM, dim >( 1., 1., unitMatrix< DM >() ),
+                deformationGradient< DM >() );
+FUNG_BENCHMARK( compressibleMooneyRivlin_Dynamic,
+                FunG::compressibleMooneyRivlin< Pow< 2 >, LN, DM, dim >( 1., 1., 1., 1.,
+                                                                         unitMatrix< DM >() ),
+                deformationGradient< DM >() );
+FUNG_BENCHMARK( incompressibleSkin_Hendriks_Dynamic,
+                FunG::incompressibleSkin_Hendriks< DM, dim >( unitMatrix< DM >() ),
+                deformationGradient< DM >() );
+FUNG_BENCHMARK( compressibleSkin_Hendriks_Dynamic,
+                FunG::compressibleSkin_Hendriks< Pow< 2 >, LN, DM, dim >( 1., 1.,
+                                                                          unitMatrix< DM >() ),
+                deformationGradient< DM >() );
+FUNG_BENCHMARK( incompressibleAdiposeTissue_SommerHolzapfel_Dynamic,
+                FunG::incompressibleAdiposeTissue_SommerHolzapfel< DM, dim >( fiberTensor< DM >(),
+                                                                              unitMatrix< DM >() ),
+                deformationGradient< DM >() );
+FUNG_BENCHMARK( compressibleAdiposeTissue_SommerHolzapfel_Dynamic,
+                FunG::compressibleAdiposeTissue_SommerHolzapfel< Pow< 2 >, LN, DM, dim >(
+                    1., 1., fiberTensor< DM >(), unitMatrix< DM >() ),
+                deformationGradient< DM >() );
+FUNG_BENCHMARK( incompressibleMuscleTissue_Martins_Dynamic,
+                FunG::incompressibleMuscleTissue_Martins< DM, dim >( fiberTensor< DM >(),
+                                                                     unitMatrix< DM >() ),
+                deformationGradient< DM >() );
+FUNG_BENCHMARK( compressibleMuscleTissue_Martins_Dynamic,
+                FunG::compressibleMuscleTissue_Martins< Pow< 2 >, LN, DM, dim >(
+                    1., 1., fiberTensor< DM >(), unitMatrix< DM >() ),
+                deformationGradient< DM >() );
+FUNG_BENCHMARK( yieldSurface_Dynamic,
+                FunG::yieldSurface< DM, dim >( 1., 1., stressTensor< DM >() ),
+                stressTensor< DM >() );
+BENCHMARK_CAPTURE( heatModel, dynamic, FunG::heatModel( 1., 2., 1., DV( V( 1, 2, 3 ) ) ), 2.,
+                   DV( V( 1, 2, 3 ) ) )
+    ->Arg( 0 )
+    ->Arg( 1 )
+    ->Arg( 2 );
+
+// value, first and second derivative in one pair of directions
+FUNG_FUSED_BENCHMARK( compressibleNeoHooke,
+                      FunG::compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., unitMatrix< M >() ),
+                      deformationGradient< M >() );
+FUNG_FUSED_BENCHMARK( compressibleMooneyRivlin,
+                      FunG::compressibleMooneyRivlin< Pow< 2 >, LN >( 1., 1., 1., 1.,
+                                                                      unitMatrix< M >() ),
+                      deformationGradient< M >() );
+FUNG_FUSED_BENCHMARK( compressibleAdiposeTissue_SommerHolzapfel,
+                      FunG::compressibleAdiposeTissue_SommerHolzapfel< Pow< 2 >, LN >(
+                          1., 1., fiberTensor< M >(), unitMatrix< M >() ),
+                      deformationGradient< M >() );
+FUNG_FUSED_BENCHMARK( compressibleMuscleTissue_Martins,
+                      FunG::compressibleMuscleTissue_Martins< Pow< 2 >, LN >(
+                          1., 1., fiberTensor< M >(), unitMatrix< M >() ),
+                      deformationGradient< M >() );
+
+// upper triangle of the hessian, assembled from basis directions
+FUNG_HESSIAN_BENCHMARK( compressibleNeoHooke,
+                        FunG::compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., unitMatrix< M >() ),
+                        deformationGradient< M >() );
+FUNG_HESSIAN_BENCHMARK( modifiedCompressibleNeoHooke,
+                        FunG::modifiedCompressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1.,
+                                                                            unitMatrix< M >() ),
+                        deformationGradient< M >() );
+FUNG_HESSIAN_BENCHMARK( compressibleMooneyRivlin,
+                        FunG::compressibleMooneyRivlin< Pow< 2 >, LN >( 1., 1., 1., 1.,
+                                                                        unitMatrix< M >() ),
+                        deformationGradient< M >() );
+FUNG_HESSIAN_BENCHMARK( compressibleMuscleTissue_Martins,
+                        FunG::compressibleMuscleTissue_Martins< Pow< 2 >, LN >(
+                            1., 1., fiberTensor< M >(), unitMatrix< M >() ),
+                        deformationGradient< M >() );
+
+// second and third derivatives in basis directions, called separately
+FUNG_BASIS_BENCHMARK( compressibleNeoHooke,
+                      FunG::compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., unitMatrix< M >() ),
+                      deformationGradient< M >() );
+FUNG_BASIS_BENCHMARK( compressibleSkin_Hendriks,
+                      FunG::compressibleSkin_Hendriks< Pow< 2 >, LN >( 1., 1., unitMatrix< M >() ),
+                      deformationGradient< M >() );
+FUNG_BASIS_BENCHMARK( compressibleMuscleTissue_Martins,
+                      FunG::compressibleMuscleTissue_Martins< Pow< 2 >, LN >(
+                          1., 1., fiberTensor< M >(), unitMatrix< M >() ),
+                      deformationGradient< M >() );
@@ -0,0 +1,95 @@
+#include "benchmark.hh"
+
+#include <fung/cmath/exp.hh>
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/cmath/sine.hh>
+#include <fung/finalize.hh>
+#include <fung/generate.hh>
+#include <fung/linear_algebra/determinant.hh>
+#include <fung/linear_algebra/principal_invariants.hh>
+#include <fung/linear_algebra/strain_tensor.hh>
+
+#include <Eigen/Dense>
+
+namespace
+{
+    using M2 = Eigen::Matrix< double, 2, 2 >;
+    using M = Eigen::Matrix< double, 3, 3 >;
+    using M4 = Eigen::Matrix< double, 4, 4 >;
+    using M6 = Eigen::Matrix< double, 6, 6 >;
+    using DM = Eigen::MatrixXd;
+
+    template < class Matrix >
+    Matrix deformationGradient( int dim )
+    {
+        Matrix F = Matrix::Identity( dim, dim );
+        F( 0, 0 ) = 1.1;
+        F( 0, 1 ) = 0.1;
+        F( 1, 0 ) = 0.2;
+        F( dim - 1, dim - 1 ) = 0.9;
+        return F;
+    }
+
+    auto chainOfScalarFunctions()
+    {
+        using namespace FunG;
+        return finalize( sin( exp( Pow< 2 >() ) ) );
+    }
+
+    template < class Matrix >
+    auto chainOfMatrixFunctions( const Matrix& F )
+    {
+        using namespace FunG;
+        using namespace FunG::LinearAlgebra;
+        return finalize( ln( i1( strainTensor( F ) ) ) );
+    }
+
+    auto productOfScalarFunctions()
+    {
+        using namespace FunG;
+        return finalize( Sin() * Exp() );
+    }
+
+    template < class Matrix >
+    auto productOfMatrixFunctions( const Matrix& F )
+    {
+        using namespace FunG;
+        using namespace FunG::LinearAlgebra;
+        return finalize( i1( strainTensor( F ) ) * det( F ) );
+    }
+}
+
+// Chain
+FUNG_BENCHMARK( Chain_Scalar, chainOfScalarFunctions(), 0.5 );
+FUNG_BENCHMARK( Chain_Matrix, chainOfMatrixFunctions( deformationGradient< M >( 3 ) ),
+                deformationGradient< M >( 3 ) );
+FUNG_BENCHMARK( Chain_Matrix_Dynamic, chainOfMatrixFunctions( deformationGradient< DM >( 3 ) ),
+                deformationGradient< DM >( 3 ) );
+
+// Product
+FUNG_BENCHMARK( Product_Scalar, productOfScalarFunctions(), 0.5 );
+FUNG_BENCHMARK( Product_Matrix, productOfMatrixFunctions( deformationGradient< M >( 3 ) ),
+                deformationGradient< M >( 3 ) );
+
+// Determinant
+FUNG_BENCHMARK( Determinant_2x2, FunG::LinearAlgebra::det( deformationGradient< M2 >( 2 ) ),
+                deformationGradient< M2 >( 2 ) );
+FUNG_BENCHMARK( Determinant_3x3, FunG::LinearAlgebra::det( deformationGradient< M >( 3 ) ),
+                deformationGradient< M >( 3 ) );
+FUNG_BENCHMARK( Determinant_4x4, FunG::LinearAlgebra::det( deformationGradient< M4 >( 4 ) ),
+                deformationGradient< M4 >( 4 ) );
+FUNG_BENCHMARK( Determinant_6x6, FunG::LinearAlgebra::det( deformationGradient< M6 >( 6 ) ),
+                deformationGradient< M6 >( 6 ) );
+FUNG_BENCHMARK( Determinant_2x2_Dynamic, FunG::LinearAlgebra::det( deformationGradient< DM >( 2 ) ),
+                deformationGradient< DM >( 2 ) );
+FUNG_BENCHMARK( Determinant_3x3_Dynamic, FunG::LinearAlgebra::det( deformationGradient< DM >( 3 ) ),
+                deformationGradient< DM >( 3 ) );
+
+// Pow
+FUNG_BENCHMARK( Pow_2, FunG::Pow< 2 >(), 0.5 );
+FUNG_BENCHMARK( Pow_3, FunG::Pow< 3 >(), 0.5 );
+FUNG_BENCHMARK( Pow_Sqrt, FunG::Sqrt(), 0.5 );
+FUNG_BENCHMARK( Pow_Cbrt, FunG::Cbrt(), 0.5 );
+FUNG_BENCHMARK( Pow_Minus1_3, ( FunG::Pow< -1, 3 >() ), 0.5 );
+FUNG_BENCHMARK( Pow_Minus2_3, ( FunG::Pow< -2, 3 >() ), 0.5 );
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <codey/expression.hh>
+#include <codey/kernel.hh>
+#include <fung/fung.hh>
+
+/**
+ * @brief Generation of straight-line C code for the value, gradient and hessian of FunG functions.
+ *
+ * Functions are evaluated with the symbolic scalar type codey::Expression. The resulting
+ * expression graphs are translated to C code by codey::kernel(). For matrix arguments include
+ * codey/eigen.hh and use Eigen matrices of codey::Expression.
+ */
+namespace codey
+{
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <codey/expression.hh>
+
+#include <Eigen/Core>
+
+namespace Eigen
+{
+    /// Use codey::Expression as scalar type of Eigen matrices.
+    template <>
+    struct NumTraits< codey::Expression > : GenericNumTraits< double >
+    {
+        using Real = codey::Expression;
+        using NonInteger = codey::Expression;
+        using Nested = codey::Expression;
+        using Literal = codey::Expression;
+
+        enum
+        {
+            IsComplex = 0,
+            IsInteger = 0,
+            IsSigned = 1,
+            RequireInitialization = 1,
+            ReadCost = 1,
+            AddCost = 1,
+            MulCost = 1
+        };
+    };
+
+    /// @cond
+    template < class BinaryOp >
+    struct ScalarBinaryOpTraits< codey::Expression, double, BinaryOp >
+    {
+        using ReturnType = codey::Expression;
+    };
+
+    template < class BinaryOp >
+    struct ScalarBinaryOpTraits< double, codey::Expression, BinaryOp >
+    {
+        using ReturnType = codey::Expression;
+    };
+    /// @endcond
+}
@@ -0,0 +1,534 @@
+#pragma once
+
+#include <fung/util/type_traits.hh>
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace codey
+{
+    /// Operations of the nodes of an Expression.
+    enum class Operation
+    {
+        Constant,
+        Input,
+        Negate,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Pow,
+        Exp,
+        Exp2,
+        Log,
+        Log2,
+        Log10,
+        Sqrt,
+        Cbrt,
+        Sin,
+        Cos,
+        Tan,
+        Asin,
+        Acos,
+        Erf,
+        Abs
+    };
+
+    /// @cond
+    namespace Detail
+    {
+        struct Node
+        {
+            Operation operation = Operation::Constant;
+            double value = 0;
+            int index = -1;
+            std::string name;
+            std::shared_ptr< const Node > lhs, rhs;
+        };
+
+        /// Name of the function in \<math.h\> that implements a unary operation.
+        inline const char* functionName( Operation operation )
+        {
+            switch ( operation )
+            {
+            case Operation::Exp:
+                return "exp";
+            case Operation::Exp2:
+                return "exp2";
+            case Operation::Log:
+                return "log";
+            case Operation::Log2:
+                return "log2";
+            case Operation::Log10:
+                return "log10";
+            case Operation::Sqrt:
+                return "sqrt";
+            case Operation::Cbrt:
+                return "cbrt";
+            case Operation::Sin:
+                return "sin";
+            case Operation::Cos:
+                return "cos";
+            case Operation::Tan:
+                return "tan";
+            case Operation::Asin:
+                return "asin";
+            case Operation::Acos:
+                return "acos";
+            case Operation::Erf:
+                return "erf";
+            case Operation::Abs:
+                return "fabs";
+            case Operation::Pow:
+                return "pow";
+            default:
+                return "";
+            }
+        }
+
+        inline double apply( Operation operation, double x, double y = 0 )
+        {
+            switch ( operation )
+            {
+            case Operation::Negate:
+                return -x;
+            case Operation::Add:
+                return x + y;
+            case Operation::Subtract:
+                return x - y;
+            case Operation::Multiply:
+                return x * y;
+            case Operation::Divide:
+                return x / y;
+            case Operation::Pow:
+                return std::pow( x, y );
+            case Operation::Exp:
+                return std::exp( x );
+            case Operation::Exp2:
+                return std::exp2( x );
+            case Operation::Log:
+                return std::log( x );
+            case Operation::Log2:
+                return std::log2( x );
+            case Operation::Log10:
+                return std::log10( x );
+            case Operation::Sqrt:
+                return std::sqrt( x );
+            case Operation::Cbrt:
+                return std::cbrt( x );
+            case Operation::Sin:
+                return std::sin( x );
+            case Operation::Cos:
+                return std::cos( x );
+            case Operation::Tan:
+                return std::tan( x );
+            case Operation::Asin:
+                return std::asin( x );
+            case Operation::Acos:
+                return std::acos( x );
+            case Operation::Erf:
+                return std::erf( x );
+            case Operation::Abs:
+                return std::abs( x );
+            default:
+                return x;
+            }
+        }
+
+        /// Double literal that is exactly representable and always contains a decimal point or
+        /// an exponent. Non-finite values are expressed by the macros INFINITY and NAN of
+        /// \<math.h\>.
+        inline std::string literal( double value )
+        {
+            if ( std::isnan( value ) )
+                return "NAN";
+            if ( std::isinf( value ) )
+                return value < 0 ? "-INFINITY" : "INFINITY";
+
+            char buffer[ 32 ];
+            std::snprintf( buffer, sizeof( buffer ), "%.17g", value );
+            std::string result( buffer );
+            if ( result.find_first_of( ".e" ) == std::string::npos )
+                result.append( ".0" );
+            return result;
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Symbolic scalar for the generation of source code from functions of the FunG library.
+     *
+     * An Expression records the operations that are applied to it as a directed acyclic graph,
+     * i.e. each value that is stored in a function is a node that may be shared by several
+     * derivatives. Operations on constants are evaluated directly and multiplications with zero
+     * and one, additions of zero and differences of identical nodes are removed. Thus, unit
+     * directions (see kernel.hh) yield compact expressions for the partial derivatives.
+     *
+     * Expression is registered as arithmetic type (see FunG::is_arithmetic), thus it can be used
+     * as argument of all functions of the CMathGroup and as entry of matrices (see eigen.hh).
+     *
+     * Comparisons are only evaluated for constants, and an expression is equal to itself. All
+     * other comparisons throw std::logic_error, since their result would depend on the values of
+     * the inputs. Functions whose value depends on the result of a comparison, such as Min and
+     * Max, are thus not supported.
+     */
+    class Expression
+    {
+    public:
+        /// Constant expression.
+        Expression( double value = 0 )
+        {
+            auto node = std::make_shared< Detail::Node >();
+            node->value = value;
+            node_ = std::move( node );
+        }
+
+        /// Input x[index] of the generated code.
+        static Expression input( int index, std::string name )
+        {
+            auto node = std::make_shared< Detail::Node >();
+            node->operation = Operation::Input;
+            node->index = index;
+            node->name = std::move( name );
+            return Expression( std::move( node ) );
+        }
+
+        /// Result of a unary operation.
+        static Expression apply( Operation operation, const Expression& x )
+        {
+            if ( x.isConstant() )
+                return Detail::apply( operation, x.value() );
+            return Expression( operation, x.node_, nullptr );
+        }
+
+        bool isConstant() const noexcept
+        {
+            return node_->operation == Operation::Constant;
+        }
+
+        bool isConstant( double value ) const noexcept
+        {
+            return isConstant() && node_->value == value;
+        }
+
+        /// Value of a constant expression.
+        double value() const noexcept
+        {
+            return node_->value;
+        }
+
+        /// Root of the graph of this expression.
+        const Detail::Node& node() const noexcept
+        {
+            return *node_;
+        }
+
+        Expression& operator+=( const Expression& y )
+        {
+            return *this = *this + y;
+        }
+
+        Expression& operator-=( const Expression& y )
+        {
+            return *this = *this - y;
+        }
+
+        Expression& operator*=( const Expression& y )
+        {
+            return *this = *this * y;
+        }
+
+        Expression& operator/=( const Expression& y )
+        {
+            return *this = *this / y;
+        }
+
+        friend Expression operator-( const Expression& x )
+        {
+            if ( x.node_->operation == Operation::Negate )
+                return Expression( x.node_->lhs );
+            return apply( Operation::Negate, x );
+        }
+
+        friend Expression operator+( const Expression& x, const Expression& y )
+        {
+            if ( x.isConstant( 0 ) )
+                return y;
+            if ( y.isConstant( 0 ) )
+                return x;
+            if ( y.node_->operation == Operation::Negate )
+                return x - Expression( y.node_->lhs );
+            if ( x.node_->operation == Operation::Negate )
+                return y - Expression( x.node_->lhs );
+            return binary( Operation::Add, x, y );
+        }
+
+        friend Expression operator-( const Expression& x, const Expression& y )
+        {
+            if ( y.isConstant( 0 ) )
+                return x;
+            if ( x.isConstant( 0 ) )
+                return -y;
+            if ( x.node_ == y.node_ )
+                return Expression( 0. );
+            if ( y.node_->operation == Operation::Negate )
+                return x + Expression( y.node_->lhs );
+            return binary( Operation::Subtract, x, y );
+        }
+
+        friend Expression operator*( const Expression& x, const Expression& y )
+        {
+            if ( x.isConstant( 0 ) || y.isConstant( 0 ) )
+                return Expression( 0. );
+            if ( x.isConstant( 1 ) )
+                return y;
+            if ( y.isConstant( 1 ) )
+                return x;
+            if ( x.isConstant( -1 ) )
+                return -y;
+            if ( y.isConstant( -1 ) )
+                return -x;
+            if ( x.node_->operation == Operation::Negate )
+                return -( Expression( x.node_->lhs ) * y );
+            if ( y.node_->operation == Operation::Negate )
+                return -( x * Expression( y.node_->lhs ) );
+            return binary( Operation::Multiply, x, y );
+        }
+
+        friend Expression operator/( const Expression& x, const Expression& y )
+        {
+            if ( x.isConstant( 0 ) )
+                return Expression( 0. );
+            if ( y.isConstant( 1 ) )
+                return x;
+            return binary( Operation::Divide, x, y );
+        }
+
+        friend bool operator<( const Expression& x, const Expression& y )
+        {
+            return constantValue( x ) < constantValue( y );
+        }
+
+        friend bool operator<=( const Expression& x, const Expression& y )
+        {
+            return constantValue( x ) <= constantValue( y );
+        }
+
+        friend bool operator>( const Expression& x, const Expression& y )
+        {
+            return constantValue( x ) > constantValue( y );
+        }
+
+        friend bool operator>=( const Expression& x, const Expression& y )
+        {
+            return constantValue( x ) >= constantValue( y );
+        }
+
+        friend bool operator==( const Expression& x, const Expression& y )
+        {
+            return x.node_ == y.node_ || constantValue( x ) == constantValue( y );
+        }
+
+        friend bool operator!=( const Expression& x, const Expression& y )
+        {
+            return !( x == y );
+        }
+
+        friend Expression pow( const Expression& x, const Expression& y )
+        {
+            if ( y.isConstant( 0 ) )
+                return Expression( 1. );
+            if ( y.isConstant( 1 ) )
+                return x;
+            return binary( Operation::Pow, x, y );
+        }
+
+        friend Expression exp( const Expression& x )
+        {
+            return apply( Operation::Exp, x );
+        }
+
+        friend Expression exp2( const Expression& x )
+        {
+            return apply( Operation::Exp2, x );
+        }
+
+        friend Expression log( const Expression& x )
+        {
+            return apply( Operation::Log, x );
+        }
+
+        friend Expression log2( const Expression& x )
+        {
+            return apply( Operation::Log2, x );
+        }
+
+        friend Expression log10( const Expression& x )
+        {
+            return apply( Operation::Log10, x );
+        }
+
+        friend Expression sqrt( const Expression& x )
+        {
+            return apply( Operation::Sqrt, x );
+        }
+
+        friend Expression cbrt( const Expression& x )
+        {
+            return apply( Operation::Cbrt, x );
+        }
+
+        friend Expression sin( const Expression& x )
+        {
+            return apply( Operation::Sin, x );
+        }
+
+        friend Expression cos( const Expression& x )
+        {
+            return apply( Operation::Cos, x );
+        }
+
+        friend Expression tan( const Expression& x )
+        {
+            return apply( Operation::Tan, x );
+        }
+
+        friend Expression asin( const Expression& x )
+        {
+            return apply( Operation::Asin, x );
+        }
+
+        friend Expression acos( const Expression& x )
+        {
+            return apply( Operation::Acos, x );
+        }
+
+        friend Expression erf( const Expression& x )
+        {
+            return apply( Operation::Erf, x );
+        }
+
+        friend Expression abs( const Expression& x )
+        {
+            return apply( Operation::Abs, x );
+        }
+
+        /// Fully parenthesized expression, i.e. without common subexpression elimination.
+        friend std::string to_string( const Expression& x )
+        {
+            const auto& node = x.node();
+            switch ( node.operation )
+            {
+            case Operation::Constant:
+                return Detail::literal( node.value );
+            case Operation::Input:
+                return node.name;
+            case Operation::Negate:
+                return "(-" + to_string( Expression( node.lhs ) ) + ")";
+            case Operation::Add:
+                return "(" + to_string( Expression( node.lhs ) ) + " + " +
+                       to_string( Expression( node.rhs ) ) + ")";
+            case Operation::Subtract:
+                return "(" + to_string( Expression( node.lhs ) ) + " - " +
+                       to_string( Expression( node.rhs ) ) + ")";
+            case Operation::Multiply:
+                return "(" + to_string( Expression( node.lhs ) ) + " * " +
+                       to_string( Expression( node.rhs ) ) + ")";
+            case Operation::Divide:
+                return "(" + to_string( Expression( node.lhs ) ) + " / " +
+                       to_string( Expression( node.rhs ) ) + ")";
+            case Operation::Pow:
+                return "pow(" + to_string( Expression( node.lhs ) ) + ", " +
+                       to_string( Expression( node.rhs ) ) + ")";
+            default:
+                return std::string( Detail::functionName( node.operation ) ) + "(" +
+                       to_string( Expression( node.lhs ) ) + ")";
+            }
+        }
+
+        friend std::ostream& operator<<( std::ostream& os, const Expression& x )
+        {
+            return os << to_string( x );
+        }
+
+    private:
+        explicit Expression( std::shared_ptr< const Detail::Node > node )
+            : node_( std::move( node ) )
+        {
+        }
+
+        Expression( Operation operation, std::shared_ptr< const Detail::Node > lhs,
+                    std::shared_ptr< const Detail::Node > rhs )
+        {
+            auto node = std::make_shared< Detail::Node >();
+            node->operation = operation;
+            node->lhs = std::move( lhs );
+            node->rhs = std::move( rhs );
+            node_ = std::move( node );
+        }
+
+        /// Value of x, used in comparisons. Throws std::logic_error if x is not constant.
+        static double constantValue( const Expression& x )
+        {
+            if ( !x.isConstant() )
+                throw std::logic_error( "Comparison of non-constant expression " + to_string( x ) +
+                                        " can not be evaluated during code generation." );
+            return x.value();
+        }
+
+        static Expression binary( Operation operation, const Expression& x, const Expression& y )
+        {
+            if ( x.isConstant() && y.isConstant() )
+                return Detail::apply( operation, x.value(), y.value() );
+            return Expression( operation, x.node_, y.node_ );
+        }
+
+        std::shared_ptr< const Detail::Node > node_;
+    };
+
+    /**
+     * @brief Evaluate an expression.
+     * @param f expression
+     * @param x values of the inputs, i.e. Expression::input( k, ... ) evaluates to x[k]
+     */
+    inline double evaluate( const Expression& f, const double* x )
+    {
+        std::unordered_map< const Detail::Node*, double > values;
+        struct Evaluator
+        {
+            double operator()( const Detail::Node& node )
+            {
+                auto iter = values.find( &node );
+                if ( iter != values.end() )
+                    return iter->second;
+
+                double result = node.value;
+                if ( node.operation == Operation::Input )
+                    result = x[ node.index ];
+                else if ( node.operation != Operation::Constant )
+                    result = Detail::apply( node.operation, ( *this )( *node.lhs ),
+                                            node.rhs ? ( *this )( *node.rhs ) : 0. );
+                return values[ &node ] = result;
+            }
+
+            std::unordered_map< const Detail::Node*, double >& values;
+            const double* x;
+        };
+        return Evaluator{values, x}( f.node() );
+    }
+}
+
+namespace FunG
+{
+    /// Register codey::Expression as arithmetic type.
+    template <>
+    struct is_arithmetic< codey::Expression > : std::true_type
+    {
+    };
+}
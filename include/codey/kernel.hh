@@ -0,0 +1,279 @@
+#pragma once
+
+#include <codey/expression.hh>
+#include <fung/util/unit_directions.hh>
+#include <fung/util/zero.hh>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace codey
+{
+    /// @cond
+    namespace Detail
+    {
+        /**
+         * @brief Emits straight-line code for a set of assignments.
+         *
+         * Structurally identical subexpressions are merged, where the operands of additions and
+         * multiplications are ordered. Subexpressions that are used more than once are stored in
+         * temporaries, all others are inlined.
+         */
+        class CodeGenerator
+        {
+            struct Entry
+            {
+                Operation operation;
+                double value;
+                int index;
+                std::string name;
+                int lhs, rhs;
+                int uses;
+                std::string temporary;
+            };
+
+        public:
+            /// Add assignment "target = f;".
+            void assign( std::string target, const Expression& f )
+            {
+                // Nodes are identified by their address, thus f must not be destroyed.
+                roots.push_back( f );
+                const auto id = canonicalize( f.node() );
+                ++entries[ id ].uses;
+                assignments.emplace_back( std::move( target ), id );
+            }
+
+            /// Add statement that is emitted after all assignments.
+            void append( std::string statement )
+            {
+                statements.push_back( std::move( statement ) );
+            }
+
+            /// Function body, indented by four spaces.
+            std::string body()
+            {
+                std::string code;
+                for ( const auto& assignment : assignments )
+                {
+                    auto expression = emit( assignment.second, code );
+                    code.append( "    " )
+                        .append( assignment.first )
+                        .append( " = " )
+                        .append( expression )
+                        .append( ";\n" );
+                }
+                for ( const auto& statement : statements )
+                    code.append( "    " ).append( statement ).append( "\n" );
+                return code;
+            }
+
+            /// Number of temporaries, i.e. of common subexpressions.
+            int numberOfTemporaries() const noexcept
+            {
+                return temporaries;
+            }
+
+        private:
+            int canonicalize( const Node& node )
+            {
+                const auto iter = ids.find( &node );
+                if ( iter != ids.end() )
+                    return iter->second;
+
+                auto lhs = node.lhs ? canonicalize( *node.lhs ) : -1;
+                auto rhs = node.rhs ? canonicalize( *node.rhs ) : -1;
+                if ( ( node.operation == Operation::Add ||
+                       node.operation == Operation::Multiply ) &&
+                     rhs < lhs )
+                    std::swap( lhs, rhs );
+
+                std::string key = std::to_string( static_cast< int >( node.operation ) );
+                if ( node.operation == Operation::Constant )
+                    key.append( ":" ).append( literal( node.value ) );
+                else if ( node.operation == Operation::Input )
+                    key.append( ":" ).append( node.name );
+                else
+                    key.append( ":" )
+                        .append( std::to_string( lhs ) )
+                        .append( ":" )
+                        .append( std::to_string( rhs ) );
+
+                const auto existing = keys.find( key );
+                if ( existing != keys.end() )
+                    return ids[ &node ] = existing->second;
+
+                if ( lhs >= 0 )
+                    ++entries[ lhs ].uses;
+                if ( rhs >= 0 )
+                    ++entries[ rhs ].uses;
+                const auto id = static_cast< int >( entries.size() );
+                entries.push_back(
+                    {node.operation, node.value, node.index, node.name, lhs, rhs, 0, ""} );
+                keys[ key ] = id;
+                return ids[ &node ] = id;
+            }
+
+            static bool isLeaf( const Entry& entry )
+            {
+                return entry.operation == Operation::Constant ||
+                       entry.operation == Operation::Input;
+            }
+
+            /// Expression for entry id, as operand of another operation.
+            std::string operand( int id, std::string& code )
+            {
+                auto expression = emit( id, code );
+                const auto& entry = entries[ id ];
+                const auto isCall = !isLeaf( entry ) && functionName( entry.operation )[ 0 ] != 0;
+                if ( !entry.temporary.empty() || isCall ||
+                     ( isLeaf( entry ) && !( entry.operation == Operation::Constant &&
+                                             entry.value < 0 ) ) )
+                    return expression;
+                return "(" + expression + ")";
+            }
+
+            /// Expression for entry id. Temporaries required by it are appended to code.
+            std::string emit( int id, std::string& code )
+            {
+                auto& entry = entries[ id ];
+                if ( !entry.temporary.empty() )
+                    return entry.temporary;
+
+                std::string expression;
+                switch ( entry.operation )
+                {
+                case Operation::Constant:
+                    return literal( entry.value );
+                case Operation::Input:
+                    return entry.name;
+                case Operation::Negate:
+                    expression = "-" + operand( entry.lhs, code );
+                    break;
+                case Operation::Add:
+                    expression = operand( entry.lhs, code ) + " + " + operand( entry.rhs, code );
+                    break;
+                case Operation::Subtract:
+                    expression = operand( entry.lhs, code ) + " - " + operand( entry.rhs, code );
+                    break;
+                case Operation::Multiply:
+                    expression = operand( entry.lhs, code ) + " * " + operand( entry.rhs, code );
+                    break;
+                case Operation::Divide:
+                    expression = operand( entry.lhs, code ) + " / " + operand( entry.rhs, code );
+                    break;
+                case Operation::Pow:
+                    expression =
+                        "pow(" + emit( entry.lhs, code ) + ", " + emit( entry.rhs, code ) + ")";
+                    break;
+                default:
+                    expression = std::string( functionName( entry.operation ) ) + "(" +
+                                 emit( entry.lhs, code ) + ")";
+                }
+
+                if ( entries[ id ].uses < 2 )
+                    return expression;
+
+                auto& temporary = entries[ id ].temporary;
+                temporary = "t" + std::to_string( temporaries++ );
+                code.append( "    const double " )
+                    .append( temporary )
+                    .append( " = " )
+                    .append( expression )
+                    .append( ";\n" );
+                return temporary;
+            }
+
+            std::vector< Expression > roots;
+            std::vector< Entry > entries;
+            std::unordered_map< const Node*, int > ids;
+            std::unordered_map< std::string, int > keys;
+            std::vector< std::pair< std::string, int > > assignments;
+            std::vector< std::string > statements;
+            int temporaries = 0;
+        };
+    }
+    /// @endcond
+
+    /**
+     * @brief Inputs of the generated code.
+     *
+     * The inputs are the components of the parameter x of the generated function (see kernel()).
+     * For Arg=Expression this is x[0], for constant size matrices the entries are enumerated
+     * row-wise, i.e. the \f$(i,j)\f$-th entry of a \f$m\times n\f$ matrix is x[i*n+j].
+     */
+    template < class Arg >
+    Arg input()
+    {
+        using Components = FunG::Detail::Components< Arg >;
+        auto x = FunG::zero< Arg >();
+        for ( int k = 0; k < Components::value; ++k )
+            Components::entry( x, k ) =
+                Expression::input( k, "x[" + std::to_string( k ) + "]" );
+        return x;
+    }
+
+    /**
+     * @brief Generate C source code for the value and the derivatives of f.
+     *
+     * The generated function is valid C99 and C++, requires \<math.h\> and has the signature
+     * @code
+     * static inline void name( const double* x, double* f, double* df, double* ddf );
+     * @endcode
+     * where df and ddf are only present for order>0 resp. order>1. The input x holds the
+     * components of the argument, enumerated as in input(). The outputs are the value f[0], the
+     * gradient df[k] and the (symmetric) hessian ddf[k*n+l], where n is the number of components.
+     * The function body is straight-line code without branches, in which common subexpressions of
+     * the value and all derivatives are computed only once.
+     *
+     * Example:
+     * @code
+     * using M = Eigen::Matrix< codey::Expression, 3, 3 >;
+     * const auto f = FunG::incompressibleNeoHooke( 1., M::Identity().eval() );
+     * std::cout << codey::kernel( "neoHooke", f, codey::input< M >() );
+     * @endcode
+     *
+     * @param name name of the generated function
+     * @param f function with scalar type codey::Expression, i.e. the return type of
+     * finalize( ... ). Constants that are computed from the initial argument of f, such as the
+     * offset in volumetricPenalty(), require that f is constructed with a constant argument.
+     * @param x argument of f, generated with input< Arg >()
+     * @tparam order highest order of generated derivatives (0,1 or 2)
+     */
+    template < int order = 2, class F, class Arg >
+    std::string kernel( const std::string& name, F f, const Arg& x )
+    {
+        static_assert( order >= 0 && order <= 2, "kernel: Only orders 0, 1 and 2 are supported." );
+        using Components = FunG::Detail::Components< Arg >;
+        constexpr auto n = Components::value;
+
+        f.update( x );
+        Detail::CodeGenerator generator;
+        generator.assign( "f[0]", f() );
+
+        const auto e = FunG::Detail::unitDirections< Arg >();
+        if ( order > 0 )
+            for ( int k = 0; k < n; ++k )
+                generator.assign( "df[" + std::to_string( k ) + "]", f.d1( e[ k ] ) );
+
+        if ( order > 1 )
+            for ( int k = 0; k < n; ++k )
+                for ( int l = k; l < n; ++l )
+                {
+                    const auto kl = "ddf[" + std::to_string( k * n + l ) + "]";
+                    generator.assign( kl, f.d2( e[ k ], e[ l ] ) );
+                    if ( l != k )
+                        generator.append( "ddf[" + std::to_string( l * n + k ) + "] = " + kl +
+                                          ";" );
+                }
+
+        std::string code = "static inline void " + name + "( const double* x, double* f";
+        if ( order > 0 )
+            code.append( ", double* df" );
+        if ( order > 1 )
+            code.append( ", double* ddf" );
+        return code.append( " )\n{\n" ).append( generator.body() ).append( "}\n" );
+    }
+}
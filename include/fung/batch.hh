@@ -0,0 +1,377 @@
+#pragma once
+
+#include <fung/finalize.hh>
+#include <fung/util/simd.hh>
+#include <fung/util/static_checks.hh>
+#include <fung/util/unit_directions.hh>
+#include <fung/util/zero.hh>
+#include <fung/variable.hh>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace FunG
+{
+    /// @cond
+    namespace BatchDetail
+    {
+        /// Number of points that are gathered from structure-of-arrays storage at once.
+        constexpr std::size_t blockSize = 64;
+    }
+    /// @endcond
+
+    /**
+     * @brief Structure-of-arrays storage for a batch of objects with a fixed number of scalar
+     * components.
+     *
+     * The k-th component of all objects is stored contiguously, i.e. component(k)[p] is the k-th
+     * component of the p-th object.
+     */
+    template < class Scalar >
+    class BatchStorage
+    {
+    public:
+        /**
+         * @brief Constructor.
+         * @param size number of objects
+         * @param components number of scalar components per object
+         */
+        explicit BatchStorage( std::size_t size = 0, int components = 1 )
+            : n( size ), m( components ), data( size * components )
+        {
+        }
+
+        /// Number of objects.
+        std::size_t size() const noexcept
+        {
+            return n;
+        }
+
+        /// Number of scalar components per object.
+        int components() const noexcept
+        {
+            return m;
+        }
+
+        /// Resize storage. Existing values are not preserved.
+        void resize( std::size_t size, int components )
+        {
+            n = size;
+            m = components;
+            data.resize( n * m );
+        }
+
+        /// Contiguous storage of the k-th component of all objects.
+        Scalar* component( int k ) noexcept
+        {
+            return data.data() + k * n;
+        }
+
+        /// Contiguous storage of the k-th component of all objects.
+        const Scalar* component( int k ) const noexcept
+        {
+            return data.data() + k * n;
+        }
+
+        /// Access k-th component of the p-th object.
+        Scalar& operator()( int k, std::size_t p ) noexcept
+        {
+            return data[ k * n + p ];
+        }
+
+        /// Access k-th component of the p-th object.
+        const Scalar& operator()( int k, std::size_t p ) const noexcept
+        {
+            return data[ k * n + p ];
+        }
+
+    private:
+        std::size_t n;
+        int m;
+        std::vector< Scalar > data;
+    };
+
+    /**
+     * @brief Batch of arguments of type Arg in structure-of-arrays layout.
+     *
+     * Arg must either be arithmetic or a matrix of constant size. Matrix entries are enumerated
+     * row-wise.
+     */
+    template < class Arg >
+    class Batch : public BatchStorage< typename Detail::Components< Arg >::Scalar >
+    {
+        using Base = BatchStorage< typename Detail::Components< Arg >::Scalar >;
+
+    public:
+        /// Number of scalar components of Arg.
+        static constexpr int numberOfComponents = Detail::Components< Arg >::value;
+
+        /// Constructor.
+        explicit Batch( std::size_t size = 0 ) : Base( size, numberOfComponents )
+        {
+        }
+
+        /// Extract the p-th object.
+        Arg operator[]( std::size_t p ) const
+        {
+            auto x = zero< Arg >();
+            for ( int k = 0; k < numberOfComponents; ++k )
+                Detail::Components< Arg >::entry( x, k ) = ( *this )( k, p );
+            return x;
+        }
+
+        /// Store x as p-th object.
+        void set( std::size_t p, Arg x )
+        {
+            for ( int k = 0; k < numberOfComponents; ++k )
+                ( *this )( k, p ) = Detail::Components< Arg >::entry( x, k );
+        }
+    };
+
+    /**
+     * @brief Values and derivatives for a batch of arguments of type Arg.
+     *
+     * For each point p
+     *  - d0(0,p) holds the function value,
+     *  - d1(k,p) holds the first derivative in direction of the k-th unit direction, thus d1[p] is
+     * the gradient,
+     *  - d2(k*m+l,p), m=Batch<Arg>::numberOfComponents, holds the second derivative in the k-th and
+     * l-th unit direction.
+     */
+    template < class Arg >
+    struct BatchResult
+    {
+        using Scalar = typename Detail::Components< Arg >::Scalar;
+
+        BatchStorage< Scalar > d0;
+        Batch< Arg > d1;
+        BatchStorage< Scalar > d2;
+    };
+
+    /// @cond
+    namespace BatchDetail
+    {
+        /// Resize result for n points, if necessary.
+        template < int order, class Arg >
+        void prepare( BatchResult< Arg >& result, std::size_t n )
+        {
+            static_assert( order >= 0 && order <= 2,
+                           "Batched evaluation is only implemented for derivatives up to order 2." );
+            constexpr int m = Detail::Components< Arg >::value;
+
+            if ( result.d0.size() != n )
+                result.d0.resize( n, 1 );
+            if ( order > 0 && result.d1.size() != n )
+                result.d1 = Batch< Arg >( n );
+            if ( order > 1 && ( result.d2.size() != n || result.d2.components() != m * m ) )
+                result.d2.resize( n, m * m );
+        }
+
+        /// True if Value is a pack of scalars of type Scalar, i.e. Simd<Scalar,lanes>.
+        template < class Value, class Scalar >
+        struct IsPackOf : std::false_type
+        {
+        };
+
+        template < class Scalar, int lanes >
+        struct IsPackOf< Simd< Scalar, lanes >, Scalar > : std::true_type
+        {
+        };
+
+        /// Store the first size lanes of y to x.
+        template < class Pack >
+        void store( const Pack& y, typename Pack::value_type* x, std::size_t size )
+        {
+            if ( size == static_cast< std::size_t >( Pack::size() ) )
+                return y.store( x );
+            for ( std::size_t i = 0; i < size; ++i )
+                x[ i ] = y[ static_cast< int >( i ) ];
+        }
+
+        /// Point-wise evaluation, i.e. f is updated once per point.
+        template < int order, class F, class Arg >
+        void evaluate( F& f, const Batch< Arg >& x, BatchResult< Arg >& result, std::size_t begin,
+                       std::size_t end, std::false_type )
+        {
+            using Components = Detail::Components< Arg >;
+            constexpr int m = Components::value;
+
+            std::array< Arg, blockSize > block;
+            block.fill( zero< Arg >() );
+
+            for ( std::size_t p0 = begin; p0 < end; p0 += blockSize )
+            {
+                const auto size = std::min( blockSize, end - p0 );
+
+                for ( int k = 0; k < m; ++k )
+                {
+                    const auto* xk = x.component( k ) + p0;
+                    for ( std::size_t p = 0; p < size; ++p )
+                        Components::entry( block[ p ], k ) = xk[ p ];
+                }
+
+                for ( std::size_t p = 0; p < size; ++p )
+                {
+                    f.update( block[ p ] );
+                    result.d0( 0, p0 + p ) = f();
+
+                    if ( order > 0 )
+                        result.d1.set( p0 + p, f.template gradient< Arg >() );
+
+                    if ( order > 1 )
+                    {
+                        const auto H = f.template packedHessian< Arg >();
+                        for ( int k = 0; k < m; ++k )
+                            for ( int l = 0; l < m; ++l )
+                                result.d2( k * m + l, p0 + p ) = H[ packedIndex( k, l, m ) ];
+                    }
+                }
+            }
+        }
+
+        /// Argument type of functions of packs: Pack for arithmetic Arg, otherwise the matrix type
+        /// with entries of type Pack.
+        template < class Arg, class Pack, class = void >
+        struct Packed;
+
+        template < class Arg, class Pack >
+        struct Packed< Arg, Pack, std::enable_if_t< is_arithmetic< Arg >::value > >
+        {
+            using type = Pack;
+        };
+
+        template < template < class, int, int > class Matrix, class Scalar, int rows, int cols,
+                   class Pack >
+        struct Packed< Matrix< Scalar, rows, cols >, Pack >
+        {
+            using type = Matrix< Pack, rows, cols >;
+        };
+
+        template < template < class, int, int, int, int, int > class Matrix, class Scalar,
+                   int rows, int cols, int options, int maxRows, int maxCols, class Pack >
+        struct Packed< Matrix< Scalar, rows, cols, options, maxRows, maxCols >, Pack >
+        {
+            using type = Matrix< Pack, rows, cols, options, maxRows, maxCols >;
+        };
+
+        /// Vectorized evaluation of a function of Packed<Arg,Simd<Scalar,lanes>>, i.e. f is
+        /// updated once per 'lanes' points. Unused lanes of the last pack repeat the last point.
+        template < int order, class F, class Arg >
+        void evaluate( F& f, const Batch< Arg >& x, BatchResult< Arg >& result, std::size_t begin,
+                       std::size_t end, std::true_type )
+        {
+            using Pack = decay_t< decltype( f() ) >;
+            using PackedArg = typename Packed< Arg, Pack >::type;
+            using Components = Detail::Components< PackedArg >;
+            constexpr int m = Components::value;
+            constexpr auto lanes = static_cast< std::size_t >( Pack::size() );
+
+            auto y = zero< PackedArg >();
+            for ( std::size_t p0 = begin; p0 < end; p0 += lanes )
+            {
+                const auto size = std::min( lanes, end - p0 );
+                for ( int k = 0; k < m; ++k )
+                {
+                    Pack& yk = Components::entry( y, k );
+                    if ( size == lanes )
+                        yk = Pack::load( x.component( k ) + p0 );
+                    else
+                        for ( std::size_t i = 0; i < lanes; ++i )
+                            yk.set( static_cast< int >( i ),
+                                    x( k, p0 + std::min( i, size - 1 ) ) );
+                }
+
+                f.update( y );
+                store( Pack( f() ), result.d0.component( 0 ) + p0, size );
+
+                if ( order > 0 )
+                {
+                    auto g = f.template gradient< PackedArg >();
+                    for ( int k = 0; k < m; ++k )
+                        store( Pack( Components::entry( g, k ) ), result.d1.component( k ) + p0,
+                               size );
+                }
+
+                if ( order > 1 )
+                {
+                    const auto H = f.template packedHessian< PackedArg >();
+                    for ( int k = 0; k < m; ++k )
+                        for ( int l = 0; l < m; ++l )
+                            store( Pack( H[ packedIndex( k, l, m ) ] ),
+                                   result.d2.component( k * m + l ) + p0, size );
+                }
+            }
+        }
+
+        /// Evaluate f for the points begin,...,end-1. The result must already have the correct
+        /// size, see prepare().
+        template < int order, class F, class Arg >
+        void evaluate( F& f, const Batch< Arg >& x, BatchResult< Arg >& result, std::size_t begin,
+                       std::size_t end )
+        {
+            static_assert( !Checks::Has::variable< F >(),
+                           "Batched evaluation is not supported for functions with variables." );
+            evaluate< order >( f, x, result, begin, end,
+                               IsPackOf< decay_t< decltype( f() ) >,
+                                         typename Detail::Components< Arg >::Scalar >() );
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Evaluate f and its derivatives up to order 'order' for all points of a batch.
+     *
+     * Results are written to result, which is resized if necessary. Reusing the same result object
+     * for subsequent calls avoids all memory allocations.
+     *
+     * If f returns Simd<Scalar,lanes>, Scalar being the scalar type of Arg, then 'lanes' points are
+     * loaded into one pack and f is evaluated once per pack. For scalar arguments f must be a
+     * function of Simd<Scalar,lanes>, e.g.
+     * @code
+     * using Pack = Simd<double,4>;
+     * auto f = finalize( Pow<3,1,Pack>()( identity( Pack(1.) ) ) );
+     * @endcode
+     * For matrix arguments f must be a function of matrices with entries of type
+     * Simd<Scalar,lanes>, e.g. of Eigen::Matrix<Pack,3,3> for Arg = Eigen::Matrix3d (include
+     * fung/util/simd_eigen.hh for Eigen matrices of packs). This only pays off if the instruction
+     * set selected at compile time provides vectors of 'lanes' scalars (e.g. -mavx2 for
+     * Simd<double,4>), see Simd.
+     *
+     * Otherwise f is updated and differentiated once per point, i.e. the costs are those of
+     * x.size() separate evaluations. Arguments are gathered blockwise from the structure-of-arrays
+     * storage of x, such that only the copies into arguments of type Arg run over contiguous
+     * memory.
+     *
+     * Only functions without independent variables (see Variable) are supported.
+     *
+     * @param f finalized function, i.e. the return type of finalize( ... )
+     * @param x points of evaluation
+     * @param result values and derivatives at all points of evaluation
+     * @tparam order highest order of computed derivatives (0,1 or 2)
+     */
+    template < int order = 2, class F, class Arg >
+    void evaluate( F& f, const Batch< Arg >& x, BatchResult< Arg >& result )
+    {
+        BatchDetail::prepare< order >( result, x.size() );
+        BatchDetail::evaluate< order >( f, x, result, 0, x.size() );
+    }
+
+    /**
+     * @brief Evaluate f and its derivatives up to order 'order' for all points of a batch.
+     * @param f finalized function, i.e. the return type of finalize( ... )
+     * @param x points of evaluation
+     * @tparam order highest order of computed derivatives (0,1 or 2)
+     * @return values and derivatives at all points of evaluation, see BatchResult
+     */
+    template < int order = 2, class F, class Arg >
+    BatchResult< Arg > evaluate( F& f, const Batch< Arg >& x )
+    {
+        BatchResult< Arg > result;
+        evaluate< order >( f, x, result );
+        return result;
+    }
+}
@@ -6,67 +6,97 @@
 
 #include <cmath>
 #include "fung/util/chainer.hh"
+#include "fung/util/evaluation_order.hh"
 #include "fung/util/exceptions.hh"
 #include "fung/util/static_checks.hh"
+#include "fung/util/type_traits.hh"
 #include "arcsine.hh"
 
 namespace FunG
 {
-  /*!
-    @ingroup CMathGroup
+  namespace CMath
+  {
+    /*!
+      @ingroup CMathGroup
 
-    @brief Arc cosine function including first three derivatives (based on acos(double) in \<cmath\>).
+      @brief Arc cosine function including first three derivatives (based on acos(double) in \<cmath\>).
 
-    For scalar functions directional derivatives are less interesting. Incorporating this function as building block for more complex functions requires directional derivatives. These occur
-    during applications of the chain rule.
-   */
-  struct ACos : Chainer<ACos>
-  {
-    //! @copydoc Cos::Cos()
-    explicit ACos(double x=0.)
+      For scalar functions directional derivatives are less interesting. Incorporating this function as building block for more complex functions requires directional derivatives. These occur
+      during applications of the chain rule.
+     */
+    template <class Scalar>
+    struct ACos : Chainer< ACos<Scalar> >
     {
-      update(x);
-    }
+      //! @copydoc CMath::Cos::Cos()
+      explicit ACos(Scalar x=0.)
+      {
+        update(x);
+      }
 
-    //! @copydoc Cos::update()
-    void update(double x)
-    {
+      //! @copydoc CMath::Cos::update()
+      void update(Scalar x)
+      {
 #ifdef FUNG_ENABLE_EXCEPTIONS
-      if( x < -1 || x > 1 ) throw OutOfDomainException("ACos","[-1,1]",x,__FILE__,__LINE__);
+        if( x < -1 || x > 1 ) throw OutOfDomainException("ACos","[-1,1]",x,__FILE__,__LINE__);
 #endif
-      value = ::acos(x);
-      firstDerivative = -1/::sqrt(1-(x*x));
-      firstDerivative3 = firstDerivative * firstDerivative * firstDerivative;
-      x_ = x;
-    }
+        using std::acos;
+        using std::sqrt;
+        value = acos(x);
+        firstDerivative = -1/sqrt(1-(x*x));
+        firstDerivative3 = firstDerivative * firstDerivative * firstDerivative;
+        x_ = x;
+      }
 
-    //! @copydoc Cos::d0()
-    double d0() const noexcept
-    {
-      return value;
-    }
+      /// Set point of evaluation. Skips the computation of derivatives of order larger than n.
+      template <int n>
+      void update(Scalar x, EvaluationOrder<n>)
+      {
+#ifdef FUNG_ENABLE_EXCEPTIONS
+        if( x < -1 || x > 1 ) throw OutOfDomainException("ACos","[-1,1]",x,__FILE__,__LINE__);
+#endif
+        using std::acos;
+        using std::sqrt;
+        value = acos(x);
+        if( n > 0 )
+        {
+          firstDerivative = -1/sqrt(1-(x*x));
+          if( n > 1 ) firstDerivative3 = firstDerivative * firstDerivative * firstDerivative;
+        }
+        x_ = x;
+      }
 
-    //! @copydoc Cos::d1()
-    double d1(double dx=1) const
-    {
-      return firstDerivative * dx;
-    }
+      //! @copydoc CMath::Cos::d0()
+      Scalar d0() const noexcept
+      {
+        return value;
+      }
 
-    //! @copydoc Cos::d2()
-    double d2(double dx=1, double dy=1) const
-    {
-      return x_ * firstDerivative3 * dx * dy;
-    }
+      //! @copydoc CMath::Cos::d1()
+      Scalar d1(Scalar dx=1) const
+      {
+        return firstDerivative * dx;
+      }
 
-    //! @copydoc Cos::d3()
-    double d3(double dx=1, double dy=1, double dz=1) const
-    {
-      return firstDerivative3 * ( 1 + ( 3 * x_ * x_ /(firstDerivative*firstDerivative) ) ) * dx * dy * dz;
-    }
+      //! @copydoc CMath::Cos::d2()
+      Scalar d2(Scalar dx=1, Scalar dy=1) const
+      {
+        return x_ * firstDerivative3 * dx * dy;
+      }
+
+      //! @copydoc CMath::Cos::d3()
+      Scalar d3(Scalar dx=1, Scalar dy=1, Scalar dz=1) const
+      {
+        return firstDerivative3 * ( 1 + ( 3 * x_ * x_ /(firstDerivative*firstDerivative) ) ) * dx * dy * dz;
+      }
+
+    private:
+      Scalar value = 0., firstDerivative = 1., firstDerivative3 = 1., x_ = 0.;
+    };
+  }
 
-  private:
-    double value = 0., firstDerivative = 1., firstDerivative3 = 1., x_ = 0.;
-  };
+  /// @ingroup CMathGroup
+  /// Arc cosine function for arguments of type double.
+  using ACos = CMath::ACos<double>;
 
   /*!
     @ingroup CMathGroup
@@ -78,7 +108,7 @@ namespace FunG
             class = std::enable_if_t<Checks::isFunction<Function>()> >
   auto acos(const Function& f)
   {
-    return ACos()(f);
+    return CMath::ACos< cmath_scalar_t<decltype(f())> >()(f);
   }
 }
 
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <fung/util/chainer.hh>
+#include <fung/util/taylor.hh>
+
+#include <utility>
+
+namespace FunG
+{
+    namespace CMath
+    {
+        /** @addtogroup CMathGroup
+         *  @{ */
+
+        /*!
+          @brief Scalar function that is given as black-box code, including first three
+          derivatives.
+
+          The derivatives are computed in forward mode, evaluating g once for Taylor<Scalar> on
+          each update. Thus g must accept Taylor<Scalar>, e.g. a generic lambda:
+          @code
+          auto hardening = autoDiff( []( auto x ) { using std::pow; return pow( 1 + x, 0.3 ); } );
+          auto f = hardening( identity( 0. ) );
+          @endcode
+
+          @tparam Function callable that maps Taylor<Scalar> to Taylor<Scalar>
+          @tparam Scalar double or a pack of scalars, such as Simd<double,4>
+         */
+        template < class Function, class Scalar = double >
+        struct AutoDiff : Chainer< AutoDiff< Function, Scalar > >
+        {
+            /**
+             * @brief Constructor. g is not evaluated before the first call to update().
+             * @param g black-box function
+             */
+            explicit AutoDiff( Function g ) : g( std::move( g ) )
+            {
+            }
+
+            /**
+             * @brief Constructor.
+             * @param g black-box function
+             * @param x point of evaluation
+             */
+            AutoDiff( Function g, Scalar x ) : g( std::move( g ) )
+            {
+                update( x );
+            }
+
+            //! @copydoc CMath::Cos::update()
+            void update( Scalar x )
+            {
+                value = g( Taylor< Scalar >::variable( x ) );
+            }
+
+            //! @copydoc CMath::Cos::d0()
+            Scalar d0() const noexcept
+            {
+                return value.d0();
+            }
+
+            //! @copydoc CMath::Cos::d1()
+            Scalar d1( Scalar dx = 1. ) const
+            {
+                return value.d1() * dx;
+            }
+
+            //! @copydoc CMath::Cos::d2()
+            Scalar d2( Scalar dx = 1., Scalar dy = 1. ) const
+            {
+                return value.d2() * dx * dy;
+            }
+
+            //! @copydoc CMath::Cos::d3()
+            Scalar d3( Scalar dx = 1., Scalar dy = 1., Scalar dz = 1. ) const
+            {
+                return value.d3() * dx * dy * dz;
+            }
+
+        private:
+            Function g;
+            Taylor< Scalar > value;
+        };
+        /** @} */
+    }
+
+    /** @addtogroup CMathGroup
+     *  @{ */
+
+    /*!
+      @brief Generate a function from black-box scalar code.
+      @param g callable that maps Taylor<Scalar> to Taylor<Scalar>
+      @return object of type CMath::AutoDiff<Function,Scalar>
+     */
+    template < class Scalar = double, class Function >
+    auto autoDiff( Function g )
+    {
+        return CMath::AutoDiff< Function, Scalar >( std::move( g ) );
+    }
+    /** @} */
+}
@@ -6,64 +6,91 @@
 
 #include <cmath>
 #include "fung/util/chainer.hh"
+#include "fung/util/evaluation_order.hh"
 #include "fung/util/static_checks.hh"
+#include "fung/util/type_traits.hh"
 
 namespace FunG
 {
-    /*!
-      @ingroup CMathGroup
+    namespace CMath
+    {
+        /*!
+          @ingroup CMathGroup
 
-      @brief Cosine function including first three derivatives (based on cos(double) in \<cmath\>).
+          @brief Cosine function including first three derivatives (based on cos(double) in
+          \<cmath\>).
 
-      For scalar functions directional derivatives are less interesting. Incorporating this function
-      as building block for more complex functions requires directional derivatives. These occur
-      during applications of the chain rule.
-     */
-    struct Cos : Chainer< Cos >
-    {
-        /**
-         * @brief Constructor.
-         * @param x point of evaluation
+          For scalar functions directional derivatives are less interesting. Incorporating this
+          function as building block for more complex functions requires directional derivatives.
+          These occur during applications of the chain rule.
+
+          @tparam Scalar double or a pack of scalars, such as Simd<double,4>
          */
-        constexpr explicit Cos( double x = 0. )
+        template < class Scalar >
+        struct Cos : Chainer< Cos< Scalar > >
         {
-            update( x );
-        }
+            /**
+             * @brief Constructor.
+             * @param x point of evaluation
+             */
+            explicit Cos( Scalar x = 0. )
+            {
+                update( x );
+            }
 
-        /// Set point of evaluation.
-        void update( const double& x )
-        {
-            sinx = ::sin( x );
-            cosx = ::cos( x );
-        }
+            /// Set point of evaluation.
+            void update( const Scalar& x )
+            {
+                using std::sin;
+                using std::cos;
+                sinx = sin( x );
+                cosx = cos( x );
+            }
 
-        /// Function value.
-        double d0() const noexcept
-        {
-            return cosx;
-        }
+            /// Set point of evaluation. Skips the computation of \f$\sin(x)\f$ if only the
+            /// function value is required.
+            template < int n >
+            void update( const Scalar& x, EvaluationOrder< n > )
+            {
+                using std::sin;
+                using std::cos;
+                if ( n > 0 )
+                    sinx = sin( x );
+                cosx = cos( x );
+            }
 
-        /// First (directional) derivative.
-        double d1( double dx = 1. ) const
-        {
-            return -sinx * dx;
-        }
+            /// Function value.
+            Scalar d0() const noexcept
+            {
+                return cosx;
+            }
 
-        /// Second (directional) derivative.
-        double d2( double dx = 1., double dy = 1. ) const
-        {
-            return -cosx * dx * dy;
-        }
+            /// First (directional) derivative.
+            Scalar d1( Scalar dx = 1. ) const
+            {
+                return -sinx * dx;
+            }
 
-        /// Third (directional) derivative.
-        double d3( double dx = 1., double dy = 1., double dz = 1. ) const
-        {
-            return sinx * dx * dy * dz;
-        }
+            /// Second (directional) derivative.
+            Scalar d2( Scalar dx = 1., Scalar dy = 1. ) const
+            {
+                return -cosx * dx * dy;
+            }
+
+            /// Third (directional) derivative.
+            Scalar d3( Scalar dx = 1., Scalar dy = 1., Scalar dz = 1. ) const
+            {
+                return sinx * dx * dy * dz;
+            }
+
+        private:
+            Scalar sinx = 0, cosx = 1;
+        };
+    }
 
-    private:
-        double sinx = 0, cosx = 1;
-    };
+    /// @ingroup CMathGroup
+    /// Cosine function for arguments of type double.
+    using Cos = CMath::Cos< double >;
 
     /*!
       @ingroup CMathGroup
@@ -74,7 +101,7 @@ namespace FunG
     template < class Function, class = std::enable_if_t< Checks::isFunction< Function >() > >
     auto cos( const Function& f )
     {
-        return Cos()( f );
+        return CMath::Cos< cmath_scalar_t< decltype( f() ) > >()( f );
     }
 }
 
@@ -1,68 +1,96 @@
 #pragma once
 
 #include <fung/util/chainer.hh>
+#include <fung/util/evaluation_order.hh>
 #include <fung/util/static_checks.hh>
+#include <fung/util/type_traits.hh>
 
 #include <cmath>
 
 namespace FunG
 {
-    /** @addtogroup CMathGroup
-     *  @{ */
+    namespace CMath
+    {
+        /** @addtogroup CMathGroup
+         *  @{ */
 
-    /*!
-      @brief Error function including first three derivatives.
+        /*!
+          @brief Error function including first three derivatives.
 
-      For scalar functions directional derivatives are less interesting. Incorporating this function
-      as building block for more complex functions requires directional derivatives. These occur
-      during applications of the chain rule.
-     */
-    struct Erf : Chainer< Erf >
-    {
-        //! @copydoc Cos::Cos()
-        explicit Erf( double x = 0. )
+          For scalar functions directional derivatives are less interesting. Incorporating this
+          function as building block for more complex functions requires directional derivatives.
+          These occur during applications of the chain rule.
+         */
+        template < class Scalar >
+        struct Erf : Chainer< Erf< Scalar > >
         {
-            update( x );
-        }
+            //! @copydoc CMath::Cos::Cos()
+            explicit Erf( Scalar x = 0. )
+            {
+                update( x );
+            }
 
-        //! @copydoc Cos::update()
-        void update( double x )
-        {
-            x_ = x;
-            value = std::erf( x_ );
-            firstDerivative = scale * std::exp(-x_*x_);
-        }
+            //! @copydoc CMath::Cos::update()
+            void update( Scalar x )
+            {
+                using std::erf;
+                using std::exp;
+                x_ = x;
+                value = erf( x_ );
+                firstDerivative = scale * exp( -x_ * x_ );
+            }
 
-        //! @copydoc Cos::d0()
-        double d0() const noexcept
-        {
-            return value;
-        }
+            /// Set point of evaluation. Skips the computation of the first derivative if only the
+            /// function value is required.
+            template < int n >
+            void update( Scalar x, EvaluationOrder< n > )
+            {
+                using std::erf;
+                using std::exp;
+                x_ = x;
+                value = erf( x_ );
+                if ( n > 0 )
+                    firstDerivative = scale * exp( -x_ * x_ );
+            }
 
-        //! @copydoc Cos::d1()
-        double d1( double dx = 1. ) const
-        {
-            return firstDerivative * dx;
-        }
+            //! @copydoc CMath::Cos::d0()
+            Scalar d0() const noexcept
+            {
+                return value;
+            }
 
-        //! @copydoc Cos::d2()
-        double d2( double dx = 1., double dy = 1. ) const
-        {
-            return -2*x_*d1(dx)*dy;
-        }
+            //! @copydoc CMath::Cos::d1()
+            Scalar d1( Scalar dx = 1. ) const
+            {
+                return firstDerivative * dx;
+            }
 
-        //! @copydoc Cos::d3()
-        double d3( double dx = 1., double dy = 1., double dz = 1. ) const
-        {
-            return (4*x_*x_ - 2)*d1(dx)*dy*dz;
-        }
+            //! @copydoc CMath::Cos::d2()
+            Scalar d2( Scalar dx = 1., Scalar dy = 1. ) const
+            {
+                return -2 * x_ * d1( dx ) * dy;
+            }
+
+            //! @copydoc CMath::Cos::d3()
+            Scalar d3( Scalar dx = 1., Scalar dy = 1., Scalar dz = 1. ) const
+            {
+                return ( 4 * x_ * x_ - 2 ) * d1( dx ) * dy * dz;
+            }
+
+        private:
+            Scalar scale = 2 / std::sqrt( M_PI );
+            Scalar value = 0.;
+            Scalar firstDerivative = 1.;
+            Scalar x_ = 0;
+        };
+        /** @} */
+    }
+
+    /** @addtogroup CMathGroup
+     *  @{ */
 
-    private:
-        double scale = 2/std::sqrt(M_PI);
-        double value = 0.;
-        double firstDerivative = 1.;
-        double x_ = 0;
-    };
+    /// Error function for arguments of type double.
+    using Erf = CMath::Erf< double >;
 
     /*!
       @brief Generate \f$ \erf\circ f \f$.
@@ -72,7 +100,7 @@ namespace FunG
     template < class Function, class = std::enable_if_t< Checks::isFunction< Function >() > >
     auto erf( const Function& f )
     {
-        return Erf()( f );
+        return CMath::Erf< cmath_scalar_t< decltype( f() ) > >()( f );
     }
     /** @} */
 }
@@ -7,101 +7,119 @@
 #include <cmath>
 #include "fung/util/chainer.hh"
 #include "fung/util/static_checks.hh"
+#include "fung/util/type_traits.hh"
 
 namespace FunG
 {
-  /** @addtogroup CMathGroup
-   *  @{ */
-
-  /*!
-    @brief Exponential function including first three derivatives.
-
-    For scalar functions directional derivatives are less interesting. Incorporating this function as building block for more complex functions requires directional derivatives. These occur
-    during applications of the chain rule.
-   */
-  struct Exp : Chainer<Exp>
+  namespace CMath
   {
-    //! @copydoc Cos::d0()
-    explicit Exp(double x=0.) { update(x); }
+    /** @addtogroup CMathGroup
+     *  @{ */
 
-    //! @copydoc Cos::update()
-    void update(double x)
-    {
-      e_x = ::exp(x);
-    }
+    /*!
+      @brief Exponential function including first three derivatives.
 
-    //! @copydoc Cos::d0()
-    double d0() const noexcept
+      For scalar functions directional derivatives are less interesting. Incorporating this function as building block for more complex functions requires directional derivatives. These occur
+      during applications of the chain rule.
+     */
+    template <class Scalar>
+    struct Exp : Chainer< Exp<Scalar> >
     {
-      return e_x;
-    }
-
-    //! @copydoc Cos::d0()
-    double d1(double dx = 1.) const
+      //! @copydoc CMath::Cos::d0()
+      explicit Exp(Scalar x=0.) { update(x); }
+
+      //! @copydoc CMath::Cos::update()
+      void update(Scalar x)
+      {
+        using std::exp;
+        e_x = exp(x);
+      }
+
+      //! @copydoc CMath::Cos::d0()
+      Scalar d0() const noexcept
+      {
+        return e_x;
+      }
+
+      //! @copydoc CMath::Cos::d0()
+      Scalar d1(Scalar dx = 1.) const
+      {
+        return e_x * dx;
+      }
+
+      //! @copydoc CMath::Cos::d0()
+      Scalar d2(Scalar dx = 1., Scalar dy = 1.) const
+      {
+        return e_x * dx * dy;
+      }
+
+      //! @copydoc CMath::Cos::d0()
+      Scalar d3(Scalar dx = 1., Scalar dy = 1., Scalar dz = 1.) const
+      {
+        return e_x * dx * dy * dz;
+      }
+
+    private:
+      Scalar e_x = 1.;
+    };
+
+    /*!
+      @brief Function \f$2^x\f$ including first three derivatives.
+
+      For scalar functions directional derivatives are less interesting. Incorporating this function as building block for more complex functions requires directional derivatives. These occur
+      during applications of the chain rule.
+     */
+    template <class Scalar>
+    struct Exp2 : Chainer< Exp2<Scalar> >
     {
-      return e_x * dx;
-    }
-
-    //! @copydoc Cos::d0()
-    double d2(double dx = 1., double dy = 1.) const
-    {
-      return e_x * dx * dy;
-    }
-
-    //! @copydoc Cos::d0()
-    double d3(double dx = 1., double dy = 1., double dz = 1.) const
-    {
-      return e_x * dx * dy * dz;
-    }
-
-  private:
-    double e_x = 1.;
-  };
-
-  /*!
-    @brief Function \f$2^x\f$ including first three derivatives.
-
-    For scalar functions directional derivatives are less interesting. Incorporating this function as building block for more complex functions requires directional derivatives. These occur
-    during applications of the chain rule.
-   */
-  struct Exp2 : Chainer<Exp2>
-  {
-    //! @copydoc Cos::Cos()
-    explicit Exp2(double x=0.) { update(x); }
-
-    //! @copydoc Cos::update()
-    void update(double x)
-    {
-      value = exp2(x);
-    }
-
-    //! @copydoc Cos::d0()
-    double d0() const noexcept
-    {
-      return value;
-    }
-
-    //! @copydoc Cos::d1()
-    double d1(double dx = 1.) const
-    {
-      return value * ln2 * dx;
-    }
+      //! @copydoc CMath::Cos::Cos()
+      explicit Exp2(Scalar x=0.) { update(x); }
+
+      //! @copydoc CMath::Cos::update()
+      void update(Scalar x)
+      {
+        using std::exp2;
+        value = exp2(x);
+      }
+
+      //! @copydoc CMath::Cos::d0()
+      Scalar d0() const noexcept
+      {
+        return value;
+      }
+
+      //! @copydoc CMath::Cos::d1()
+      Scalar d1(Scalar dx = 1.) const
+      {
+        return value * ln2 * dx;
+      }
+
+      //! @copydoc CMath::Cos::d2()
+      Scalar d2(Scalar dx = 1., Scalar dy = 1.) const
+      {
+        return value * ln2 * ln2 * dx * dy;
+      }
+
+      //! @copydoc CMath::Cos::d3()
+      Scalar d3(Scalar dx = 1., Scalar dy = 1., Scalar dz = 1.) const
+      {
+        return value * ln2 * ln2 * ln2 * dx * dy * dz;
+      }
+
+    private:
+      Scalar value = 1., ln2 = std::log(2.);
+    };
+    /** @} */
+  }
 
-    //! @copydoc Cos::d2()
-    double d2(double dx = 1., double dy = 1.) const
-    {
-      return value * ln2 * ln2 * dx * dy;
-    }
+  /** @addtogroup CMathGroup
+   *  @{ */
 
-    //! @copydoc Cos::d3()
-    double d3(double dx = 1., double dy = 1., double dz = 1.) const
-    {
-      return value * ln2 * ln2 * ln2 * dx * dy * dz;
-    }
+  /// Exponential function for arguments of type double.
+  using Exp = CMath::Exp<double>;
 
-  private:
-    double value = 1., ln2 = log(2.);
-  };
+  /// Function \f$2^x\f$ for arguments of type double.
+  using Exp2 = CMath::Exp2<double>;
 
   /*!
     @brief Generate \f$ \exp(f) \f$.
@@ -111,7 +129,7 @@ namespace FunG
   template <class Function, class = std::enable_if_t<Checks::isFunction<Function>()> >
   auto exp(const Function& f)
   {
-    return Exp()(f);
+    return CMath::Exp< cmath_scalar_t<decltype(f())> >()(f);
   }
 
   /*!
@@ -122,7 +140,7 @@ namespace FunG
   template <class Function, class = std::enable_if_t<Checks::isFunction<Function>()> >
   auto exp2(const Function& f)
   {
-    return Exp2()(f);
+    return CMath::Exp2< cmath_scalar_t<decltype(f())> >()(f);
   }
   /** @} */
 }
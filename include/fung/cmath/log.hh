@@ -6,11 +6,15 @@
 
 #include <cmath>
 #include "fung/util/chainer.hh"
+#include "fung/util/evaluation_order.hh"
 #include "fung/util/exceptions.hh"
 #include "fung/util/static_checks.hh"
+#include "fung/util/type_traits.hh"
 
 namespace FunG
 {
+  namespace CMath
+  {
   /** @addtogroup CMathGroup
    *  @{ */
 
@@ -20,47 +24,61 @@ namespace FunG
    * For scalar functions directional derivatives are less interesting. Incorporating this function as building block for more complex functions requires directional derivatives. These occur
    * during applications of the chain rule.
    */
-  struct LN : Chainer<LN>
+  template <class Scalar>
+  struct LN : Chainer< LN<Scalar> >
   {
-    //! @copydoc Cos::Cos()
-    explicit LN(double x=1.) { update(x); }
+    //! @copydoc CMath::Cos::Cos()
+    explicit LN(Scalar x=1.) { update(x); }
 
-    //! @copydoc Cos::update()
-    void update(double x)
+    //! @copydoc CMath::Cos::update()
+    void update(Scalar x)
     {
 #ifdef FUNG_ENABLE_EXCEPTIONS
       if( x <= 0 ) throw OutOfDomainException("LN","]0,inf[",x,__FILE__,__LINE__);
 #endif
+      using std::log;
       x_inv = 1./x;
-      value = ::log(x);
+      value = log(x);
+    }
+
+    /// Set point of evaluation. Skips the computation of \f$x^{-1}\f$ if only the function value is required.
+    template <int n>
+    void update(Scalar x, EvaluationOrder<n>)
+    {
+#ifdef FUNG_ENABLE_EXCEPTIONS
+      if( x <= 0 ) throw OutOfDomainException("LN","]0,inf[",x,__FILE__,__LINE__);
+#endif
+      using std::log;
+      if( n > 0 ) x_inv = 1./x;
+      value = log(x);
     }
 
-    //! @copydoc Cos::d0()
-    double d0() const noexcept
+    //! @copydoc CMath::Cos::d0()
+    Scalar d0() const noexcept
     {
       return value;
     }
 
-    //! @copydoc Cos::d1()
-    double d1(double dx = 1.) const
+    //! @copydoc CMath::Cos::d1()
+    Scalar d1(Scalar dx = 1.) const
     {
       return x_inv * dx;
     }
 
-    //! @copydoc Cos::d2()
-    double d2(double dx = 1., double dy = 1.) const
+    //! @copydoc CMath::Cos::d2()
+    Scalar d2(Scalar dx = 1., Scalar dy = 1.) const
     {
       return - x_inv * x_inv * dx * dy;
     }
 
-    //! @copydoc Cos::d3()
-    double d3(double dx = 1., double dy = 1., double dz = 1.) const
+    //! @copydoc CMath::Cos::d3()
+    Scalar d3(Scalar dx = 1., Scalar dy = 1., Scalar dz = 1.) const
     {
       return 2 * x_inv * x_inv * x_inv * dx * dy * dz;
     }
 
   private:
-    double value = 0., x_inv = 1.;
+    Scalar value = 0., x_inv = 1.;
   };
 
   /**
@@ -69,47 +87,61 @@ namespace FunG
    * For scalar functions directional derivatives are less interesting. Incorporating this function as building block for more complex functions requires directional derivatives. These occur
    * during applications of the chain rule.
    */
-  struct Log10 : Chainer<Log10>
+  template <class Scalar>
+  struct Log10 : Chainer< Log10<Scalar> >
   {
-    //! @copydoc Cos::Cos()
-    explicit Log10(double x=1.) { update(x); }
+    //! @copydoc CMath::Cos::Cos()
+    explicit Log10(Scalar x=1.) { update(x); }
 
-    //! @copydoc Cos::update()
-    void update(double x)
+    //! @copydoc CMath::Cos::update()
+    void update(Scalar x)
     {
 #ifdef FUNG_ENABLE_EXCEPTIONS
       if( x <= 0 ) throw OutOfDomainException("Log10","]0,inf[",x,__FILE__,__LINE__);
 #endif
+      using std::log10;
       x_inv = 1./x;
-      value = ::log10(x);
+      value = log10(x);
     }
 
-    //! @copydoc Cos::d0()
-    double d0() const noexcept
+    /// Set point of evaluation. Skips the computation of \f$x^{-1}\f$ if only the function value is required.
+    template <int n>
+    void update(Scalar x, EvaluationOrder<n>)
+    {
+#ifdef FUNG_ENABLE_EXCEPTIONS
+      if( x <= 0 ) throw OutOfDomainException("Log10","]0,inf[",x,__FILE__,__LINE__);
+#endif
+      using std::log10;
+      if( n > 0 ) x_inv = 1./x;
+      value = log10(x);
+    }
+
+    //! @copydoc CMath::Cos::d0()
+    Scalar d0() const noexcept
     {
       return value;
     }
 
-    //! @copydoc Cos::d1()
-    double d1(double dx = 1.) const
+    //! @copydoc CMath::Cos::d1()
+    Scalar d1(Scalar dx = 1.) const
     {
       return ln10inv * x_inv * dx;
     }
 
-    //! @copydoc Cos::d2()
-    double d2(double dx = 1., double dy = 1.) const
+    //! @copydoc CMath::Cos::d2()
+    Scalar d2(Scalar dx = 1., Scalar dy = 1.) const
     {
       return - ln10inv * x_inv * x_inv * dx * dy;
     }
 
-    //! @copydoc Cos::d3()
-    double d3(double dx = 1., double dy = 1., double dz = 1.) const
+    //! @copydoc CMath::Cos::d3()
+    Scalar d3(Scalar dx = 1., Scalar dy = 1., Scalar dz = 1.) const
     {
       return 2 * ln10inv * x_inv * x_inv * x_inv * dx * dy * dz;
     }
 
   private:
-    double value = 0., x_inv = 1., ln10inv = 1/log(10.);
+    Scalar value = 0., x_inv = 1., ln10inv = 1/std::log(10.);
   };
 
   /**
@@ -118,59 +150,87 @@ namespace FunG
    * For scalar functions directional derivatives are less interesting. Incorporating this function as building block for more complex functions requires directional derivatives. These occur
    * during applications of the chain rule.
    */
-  struct Log2 : Chainer<Log2>
+  template <class Scalar>
+  struct Log2 : Chainer< Log2<Scalar> >
   {
-    //! @copydoc Cos::Cos()
-    explicit Log2(double x=1.) { update(x); }
+    //! @copydoc CMath::Cos::Cos()
+    explicit Log2(Scalar x=1.) { update(x); }
 
-    //! @copydoc Cos::update()
-    void update(double x)
+    //! @copydoc CMath::Cos::update()
+    void update(Scalar x)
     {
 #ifdef FUNG_ENABLE_EXCEPTIONS
       if( x <= 0 ) throw OutOfDomainException("Log2","]0,inf[",x,__FILE__,__LINE__);
 #endif
+      using std::log2;
       x_inv = 1./x;
-      value = ::log2(x);
+      value = log2(x);
     }
 
-    //! @copydoc Cos::d0()
-    double d0() const noexcept
+    /// Set point of evaluation. Skips the computation of \f$x^{-1}\f$ if only the function value is required.
+    template <int n>
+    void update(Scalar x, EvaluationOrder<n>)
+    {
+#ifdef FUNG_ENABLE_EXCEPTIONS
+      if( x <= 0 ) throw OutOfDomainException("Log2","]0,inf[",x,__FILE__,__LINE__);
+#endif
+      using std::log2;
+      if( n > 0 ) x_inv = 1./x;
+      value = log2(x);
+    }
+
+    //! @copydoc CMath::Cos::d0()
+    Scalar d0() const noexcept
     {
       return value;
     }
 
-    //! @copydoc Cos::d1()
-    double d1(double dx = 1.) const
+    //! @copydoc CMath::Cos::d1()
+    Scalar d1(Scalar dx = 1.) const
     {
       return ln2inv * x_inv * dx;
     }
 
-    //! @copydoc Cos::d2()
-    double d2(double dx = 1., double dy = 1.) const
+    //! @copydoc CMath::Cos::d2()
+    Scalar d2(Scalar dx = 1., Scalar dy = 1.) const
     {
       return - ln2inv * x_inv * x_inv * dx * dy;
     }
 
-    //! @copydoc Cos::d3()
-    double d3(double dx = 1., double dy = 1., double dz = 1.) const
+    //! @copydoc CMath::Cos::d3()
+    Scalar d3(Scalar dx = 1., Scalar dy = 1., Scalar dz = 1.) const
     {
       return 2 * ln2inv * x_inv * x_inv * x_inv * dx * dy * dz;
     }
 
   private:
-    double value = 0., x_inv = 1., ln2inv = 1/log(2.);
+    Scalar value = 0., x_inv = 1., ln2inv = 1/std::log(2.);
   };
+  /** @} */
+  }
+
+  /** @addtogroup CMathGroup
+   *  @{ */
+
+  /// Natural logarithm for arguments of type double.
+  using LN = CMath::LN<double>;
+
+  /// Common (base 10) logarithm for arguments of type double.
+  using Log10 = CMath::Log10<double>;
+
+  /// %Base 2 logarithm for arguments of type double.
+  using Log2 = CMath::Log2<double>;
 
   /*!
     @brief Generate \f$ \mathrm{ln}\circ f \f$.
     @param f function mapping into a scalar space
-    @return object of type MathematicalOperations::Chain<Log,Function>
+    @return object of type MathematicalOperations::Chain<LN,Function>
    */
   template <class Function,
             class = std::enable_if_t<Checks::isFunction<Function>()> >
   auto ln(const Function& f)
   {
-    return LN()(f);
+    return CMath::LN< cmath_scalar_t<decltype(f())> >()(f);
   }
 
   /*!
@@ -182,7 +242,7 @@ namespace FunG
             class = std::enable_if_t<Checks::isFunction<Function>()> >
   auto log10(const Function& f)
   {
-    return Log10()(f);
+    return CMath::Log10< cmath_scalar_t<decltype(f())> >()(f);
   }
 
   /*!
@@ -194,7 +254,7 @@ namespace FunG
             class = std::enable_if_t<Checks::isFunction<Function>()> >
   auto log2(const Function& f)
   {
-    return Log2()(f);
+    return CMath::Log2< cmath_scalar_t<decltype(f())> >()(f);
   }
   /** @} */
 }
@@ -24,7 +24,7 @@ namespace FunG
     template < class F, class G >
     struct Min
     {
-        //! @copydoc Cos::Cos()
+        //! @copydoc CMath::Cos::Cos()
         explicit Min( const F& f, const G& g ) : f_( f ), g_( g )
         {
             update_value();
@@ -39,6 +39,15 @@ namespace FunG
             update_value();
         }
 
+        /// Update point of evaluation. Only derivatives up to order k will be evaluated.
+        template < class Arg, int k >
+        void update( Arg&& x, EvaluationOrder< k > order )
+        {
+            update_if_present( f_, x, order );
+            update_if_present( g_, x, order );
+            update_value();
+        }
+
         /// Update variable corresponding to index.
         template < int index, class Arg >
         void update( Arg&& x )
@@ -56,7 +65,7 @@ namespace FunG
             update_value();
         }
 
-        //! @copydoc Cos::d0()
+        //! @copydoc CMath::Cos::d0()
         double operator()() const noexcept
         {
             return value_;
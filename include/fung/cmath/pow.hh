@@ -4,8 +4,10 @@
 #pragma once
 
 #include <fung/util/chainer.hh>
+#include <fung/util/evaluation_order.hh>
 #include <fung/util/exceptions.hh>
 #include <fung/util/static_checks.hh>
+#include <fung/util/type_traits.hh>
 
 #include <cmath>
 
@@ -23,139 +25,194 @@ namespace FunG
       during applications of the chain rule.
       For the cases \f$k=-1\f$ and \f$k=2\f$ specializations are used that avoid the use of
       std::pow.
+      If \f$k\in\{0,1,2\}\f$ then derivatives of order larger than k vanish identically. These
+      are not provided, such that they are eliminated at compile time from all expressions that
+      contain this function.
+
+      @tparam Scalar double or a pack of scalars, such as Simd<double,4>
      */
-    template < int dividend, int divisor = 1 >
-    struct Pow : Chainer< Pow< dividend, divisor > >
+    template < int dividend, int divisor = 1, class Scalar = double >
+    struct Pow : Chainer< Pow< dividend, divisor, Scalar > >
     {
-        //! @copydoc Cos::Cos()
-        explicit Pow( double x = 1 )
+    private:
+        /// Highest order of a derivative that does not vanish identically. Derivatives of higher
+        /// order are structurally zero and thus not provided.
+        static constexpr int highestNonZeroOrder =
+            ( dividend % divisor == 0 && dividend / divisor >= 0 && dividend / divisor < 3 )
+                ? dividend / divisor
+                : 3;
+
+    public:
+        //! @copydoc CMath::Cos::Cos()
+        explicit Pow( Scalar x = 1 )
         {
             update( x );
         }
 
-        //! @copydoc Cos::update()
-        void update( double x )
+        //! @copydoc CMath::Cos::update()
+        void update( Scalar x )
         {
+            update( x, EvaluationOrder< 3 >() );
+        }
+
+        /// Update point of evaluation, only computing the powers required for derivatives up to
+        /// order n.
+        template < int n >
+        void update( Scalar x, EvaluationOrder< n > )
+        {
+            constexpr auto m = n < highestNonZeroOrder ? n : highestNonZeroOrder;
 #ifdef FUNG_ENABLE_EXCEPTIONS
-            if ( k < 3 && x == 0 )
+            if ( k < m && x == 0 )
                 throw OutOfDomainException( "Pow<" + std::to_string( dividend ) + "," +
                                                 std::to_string( divisor ) + ">",
                                             "]-inf,inf[ \\ {0}", x, __FILE__, __LINE__ );
 #endif
-            xk = x * ( xk1 = x * ( xk2 = x * ( xk3 = ::pow( x, k - 3 ) ) ) );
-        }
-
-        //! @copydoc Cos::d0()
-        double d0() const noexcept
+            using std::pow;
+            switch ( m )
+            {
+            case 0:
+                xk = pow( x, Scalar( k ) );
+                break;
+            case 1:
+                xk = x * ( xk1 = pow( x, Scalar( k - 1 ) ) );
+                break;
+            case 2:
+                xk = x * ( xk1 = x * ( xk2 = pow( x, Scalar( k - 2 ) ) ) );
+                break;
+            default:
+                xk = x * ( xk1 = x * ( xk2 = x * ( xk3 = pow( x, Scalar( k - 3 ) ) ) ) );
+            }
+        }
+
+        //! @copydoc CMath::Cos::d0()
+        Scalar d0() const noexcept
         {
             return xk;
         }
 
-        //! @copydoc Cos::d1()
-        double d1( double dx = 1. ) const
+        /**
+         * @copydoc CMath::Cos::d1()
+         *
+         * Not present if \f$k=0\f$.
+         */
+        template < class Enable = void,
+                   class = std::enable_if_t< ( highestNonZeroOrder > 0 ), Enable > >
+        Scalar d1( Scalar dx = 1. ) const
         {
             return k * xk1 * dx;
         }
 
-        //! @copydoc Cos::d2()
-        double d2( double dx = 1., double dy = 1. ) const
+        /**
+         * @copydoc CMath::Cos::d2()
+         *
+         * Not present if \f$k\in\{0,1\}\f$.
+         */
+        template < class Enable = void,
+                   class = std::enable_if_t< ( highestNonZeroOrder > 1 ), Enable > >
+        Scalar d2( Scalar dx = 1., Scalar dy = 1. ) const
         {
             return k * ( k - 1 ) * xk2 * dx * dy;
         }
 
-        //! @copydoc Cos::d3()
-        double d3( double dx = 1., double dy = 1., double dz = 1. ) const
+        /**
+         * @copydoc CMath::Cos::d3()
+         *
+         * Not present if \f$k\in\{0,1,2\}\f$.
+         */
+        template < class Enable = void,
+                   class = std::enable_if_t< ( highestNonZeroOrder > 2 ), Enable > >
+        Scalar d3( Scalar dx = 1., Scalar dy = 1., Scalar dz = 1. ) const
         {
             return k * ( k - 1 ) * ( k - 2 ) * xk3 * dx * dy * dz;
         }
 
     private:
         const double k = static_cast< double >( dividend ) / divisor;
-        double xk = 0, xk1 = 0, xk2 = 0, xk3 = 0;
+        Scalar xk = 0, xk1 = 0, xk2 = 0, xk3 = 0;
     };
 
     /// @cond
-    template <>
-    struct Pow< 2, 1 > : Chainer< Pow< 2, 1 > >
+    template < class Scalar >
+    struct Pow< 2, 1, Scalar > : Chainer< Pow< 2, 1, Scalar > >
     {
-        //! @copydoc Cos::Cos()
-        explicit Pow( double x_ = 0 )
+        //! @copydoc CMath::Cos::Cos()
+        explicit Pow( Scalar x_ = 0 )
         {
             update( x_ );
         }
 
-        //! @copydoc Cos::update()
-        void update( const double& x_ )
+        //! @copydoc CMath::Cos::update()
+        void update( const Scalar& x_ )
         {
             x = 2 * x_;
             x2 = x_ * x_;
         }
 
-        //! @copydoc Cos::d0()
-        double d0() const noexcept
+        //! @copydoc CMath::Cos::d0()
+        Scalar d0() const noexcept
         {
             return x2;
         }
 
-        //! @copydoc Cos::d1()
-        double d1( double dx = 1. ) const
+        //! @copydoc CMath::Cos::d1()
+        Scalar d1( Scalar dx = 1. ) const
         {
             return x * dx;
         }
 
-        //! @copydoc Cos::d2()
-        double d2( double dx = 1, double dy = 1 ) const
+        //! @copydoc CMath::Cos::d2()
+        Scalar d2( Scalar dx = 1, Scalar dy = 1 ) const
         {
             return 2 * dx * dy;
         }
 
     private:
-        double x = 0., x2 = 0.;
+        Scalar x = 0., x2 = 0.;
     };
 
-    template <>
-    struct Pow< 3, 1 > : Chainer< Pow< 3, 1 > >
+    template < class Scalar >
+    struct Pow< 3, 1, Scalar > : Chainer< Pow< 3, 1, Scalar > >
     {
-        //! @copydoc Cos::Cos()
-        explicit Pow( double x_ = 0 )
+        //! @copydoc CMath::Cos::Cos()
+        explicit Pow( Scalar x_ = 0 )
         {
             update( x_ );
         }
 
-        //! @copydoc Cos::update()
-        void update( double x_ )
+        //! @copydoc CMath::Cos::update()
+        void update( Scalar x_ )
         {
             x = x_;
             x2 = x * x;
             x3 = x2 * x;
         }
 
-        //! @copydoc Cos::d0()
-        double d0() const noexcept
+        //! @copydoc CMath::Cos::d0()
+        Scalar d0() const noexcept
         {
             return x3;
         }
 
-        //! @copydoc Cos::d1()
-        double d1( double dx = 1 ) const
+        //! @copydoc CMath::Cos::d1()
+        Scalar d1( Scalar dx = 1 ) const
         {
             return 3 * x2 * dx;
         }
 
-        //! @copydoc Cos::d2()
-        double d2( double dx = 1, double dy = 1 ) const
+        //! @copydoc CMath::Cos::d2()
+        Scalar d2( Scalar dx = 1, Scalar dy = 1 ) const
         {
             return 6 * x * dx * dy;
         }
 
-        //! @copydoc Cos::d3()
-        double d3( double dx = 1, double dy = 1, double dz = 1 ) const
+        //! @copydoc CMath::Cos::d3()
+        Scalar d3( Scalar dx = 1, Scalar dy = 1, Scalar dz = 1 ) const
         {
             return 6 * dx * dy * dz;
         }
 
     private:
-        double x = 0., x2 = 0., x3 = 0.;
+        Scalar x = 0., x2 = 0., x3 = 0.;
     };
 
     /**
@@ -166,17 +223,17 @@ namespace FunG
      * occur
      * during applications of the chain rule.
      */
-    template <>
-    struct Pow< -1, 1 > : Chainer< Pow< -1, 1 > >
+    template < class Scalar >
+    struct Pow< -1, 1, Scalar > : Chainer< Pow< -1, 1, Scalar > >
     {
-        //! @copydoc Cos::Cos()
-        explicit Pow( double x = 1. )
+        //! @copydoc CMath::Cos::Cos()
+        explicit Pow( Scalar x = 1. )
         {
             update( x );
         }
 
-        //! @copydoc Cos::update()
-        void update( double x )
+        //! @copydoc CMath::Cos::update()
+        void update( Scalar x )
         {
 #ifdef FUNG_ENABLE_EXCEPTIONS
             if ( x == 0 )
@@ -187,99 +244,115 @@ namespace FunG
             x_inv2 = x_inv * x_inv;
         }
 
-        //! @copydoc Cos::d0()
-        double d0() const noexcept
+        /// Update point of evaluation, only computing \f$x^{-2}\f$ if derivatives are required.
+        template < int n >
+        void update( Scalar x, EvaluationOrder< n > )
+        {
+#ifdef FUNG_ENABLE_EXCEPTIONS
+            if ( x == 0 )
+                throw OutOfDomainException( "Pow<-1,1>", "]-inf,inf[ \\ {0}", x, __FILE__,
+                                            __LINE__ );
+#endif
+            x_inv = 1. / x;
+            if ( n > 0 )
+                x_inv2 = x_inv * x_inv;
+        }
+
+        //! @copydoc CMath::Cos::d0()
+        Scalar d0() const noexcept
         {
             return x_inv;
         }
 
-        //! @copydoc Cos::d1()
-        double d1( double dx = 1. ) const
+        //! @copydoc CMath::Cos::d1()
+        Scalar d1( Scalar dx = 1. ) const
         {
             return -1 * x_inv2 * dx;
         }
 
-        //! @copydoc Cos::d2()
-        double d2( double dx = 1., double dy = 1. ) const
+        //! @copydoc CMath::Cos::d2()
+        Scalar d2( Scalar dx = 1., Scalar dy = 1. ) const
         {
             return 2 * x_inv2 * x_inv * dx * dy;
         }
 
-        //! @copydoc Cos::d3()
-        double d3( double dx = 1., double dy = 1., double dz = 1. ) const
+        //! @copydoc CMath::Cos::d3()
+        Scalar d3( Scalar dx = 1., Scalar dy = 1., Scalar dz = 1. ) const
         {
             return -6 * x_inv2 * x_inv2 * dx * dy * dz;
         }
 
     private:
-        double x_inv = 1., x_inv2 = 1.;
+        Scalar x_inv = 1., x_inv2 = 1.;
     };
 
-    template <>
-    struct Pow< 1, 2 > : Chainer< Pow< 1, 2 > >
+    template < class Scalar >
+    struct Pow< 1, 2, Scalar > : Chainer< Pow< 1, 2, Scalar > >
     {
-        //! @copydoc Cos::Cos()
-        explicit Pow( double x = 0 )
+        //! @copydoc CMath::Cos::Cos()
+        explicit Pow( Scalar x = 0 )
         {
             update( x );
         }
 
-        //! @copydoc Cos::update()
-        void update( double x )
+        //! @copydoc CMath::Cos::update()
+        void update( Scalar x )
         {
 #ifdef FUNG_ENABLE_EXCEPTIONS
             if ( x < 0 )
                 throw OutOfDomainException( "Pow<1,2>", "[0,inf[", x, __FILE__, __LINE__ );
 #endif
+            using std::sqrt;
             x_ = x;
-            sqrt_x = ::sqrt( x );
+            sqrt_x = sqrt( x );
         }
 
-        //! @copydoc Cos::d0()
-        double d0() const noexcept
+        //! @copydoc CMath::Cos::d0()
+        Scalar d0() const noexcept
         {
             return sqrt_x;
         }
 
-        //! @copydoc Cos::d1()
-        double d1( double dx = 1. ) const
+        //! @copydoc CMath::Cos::d1()
+        Scalar d1( Scalar dx = 1. ) const
         {
             return 0.5 / sqrt_x * dx;
         }
 
-        //! @copydoc Cos::d2()
-        double d2( double dx = 1., double dy = 1. ) const
+        //! @copydoc CMath::Cos::d2()
+        Scalar d2( Scalar dx = 1., Scalar dy = 1. ) const
         {
             return -0.25 / ( x_ * sqrt_x ) * dx * dy;
         }
 
-        //! @copydoc Cos::d3()
-        double d3( double dx = 1., double dy = 1., double dz = 1. ) const
+        //! @copydoc CMath::Cos::d3()
+        Scalar d3( Scalar dx = 1., Scalar dy = 1., Scalar dz = 1. ) const
         {
             return 0.375 / ( x_ * x_ * sqrt_x ) * dx * dy * dz;
         }
 
     private:
-        double x_ = 0., sqrt_x = 1.;
+        Scalar x_ = 0., sqrt_x = 1.;
     };
 
     /// The function \f$ t\mapsto t^{-1/3} \f$ with first three derivatives.
-    template <>
-    struct Pow< -1, 3 > : Chainer< Pow< -1, 3 > >
+    template < class Scalar >
+    struct Pow< -1, 3, Scalar > : Chainer< Pow< -1, 3, Scalar > >
     {
-        //! @copydoc Cos::Cos()
-        explicit Pow( double t = 1 )
+        //! @copydoc CMath::Cos::Cos()
+        explicit Pow( Scalar t = 1 )
         {
             update( t );
         }
 
-        //! @copydoc Cos::update()
-        void update( double x )
+        //! @copydoc CMath::Cos::update()
+        void update( Scalar x )
         {
 #ifdef FUNG_ENABLE_EXCEPTIONS
             if ( x < 0 )
                 throw OutOfDomainException( "Pow<1,3>", "[0,inf[", x, __FILE__, __LINE__ );
 #endif
+            using std::cbrt;
             auto p = cbrt( x );
             d0val = 1 / p;
             p *= x;
@@ -290,51 +363,52 @@ namespace FunG
             d3val = -28 / ( 27 * p );
         }
 
-        //! @copydoc Cos::d0()
-        double d0() const noexcept
+        //! @copydoc CMath::Cos::d0()
+        Scalar d0() const noexcept
         {
             return d0val;
         }
 
-        //! @copydoc Cos::d1()
-        double d1( double dt = 1 ) const
+        //! @copydoc CMath::Cos::d1()
+        Scalar d1( Scalar dt = 1 ) const
         {
             return d1val * dt;
         }
 
-        //! @copydoc Cos::d2()
-        double d2( double dt0 = 1, double dt1 = 1 ) const
+        //! @copydoc CMath::Cos::d2()
+        Scalar d2( Scalar dt0 = 1, Scalar dt1 = 1 ) const
         {
             return d2val * dt0 * dt1;
         }
 
-        //! @copydoc Cos::d3()
-        double d3( double dt0 = 1, double dt1 = 1, double dt2 = 1 ) const
+        //! @copydoc CMath::Cos::d3()
+        Scalar d3( Scalar dt0 = 1, Scalar dt1 = 1, Scalar dt2 = 1 ) const
         {
             return d3val * dt0 * dt1 * dt2;
         }
 
     private:
-        double d0val = 0, d1val = 0, d2val = 0, d3val = 0;
+        Scalar d0val = 0, d1val = 0, d2val = 0, d3val = 0;
     };
 
     /// The function \f$ t\mapsto t^{2/3} \f$ with first three derivatives.
-    template <>
-    struct Pow< -2, 3 > : Chainer< Pow< -2, 3 > >
+    template < class Scalar >
+    struct Pow< -2, 3, Scalar > : Chainer< Pow< -2, 3, Scalar > >
     {
-        //! @copydoc Cos::Cos()
-        explicit Pow( double t = 1. )
+        //! @copydoc CMath::Cos::Cos()
+        explicit Pow( Scalar t = 1. )
         {
             update( t );
         }
 
-        //! @copydoc Cos::update()
-        void update( double x )
+        //! @copydoc CMath::Cos::update()
+        void update( Scalar x )
         {
 #ifdef FUNG_ENABLE_EXCEPTIONS
             if ( x < 0 )
                 throw OutOfDomainException( "Pow<2,3>", "[0,inf[", x, __FILE__, __LINE__ );
 #endif
+            using std::cbrt;
             auto p0 = cbrt( x );
             auto p = p0 * p0;
             d0val = 1 / p;
@@ -346,32 +420,32 @@ namespace FunG
             d3val = -80 / ( 27 * p );
         }
 
-        //! @copydoc Cos::d0()
-        double d0() const noexcept
+        //! @copydoc CMath::Cos::d0()
+        Scalar d0() const noexcept
         {
             return d0val;
         }
 
-        //! @copydoc Cos::d1()
-        double d1( double dt = 1 ) const
+        //! @copydoc CMath::Cos::d1()
+        Scalar d1( Scalar dt = 1 ) const
         {
             return d1val * dt;
         }
 
-        //! @copydoc Cos::d2()
-        double d2( double dt0 = 1, double dt1 = 1 ) const
+        //! @copydoc CMath::Cos::d2()
+        Scalar d2( Scalar dt0 = 1, Scalar dt1 = 1 ) const
         {
             return d2val * dt0 * dt1;
         }
 
-        //! @copydoc Cos::d3()
-        double d3( double dt0 = 1, double dt1 = 1, double dt2 = 1 ) const
+        //! @copydoc CMath::Cos::d3()
+        Scalar d3( Scalar dt0 = 1, Scalar dt1 = 1, Scalar dt2 = 1 ) const
         {
             return d3val * dt0 * dt1 * dt2;
         }
 
     private:
-        double d0val = 0, d1val = 0, d2val = 0, d3val = 0;
+        Scalar d0val = 0, d1val = 0, d2val = 0, d3val = 0;
     };
     /// @endcond
 
@@ -392,7 +466,7 @@ namespace FunG
     template < class Function, class = std::enable_if_t< Checks::isFunction< Function >() > >
     auto sqrt( const Function& f )
     {
-        return Sqrt()( f );
+        return Pow< 1, 2, cmath_scalar_t< decltype( f() ) > >()( f );
     }
 
     /*!
@@ -403,7 +477,7 @@ namespace FunG
     template < class Function, class = std::enable_if_t< Checks::isFunction< Function >() > >
     auto cbrt( const Function& f )
     {
-        return Cbrt()( f );
+        return Pow< 1, 3, cmath_scalar_t< decltype( f() ) > >()( f );
     }
 
     /*!
@@ -414,7 +488,7 @@ namespace FunG
     template < class Function, class = std::enable_if_t< Checks::isFunction< Function >() > >
     auto cbrt2( const Function& f )
     {
-        return Cbrt2()( f );
+        return Pow< 2, 3, cmath_scalar_t< decltype( f() ) > >()( f );
     }
 
     /*!
@@ -428,7 +502,7 @@ namespace FunG
                class = std::enable_if_t< Checks::isFunction< Function >() > >
     auto pow( const Function& f )
     {
-        return Pow< k, l >()( f );
+        return Pow< k, l, cmath_scalar_t< decltype( f() ) > >()( f );
     }
 
     /*!
@@ -440,7 +514,7 @@ namespace FunG
     template < int k, class Function, class = std::enable_if_t< Checks::isFunction< Function >() > >
     auto pow( const Function& f )
     {
-        return Pow< k >()( f );
+        return Pow< k, 1, cmath_scalar_t< decltype( f() ) > >()( f );
     }
     /** @} */
 }
@@ -5,61 +5,86 @@
 
 #include <cmath>
 #include "fung/util/chainer.hh"
+#include "fung/util/evaluation_order.hh"
 #include "fung/util/static_checks.hh"
+#include "fung/util/type_traits.hh"
 
 namespace FunG
 {
-    /*!
-      @ingroup CMathGroup
+    namespace CMath
+    {
+        /*!
+          @ingroup CMathGroup
 
-      @brief Sine function including first three derivatives (based on sin(double) in \<cmath\>).
+          @brief Sine function including first three derivatives (based on sin(double) in
+          \<cmath\>).
 
-      For scalar functions directional derivatives are less interesting. Incorporating this function
-      as building block for more complex functions requires directional derivatives. These occur
-      during applications of the chain rule.
-     */
-    struct Sin : Chainer< Sin >
-    {
-        //! @copydoc Cos::Cos()
-        explicit Sin( double x = 0 )
+          For scalar functions directional derivatives are less interesting. Incorporating this
+          function as building block for more complex functions requires directional derivatives.
+          These occur during applications of the chain rule.
+         */
+        template < class Scalar >
+        struct Sin : Chainer< Sin< Scalar > >
         {
-            update( x );
-        }
+            //! @copydoc CMath::Cos::Cos()
+            explicit Sin( Scalar x = 0 )
+            {
+                update( x );
+            }
 
-        //! @copydoc Cos::update()
-        void update( double x )
-        {
-            sinx = ::sin( x );
-            cosx = ::cos( x );
-        }
+            //! @copydoc CMath::Cos::update()
+            void update( Scalar x )
+            {
+                using std::sin;
+                using std::cos;
+                sinx = sin( x );
+                cosx = cos( x );
+            }
 
-        //! @copydoc Cos::d0()
-        double d0() const noexcept
-        {
-            return sinx;
-        }
+            /// Set point of evaluation. Skips the computation of \f$\cos(x)\f$ if only the
+            /// function value is required.
+            template < int n >
+            void update( Scalar x, EvaluationOrder< n > )
+            {
+                using std::sin;
+                using std::cos;
+                sinx = sin( x );
+                if ( n > 0 )
+                    cosx = cos( x );
+            }
 
-        //! @copydoc Cos::d1()
-        double d1( double dx = 1. ) const
-        {
-            return cosx * dx;
-        }
+            //! @copydoc CMath::Cos::d0()
+            Scalar d0() const noexcept
+            {
+                return sinx;
+            }
 
-        //! @copydoc Cos::d2()
-        double d2( double dx = 1., double dy = 1. ) const
-        {
-            return -sinx * dx * dy;
-        }
+            //! @copydoc CMath::Cos::d1()
+            Scalar d1( Scalar dx = 1. ) const
+            {
+                return cosx * dx;
+            }
 
-        //! @copydoc Cos::d3()
-        double d3( double dx = 1., double dy = 1., double dz = 1. ) const
-        {
-            return -cosx * dx * dy * dz;
-        }
+            //! @copydoc CMath::Cos::d2()
+            Scalar d2( Scalar dx = 1., Scalar dy = 1. ) const
+            {
+                return -sinx * dx * dy;
+            }
+
+            //! @copydoc CMath::Cos::d3()
+            Scalar d3( Scalar dx = 1., Scalar dy = 1., Scalar dz = 1. ) const
+            {
+                return -cosx * dx * dy * dz;
+            }
+
+        private:
+            Scalar sinx = 0, cosx = 1;
+        };
+    }
 
-    private:
-        double sinx = 0, cosx = 1;
-    };
+    /// @ingroup CMathGroup
+    /// Sine function for arguments of type double.
+    using Sin = CMath::Sin< double >;
 
     /*!
       @ingroup CMathGroup
@@ -70,6 +95,6 @@ namespace FunG
     template < class Function, class = std::enable_if_t< Checks::isFunction< Function >() > >
     auto sin( const Function& f )
     {
-        return Sin()( f );
+        return CMath::Sin< cmath_scalar_t< decltype( f() ) > >()( f );
     }
 }
@@ -1,64 +1,89 @@
 #pragma once
 
 #include <fung/util/chainer.hh>
+#include <fung/util/evaluation_order.hh>
 #include <fung/util/static_checks.hh>
+#include <fung/util/type_traits.hh>
 
 #include <cmath>
 
 namespace FunG
 {
-    /** @addtogroup CMathGroup
-     *  @{ */
+    namespace CMath
+    {
+        /** @addtogroup CMathGroup
+         *  @{ */
 
-    /*!
-      @brief Tangent function including first three derivatives.
+        /*!
+          @brief Tangent function including first three derivatives.
 
-      For scalar functions directional derivatives are less interesting. Incorporating this function
-      as building block for more complex functions requires directional derivatives. These occur
-      during applications of the chain rule.
-     */
-    struct Tan : Chainer< Tan >
-    {
-        //! @copydoc Cos::Cos()
-        explicit Tan( double x = 0. )
+          For scalar functions directional derivatives are less interesting. Incorporating this
+          function as building block for more complex functions requires directional derivatives.
+          These occur during applications of the chain rule.
+         */
+        template < class Scalar >
+        struct Tan : Chainer< Tan< Scalar > >
         {
-            update( x );
-        }
+            //! @copydoc CMath::Cos::Cos()
+            explicit Tan( Scalar x = 0. )
+            {
+                update( x );
+            }
 
-        //! @copydoc Cos::update()
-        void update( double x )
-        {
-            value = ::tan( x );
-            firstDerivative = 1 + ( value * value );
-        }
+            //! @copydoc CMath::Cos::update()
+            void update( Scalar x )
+            {
+                using std::tan;
+                value = tan( x );
+                firstDerivative = 1 + ( value * value );
+            }
 
-        //! @copydoc Cos::d0()
-        double d0() const noexcept
-        {
-            return value;
-        }
+            /// Set point of evaluation. Skips the computation of the first derivative if only the
+            /// function value is required.
+            template < int n >
+            void update( Scalar x, EvaluationOrder< n > )
+            {
+                using std::tan;
+                value = tan( x );
+                if ( n > 0 )
+                    firstDerivative = 1 + ( value * value );
+            }
 
-        //! @copydoc Cos::d1()
-        double d1( double dx = 1. ) const
-        {
-            return firstDerivative * dx;
-        }
+            //! @copydoc CMath::Cos::d0()
+            Scalar d0() const noexcept
+            {
+                return value;
+            }
 
-        //! @copydoc Cos::d2()
-        double d2( double dx = 1., double dy = 1. ) const
-        {
-            return ( 2 * value * firstDerivative ) * dx * dy;
-        }
+            //! @copydoc CMath::Cos::d1()
+            Scalar d1( Scalar dx = 1. ) const
+            {
+                return firstDerivative * dx;
+            }
 
-        //! @copydoc Cos::d3()
-        double d3( double dx = 1., double dy = 1., double dz = 1. ) const
-        {
-            return 2 * firstDerivative * ( 1 + ( 3 * value * value ) ) * dx * dy * dz;
-        }
+            //! @copydoc CMath::Cos::d2()
+            Scalar d2( Scalar dx = 1., Scalar dy = 1. ) const
+            {
+                return ( 2 * value * firstDerivative ) * dx * dy;
+            }
+
+            //! @copydoc CMath::Cos::d3()
+            Scalar d3( Scalar dx = 1., Scalar dy = 1., Scalar dz = 1. ) const
+            {
+                return 2 * firstDerivative * ( 1 + ( 3 * value * value ) ) * dx * dy * dz;
+            }
+
+        private:
+            Scalar value = 0., firstDerivative = 1.;
+        };
+        /** @} */
+    }
+
+    /** @addtogroup CMathGroup
+     *  @{ */
 
-    private:
-        double value = 0., firstDerivative = 1.;
-    };
+    /// Tangent function for arguments of type double.
+    using Tan = CMath::Tan< double >;
 
     /*!
       @brief Generate \f$ \tan\circ f \f$.
@@ -68,7 +93,7 @@ namespace FunG
     template < class Function, class = std::enable_if_t< Checks::isFunction< Function >() > >
     auto tan( const Function& f )
     {
-        return Tan()( f );
+        return CMath::Tan< cmath_scalar_t< decltype( f() ) > >()( f );
     }
     /** @} */
 }
@@ -21,7 +21,7 @@ namespace FunG
     auto incompressibleSkin_HendriksImpl(double c0, double c1, const Matrix& F)
     {
       using namespace LinearAlgebra;
-      auto S = strainTensor(F);
+      auto S = symmetricStrainTensor(F);
       auto si1 = i1(S()) - n;
       auto si2 = i2(S()) - n;
       auto f = c0*si1 + c1*si1*si2;
@@ -10,13 +10,13 @@ namespace FunG
     \brief Weak model for nonlinear heat transfer \f$ (c+du^2)\nabla u \f$.
     \param c weighing of linearity
     \param d weighing of nonlinearity
-    \param u heat
-    \param du heat gradient
+    \param u heat, variable with id 0
+    \param du heat gradient, variable with id 1
    */
   template <class Scalar, class Vector>
   auto heatModel(double c, double d, Scalar u, const Vector& du)
   {
-    auto f = (c+d*squared(variable<0>(u)))*variable<0>(du);
+    auto f = (c+d*squared(variable<0>(u)))*variable<1>(du);
     return finalize( f );
   }
 }
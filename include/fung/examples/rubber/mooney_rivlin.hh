@@ -12,6 +12,7 @@
 #include "fung/linear_algebra/strain_tensor.hh"
 #include "fung/linear_algebra/unit_matrix.hh"
 #include "fung/linear_algebra/principal_invariants.hh"
+#include "fung/examples/volumetric_penalty_functions.hh"
 
 /**
   \ingroup Rubber
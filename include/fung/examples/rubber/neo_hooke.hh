@@ -27,7 +27,7 @@ namespace FunG
   auto incompressibleNeoHooke(double c, const Matrix& F)
   {
     using namespace LinearAlgebra;
-    return finalize( c*(i1(strainTensor(F)) - n) );
+    return finalize( c*(i1(symmetricStrainTensor(F)) - n) );
   }
 
   /**
@@ -51,7 +51,7 @@ namespace FunG
   auto compressibleNeoHooke(double c, double d0, double d1, const Matrix& F)
   {
     using namespace LinearAlgebra;
-    return finalize( c*(i1(strainTensor(F)) - n) + volumetricPenalty<InflationPenalty,CompressionPenalty>(d0,d1,F) );
+    return finalize( c*(i1(symmetricStrainTensor(F)) - n) + volumetricPenalty<InflationPenalty,CompressionPenalty>(d0,d1,F) );
   }
 
   /**
@@ -11,13 +11,12 @@
 namespace FunG
 {
   /// Yield surface \f$ \frac{\beta}{3}\iota_1(\sigma) + J_2(\sigma)-offset \f$, where \f$\iota_1\f$ is the first principal and \f$J_2\f$ is the second deviatoric invariant.  
-  template <class Matrix>
-  auto yieldSurface(double beta, double offset, Matrix sigma = LinearAlgebra::unitMatrix<Matrix>())
+  template <class Matrix, int n = LinearAlgebra::dim<Matrix>()>
+  auto yieldSurface(double beta, double offset, const Matrix& sigma = LinearAlgebra::unitMatrix<Matrix>())
   {
-    auto i1 = LinearAlgebra::FirstPrincipalInvariant<Matrix>( sigma );
-    auto j2 = LinearAlgebra::SecondDeviatoricInvariant<Matrix>( sigma );
-    auto f = (beta/LinearAlgebra::dimension<Matrix>())*i1 + j2 - offset;
-    return finalize_scalar( f );
+    using namespace LinearAlgebra;
+    auto f = (beta/n)*i1(sigma) + j2(sigma) - offset;
+    return finalize( f );
   }
 }
 
@@ -1,14 +1,20 @@
 #pragma once
 
+#include <fung/linear_algebra/rows_and_cols.hh>
 #include <fung/util/derivative_wrappers.hh>
+#include <fung/util/fused_derivatives.hh>
 #include <fung/util/indexed_type.hh>
 #include <fung/util/macros.hh>
+#include <fung/util/packed_storage.hh>
 #include <fung/util/static_checks.hh>
 #include <fung/util/type_traits.hh>
+#include <fung/util/unit_directions.hh>
 #include <fung/util/zero.hh>
 #include <fung/variable.hh>
 
+#include <array>
 #include <string>
+#include <tuple>
 #include <type_traits>
 
 namespace FunG
@@ -16,13 +22,27 @@ namespace FunG
     /// @cond
     namespace Detail
     {
-        template < class ReturnType >
+        /// Absent derivatives are filled in with a reference to a shared zero (see cachedZero),
+        /// whereas present derivatives are returned by value (see finalize()).
+        template < class ReturnType, bool = Checks::isConstantSize< ReturnType >() ||
+                                            is_arithmetic< ReturnType >::value >
         struct FillDefault
         {
             template < class... Args >
-            FUNG_ALWAYS_INLINE ReturnType operator()( const Args&... ) const
+            FUNG_ALWAYS_INLINE const ReturnType& operator()( const Args&... ) const
+            {
+                return cachedZero< ReturnType >();
+            }
+        };
+
+        template < class ReturnType >
+        struct FillDefault< ReturnType, false >
+        {
+            template < class F, class... Args >
+            FUNG_ALWAYS_INLINE const ReturnType& operator()( const F& f, const Args&... ) const
             {
-                return zero< ReturnType >();
+                return cachedZero< ReturnType >( LinearAlgebra::rows( f() ),
+                                                 LinearAlgebra::cols( f() ) );
             }
         };
 
@@ -75,6 +95,19 @@ namespace FunG
             }
         };
 
+        /// Value of the derivative x, zero if it is not present.
+        template < class ReturnType, class X, std::enable_if_t< X::present >* = nullptr >
+        ReturnType valueOrZero( const X& x )
+        {
+            return x();
+        }
+
+        template < class ReturnType, class X, std::enable_if_t< !X::present >* = nullptr >
+        ReturnType valueOrZero( const X& )
+        {
+            return cachedZero< ReturnType >();
+        }
+
         template < typename Assertion >
         struct AssertValue
         {
@@ -82,6 +115,77 @@ namespace FunG
             static bool const value = Assertion::value;
         };
 
+        /// First and, if withD2 is true, second derivatives of f with respect to the variable with
+        /// index id in all unit directions of Arg, computed in one traversal (see D1D2Set).
+        template < class Arg, int id, bool withD2, class F >
+        auto derivativesInBasisDirections( const F& f )
+        {
+            static const auto e = basisDirections< Arg >();
+            using Direction = typename std::decay_t< decltype( e ) >::value_type;
+            return D1D2Set< F, IndexedType< Direction, id >, Components< Arg >::value, withD2 >(
+                f, e );
+        }
+
+        /// Assemble the gradient from the first derivatives in all unit directions.
+        template < class Arg, class ReturnType, class Set >
+        Arg assembleGradient( const Set& d )
+        {
+            auto g = zero< Arg >();
+            for ( int k = 0; k < Components< Arg >::value; ++k )
+                Components< Arg >::entry( g, k ) = valueOrZero< ReturnType >( d.d1[ k ] );
+            return g;
+        }
+
+        /// Assemble the symmetric hessian from the second derivatives in all pairs of unit
+        /// directions \f$(e_k,e_l)\f$ with \f$k\leq l\f$.
+        template < class Arg, class ReturnType, class Set >
+        std::array< Arg, Components< Arg >::value > assembleHessian( const Set& d )
+        {
+            constexpr int m = Components< Arg >::value;
+            std::array< Arg, m > H;
+            for ( auto& h : H )
+                h = zero< Arg >();
+
+            for ( int k = 0; k < m; ++k )
+                for ( int l = k; l < m; ++l )
+                {
+                    Components< Arg >::entry( H[ k ], l ) =
+                        valueOrZero< ReturnType >( d.d2[ packedIndex( k, l, m ) ] );
+                    if ( l != k )
+                        Components< Arg >::entry( H[ l ], k ) =
+                            Components< Arg >::entry( H[ k ], l );
+                }
+            return H;
+        }
+
+        /// Assemble the hessian with respect to different variables from the second directional
+        /// derivatives in all pairs of unit directions, evaluated separately.
+        template < class ArgX, class ArgY, class D2 >
+        std::array< ArgY, Components< ArgX >::value > assembleMixedHessian( const D2& d2 )
+        {
+            static const auto ex = basisDirections< ArgX >();
+            static const auto ey = basisDirections< ArgY >();
+            std::array< ArgY, Components< ArgX >::value > H;
+            for ( auto& h : H )
+                h = zero< ArgY >();
+
+            for ( int k = 0; k < Components< ArgX >::value; ++k )
+                for ( int l = 0; l < Components< ArgY >::value; ++l )
+                    Components< ArgY >::entry( H[ k ], l ) = d2( ex[ k ], ey[ l ] );
+            return H;
+        }
+
+        /// Assemble the upper triangle of a symmetric hessian in packed storage (see packedIndex).
+        template < class Arg, class ReturnType, class Set >
+        std::array< ReturnType, packedSize( Components< Arg >::value ) >
+        assemblePackedHessian( const Set& d )
+        {
+            std::array< ReturnType, packedSize( Components< Arg >::value ) > H;
+            for ( auto i = 0u; i < H.size(); ++i )
+                H[ i ] = valueOrZero< ReturnType >( d.d2[ i ] );
+            return H;
+        }
+
         /// Finish function definition. The task of this class is to add undefined higher order
         /// derivatives if undefined.
         template < class F, bool hasVariables >
@@ -100,8 +204,9 @@ namespace FunG
             }
 
             template < int id, class Arg >
-            ReturnType d1( const Arg& dx ) const
+            decltype( auto ) d1( const Arg& dx ) const
             {
+#ifndef FUNG_DISABLE_STATIC_CHECKS
                 static_assert( Checks::Has::variableId< F, id >(),
                                "You are trying to compute the first derivative with respect to a "
                                "variable that is not present" );
@@ -109,6 +214,7 @@ namespace FunG
                                "Incompatible argument in computation of first derivative." );
                 static_assert( Checks::Has::consistentFirstDerivative< F >(),
                                "Inconsistent functional definition encountered." );
+#endif
 
                 return FinalizeD1< id, ReturnType,
                                    Checks::Has::MemFn::d1< F, IndexedType< Arg, id > >::value >()(
@@ -116,9 +222,10 @@ namespace FunG
             }
 
             template < int id >
-            ReturnType d1() const
+            decltype( auto ) d1() const
             {
                 using Arg = Variable_t< F, id >;
+#ifndef FUNG_DISABLE_STATIC_CHECKS
                 static_assert( Checks::Has::variableId< F, id >(),
                                "You are trying to compute the first derivative with respect to a "
                                "variable that is not present" );
@@ -127,6 +234,7 @@ namespace FunG
                                                             "derivative is computed (d1)." );
                 static_assert( Checks::Has::consistentFirstDerivative< F >(),
                                "Inconsistent functional definition encountered." );
+#endif
 
                 return FinalizeD1< id, ReturnType,
                                    Checks::Has::MemFn::d1< F, IndexedType< Arg, id > >::value >()(
@@ -134,8 +242,9 @@ namespace FunG
             }
 
             template < int idx, int idy, class ArgX, class ArgY >
-            ReturnType d2( const ArgX& dx, const ArgY& dy ) const
+            decltype( auto ) d2( const ArgX& dx, const ArgY& dy ) const
             {
+#ifndef FUNG_DISABLE_STATIC_CHECKS
                 static_assert( Checks::Has::variableId< F, idx >() &&
                                    Checks::Has::variableId< F, idy >(),
                                "You are trying to compute the second derivative with respect to at "
@@ -149,6 +258,7 @@ namespace FunG
                     Checks::Has::consistentSecondDerivative< F, IndexedType< ArgX, idx >,
                                                              IndexedType< ArgY, idy > >(),
                     "Inconsistent functional definition encountered." );
+#endif
 
                 return FinalizeD2< idx, idy, ReturnType,
                                    Checks::Has::MemFn::d2< F, IndexedType< ArgX, idx >,
@@ -157,11 +267,12 @@ namespace FunG
             }
 
             template < int idx, int idy >
-            ReturnType d2() const
+            decltype( auto ) d2() const
             {
                 using ArgX = Variable_t< F, idx >;
                 using ArgY = Variable_t< F, idy >;
 
+#ifndef FUNG_DISABLE_STATIC_CHECKS
                 static_assert( Checks::Has::variableId< F, idx >() &&
                                    Checks::Has::variableId< F, idy >(),
                                "You are trying to compute the second derivative with respect to at "
@@ -176,6 +287,7 @@ namespace FunG
                     Checks::Has::consistentSecondDerivative< F, IndexedType< ArgX, idx >,
                                                              IndexedType< ArgY, idy > >(),
                     "Inconsistent functional definition encountered." );
+#endif
 
                 return FinalizeD2< idx, idy, ReturnType,
                                    Checks::Has::MemFn::d2< F, IndexedType< ArgX, idx >,
@@ -184,8 +296,9 @@ namespace FunG
             }
 
             template < int idx, int idy, int idz, class ArgX, class ArgY, class ArgZ >
-            ReturnType d3( const ArgX& dx, const ArgY& dy, const ArgZ& dz ) const
+            decltype( auto ) d3( const ArgX& dx, const ArgY& dy, const ArgZ& dz ) const
             {
+#ifndef FUNG_DISABLE_STATIC_CHECKS
                 static_assert( Checks::Has::variableId< F, idx >() &&
                                    Checks::Has::variableId< F, idy >() &&
                                    Checks::Has::variableId< F, idz >(),
@@ -201,6 +314,7 @@ namespace FunG
                                                                        IndexedType< ArgY, idy >,
                                                                        IndexedType< ArgZ, idz > >(),
                                "Inconsistent functional definition encountered." );
+#endif
 
                 return FinalizeD3<
                     idx, idy, idz, ReturnType,
@@ -210,12 +324,13 @@ namespace FunG
             }
 
             template < int idx, int idy, int idz >
-            ReturnType d3() const
+            decltype( auto ) d3() const
             {
                 using ArgX = Variable_t< F, idx >;
                 using ArgY = Variable_t< F, idy >;
                 using ArgZ = Variable_t< F, idz >;
 
+#ifndef FUNG_DISABLE_STATIC_CHECKS
                 static_assert( Checks::Has::variableId< F, idx >() &&
                                    Checks::Has::variableId< F, idy >() &&
                                    Checks::Has::variableId< F, idz >(),
@@ -234,6 +349,7 @@ namespace FunG
                                                                        IndexedType< ArgY, idy >,
                                                                        IndexedType< ArgZ, idz > >(),
                                "Inconsistent functional definition encountered." );
+#endif
 
                 return FinalizeD3<
                     idx, idy, idz, ReturnType,
@@ -241,6 +357,138 @@ namespace FunG
                                             IndexedType< ArgZ, idz > >::value >()(
                     static_cast< const F& >( *this ), ArgX( 1 ), ArgY( 1 ), ArgZ( 1 ) );
             }
+
+            /**
+             * @brief First and second derivative, computed in one traversal.
+             *
+             * Equivalent to calling d1< idx >( dx ) and d2< idx, idy >( dx, dy ), but derivatives
+             * of subexpressions that are required for both are computed only once (see D1D2).
+             *
+             * @return std::tuple( d1< idx >( dx ), d2< idx, idy >( dx, dy ) )
+             */
+            template < int idx, int idy, class ArgX, class ArgY >
+            std::tuple< ReturnType, ReturnType > derivatives( const ArgX& dx, const ArgY& dy ) const
+            {
+#ifndef FUNG_DISABLE_STATIC_CHECKS
+                static_assert( Checks::Has::variableId< F, idx >() &&
+                                   Checks::Has::variableId< F, idy >(),
+                               "You are trying to compute the second derivative with respect to at "
+                               "least one variable that is not present" );
+                static_assert( AssertValue< Checks::CheckArgument< F, ArgX, idx > >::value,
+                               "Incompatible first argument in computation of second derivative." );
+                static_assert(
+                    AssertValue< Checks::CheckArgument< F, ArgY, idy > >::value,
+                    "Incompatible second argument in computation of second derivative." );
+#endif
+
+                const D1D2< F, IndexedType< ArgX, idx >, IndexedType< ArgY, idy >, false > d(
+                    *this, dx, dy );
+                return std::make_tuple( valueOrZero< ReturnType >( d.d1x ),
+                                        valueOrZero< ReturnType >( d.d2xy ) );
+            }
+
+            /**
+             * @brief Update variable with index id and compute value, first and second derivative
+             * in one traversal.
+             *
+             * Typical usage in Newton's method:
+             * @code
+             * double value, d1, d2;
+             * std::tie( value, d1, d2 ) = f.update_and_derivatives< 0 >( x, dx, dy );
+             * @endcode
+             *
+             * @return std::tuple( f(), d1< id >( dx ), d2< id, id >( dx, dy ) )
+             */
+            template < int id, class Arg, class ArgX, class ArgY >
+            std::tuple< ReturnType, ReturnType, ReturnType >
+            update_and_derivatives( const Arg& x, const ArgX& dx, const ArgY& dy )
+            {
+                F::template update< id >( x );
+                const auto d = derivatives< id, id >( dx, dy );
+                return std::make_tuple( ReturnType( F::operator()() ), std::get< 0 >( d ),
+                                        std::get< 1 >( d ) );
+            }
+
+            /**
+             * @brief Gradient with respect to the variable with index id.
+             *
+             * All first directional derivatives are computed in one traversal of the function (see
+             * D1D2Set). For matrix-valued variables the (i,j)-th entry is the derivative in
+             * direction of the matrix whose only non-zero entry is a one at position (i,j).
+             *
+             * @return gradient, of the same type as the variable
+             */
+            template < int id >
+            auto gradient() const
+            {
+                using Arg = Variable_t< F, id >;
+                static_assert( is_arithmetic< ReturnType >::value,
+                               "Gradients are only available for scalar-valued functions." );
+
+                return assembleGradient< Arg, ReturnType >(
+                    derivativesInBasisDirections< Arg, id, false >(
+                        static_cast< const F& >( *this ) ) );
+            }
+
+            /**
+             * @brief Hessian with respect to the variables with indices idx and idy.
+             *
+             * Entry k is the gradient with respect to the variable with index idy of the first
+             * derivative in the k-th unit direction of the variable with index idx (see
+             * gradient()). If idx == idy, then the upper triangle is computed in one traversal of
+             * the function (see D1D2Set). Else each entry is computed separately.
+             *
+             * @return std::array of gradients
+             */
+            template < int idx, int idy >
+            auto hessian() const
+            {
+                static_assert( is_arithmetic< ReturnType >::value,
+                               "Hessians are only available for scalar-valued functions." );
+
+                return hessian< idx, idy >( std::integral_constant< bool, idx == idy >() );
+            }
+
+            /**
+             * @brief Symmetric hessian with respect to the variable with index id in packed storage.
+             *
+             * Only the upper triangle, i.e. the second derivatives in the k-th and l-th unit
+             * direction for \f$k\leq l\f$, is computed, in one traversal of the function (see
+             * D1D2Set). Use packedIndex() to access entries.
+             *
+             * @return std::array of size packedSize(m), m being the number of components of the
+             * variable
+             */
+            template < int id >
+            auto packedHessian() const
+            {
+                using Arg = Variable_t< F, id >;
+                static_assert( is_arithmetic< ReturnType >::value,
+                               "Hessians are only available for scalar-valued functions." );
+
+                return assemblePackedHessian< Arg, ReturnType >(
+                    derivativesInBasisDirections< Arg, id, true >(
+                        static_cast< const F& >( *this ) ) );
+            }
+
+        private:
+            template < int idx, int idy >
+            auto hessian( std::true_type ) const
+            {
+                using Arg = Variable_t< F, idx >;
+                return assembleHessian< Arg, ReturnType >(
+                    derivativesInBasisDirections< Arg, idx, true >(
+                        static_cast< const F& >( *this ) ) );
+            }
+
+            template < int idx, int idy >
+            auto hessian( std::false_type ) const
+            {
+                return assembleMixedHessian< Variable_t< F, idx >, Variable_t< F, idy > >(
+                    [this]( const auto& dx, const auto& dy ) {
+                        return this->template d2< idx, idy >( dx, dy );
+                    } );
+            }
         };
 
         template < class F >
@@ -266,21 +514,27 @@ namespace FunG
             }
 
             template < class Arg >
-            ReturnType d1( const Arg& dx ) const
+            decltype( auto ) d1( const Arg& dx ) const
             {
+#ifndef FUNG_DISABLE_STATIC_CHECKS
                 static_assert( Checks::Has::consistentFirstDerivative< F >(),
                                "Inconsistent functional definition encountered." );
+#endif
+
                 return FinalizeD1< 0, ReturnType,
                                    Checks::Has::MemFn::d1< F, IndexedType< Arg, 0 > >::value >()(
                     static_cast< const F& >( *this ), dx );
             }
 
             template < class ArgX, class ArgY >
-            ReturnType d2( const ArgX& dx, const ArgY& dy ) const
+            decltype( auto ) d2( const ArgX& dx, const ArgY& dy ) const
             {
+#ifndef FUNG_DISABLE_STATIC_CHECKS
                 static_assert( Checks::Has::consistentSecondDerivative< F, IndexedType< ArgX, 0 >,
                                                                         IndexedType< ArgY, 0 > >(),
                                "Inconsistent functional definition encountered." );
+#endif
+
                 return FinalizeD2< 0, 0, ReturnType,
                                    Checks::Has::MemFn::d2< F, IndexedType< ArgX, 0 >,
                                                            IndexedType< ArgY, 0 > >::value >()(
@@ -288,12 +542,15 @@ namespace FunG
             }
 
             template < class ArgX, class ArgY, class ArgZ >
-            ReturnType d3( const ArgX& dx, const ArgY& dy, const ArgZ& dz ) const
+            decltype( auto ) d3( const ArgX& dx, const ArgY& dy, const ArgZ& dz ) const
             {
+#ifndef FUNG_DISABLE_STATIC_CHECKS
                 static_assert( Checks::Has::consistentThirdDerivative< F, IndexedType< ArgX, 0 >,
                                                                        IndexedType< ArgY, 0 >,
                                                                        IndexedType< ArgZ, 0 > >(),
                                "Inconsistent functional definition encountered." );
+#endif
+
                 return FinalizeD3<
                     0, 0, 0, ReturnType,
                     Checks::Has::MemFn::d3< F, IndexedType< ArgX, 0 >, IndexedType< ArgY, 0 >,
@@ -301,6 +558,117 @@ namespace FunG
                     static_cast< const F& >( *this ), dx, dy, dz );
             }
 
+            /**
+             * @brief First and second derivative, computed in one traversal.
+             *
+             * Equivalent to calling d1( dx ) and d2( dx, dy ), but derivatives of subexpressions
+             * that are required for both are computed only once (see D1D2).
+             *
+             * @return std::tuple( d1( dx ), d2( dx, dy ) )
+             */
+            template < class ArgX, class ArgY >
+            std::tuple< ReturnType, ReturnType > derivatives( const ArgX& dx, const ArgY& dy ) const
+            {
+                const D1D2< F, IndexedType< ArgX, 0 >, IndexedType< ArgY, 0 >, false > d( *this,
+                                                                                         dx, dy );
+                return std::make_tuple( valueOrZero< ReturnType >( d.d1x ),
+                                        valueOrZero< ReturnType >( d.d2xy ) );
+            }
+
+            /**
+             * @brief Update point of evaluation and compute value and first derivative.
+             * @return std::tuple( f(), d1( dx ) )
+             */
+            template < class Arg, class ArgX >
+            std::tuple< ReturnType, ReturnType > update_and_derivatives( const Arg& x,
+                                                                         const ArgX& dx )
+            {
+                F::update( x );
+                return std::make_tuple( ReturnType( F::operator()() ), d1( dx ) );
+            }
+
+            /**
+             * @brief Update point of evaluation and compute value, first and second derivative in
+             * one traversal.
+             *
+             * Typical usage in Newton's method:
+             * @code
+             * double value, d1, d2;
+             * std::tie( value, d1, d2 ) = f.update_and_derivatives( x, dx, dy );
+             * @endcode
+             *
+             * @return std::tuple( f(), d1( dx ), d2( dx, dy ) )
+             */
+            template < class Arg, class ArgX, class ArgY >
+            std::tuple< ReturnType, ReturnType, ReturnType >
+            update_and_derivatives( const Arg& x, const ArgX& dx, const ArgY& dy )
+            {
+                F::update( x );
+                const auto d = derivatives( dx, dy );
+                return std::make_tuple( ReturnType( F::operator()() ), std::get< 0 >( d ),
+                                        std::get< 1 >( d ) );
+            }
+
+            /**
+             * @brief Gradient with respect to arguments of type Arg.
+             *
+             * All first directional derivatives are computed in one traversal of the function (see
+             * D1D2Set). For matrix-valued arguments the (i,j)-th entry is the derivative in
+             * direction of the matrix whose only non-zero entry is a one at position (i,j).
+             *
+             * @return gradient, of type Arg
+             */
+            template < class Arg >
+            Arg gradient() const
+            {
+                static_assert( is_arithmetic< ReturnType >::value,
+                               "Gradients are only available for scalar-valued functions." );
+
+                return assembleGradient< Arg, ReturnType >(
+                    derivativesInBasisDirections< Arg, 0, false >(
+                        static_cast< const F& >( *this ) ) );
+            }
+
+            /**
+             * @brief Hessian with respect to arguments of type Arg.
+             *
+             * Entry k is the gradient of the first derivative in the k-th unit direction (see
+             * gradient()). The upper triangle is computed in one traversal of the function (see
+             * D1D2Set).
+             *
+             * @return std::array of gradients
+             */
+            template < class Arg >
+            auto hessian() const
+            {
+                static_assert( is_arithmetic< ReturnType >::value,
+                               "Hessians are only available for scalar-valued functions." );
+
+                return assembleHessian< Arg, ReturnType >(
+                    derivativesInBasisDirections< Arg, 0, true >(
+                        static_cast< const F& >( *this ) ) );
+            }
+
+            /**
+             * @brief Symmetric hessian with respect to arguments of type Arg in packed storage.
+             *
+             * Only the upper triangle, i.e. the second derivatives in the k-th and l-th unit
+             * direction for \f$k\leq l\f$, is computed, in one traversal of the function (see
+             * D1D2Set). Use packedIndex() to access entries.
+             *
+             * @return std::array of size packedSize(m), m being the number of components of Arg
+             */
+            template < class Arg >
+            auto packedHessian() const
+            {
+                static_assert( is_arithmetic< ReturnType >::value,
+                               "Hessians are only available for scalar-valued functions." );
+
+                return assemblePackedHessian< Arg, ReturnType >(
+                    derivativesInBasisDirections< Arg, 0, true >(
+                        static_cast< const F& >( *this ) ) );
+            }
+
             std::string print_d0() const
             {
                 return F::print_d0();
@@ -309,8 +677,11 @@ namespace FunG
             template < class Arg >
             std::string print_d1( const std::string& dx ) const
             {
+#ifndef FUNG_DISABLE_STATIC_CHECKS
                 static_assert( Checks::Has::consistentFirstDerivative< F >(),
                                "Inconsistent functional definition encountered." );
+#endif
+
                 return FinalizeD1< 0, ReturnType,
                                    Checks::Has::MemFn::d1< F, IndexedType< Arg, 0 > >::value >()
                     .template print< Arg >( static_cast< const F& >( *this ), dx );
@@ -325,6 +696,23 @@ namespace FunG
      * Adds the definition of possibly undefined vanishing higher order derivatives.
      * If the template class Variable is not used, then no ids must be provided for the
      * update-function and derivatives.
+     *
+     * The derivatives check at compile time that the variables are present, that the arguments
+     * have the types of the variables and that the lower order derivatives are consistent. The
+     * latter instantiates all lower order derivatives. Define FUNG_DISABLE_STATIC_CHECKS to skip
+     * these checks and reduce compile times, e.g. for release builds of code that already compiles
+     * with the checks.
+     *
+     * Derivatives that are present are returned by value. Derivatives that vanish structurally
+     * return a const reference to a shared zero (see cachedZero), such that filling them in
+     * neither computes nor allocates anything. Thus d1, d2 and d3 return either ReturnType or
+     * const ReturnType&. Both bind to auto and const auto&, only decltype(auto) tells them apart.
+     *
+     * After a first evaluation for warm-up, evaluation does not allocate memory if all matrices
+     * have constant size or dynamic size with bounded capacity, such as
+     * Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,0,3,3>. This guarantee does not cover
+     * matrices of unbounded dynamic size, such as Eigen::MatrixXd, whose intermediate results are
+     * allocated on the heap in update and in the computation of derivatives.
      */
     template < class F >
     auto finalize( F&& f )
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "batch.hh"
 #include "concept_check.hh"
 #include "constant.hh"
 #include "finalize.hh"
@@ -8,5 +9,7 @@
 #include "linear_algebra.hh"
 #include "math.hh"
 #include "operations.hh"
+#include "parallel_batch.hh"
+#include "stateless.hh"
 #include "util/add_missing_operators.hh"
 #include "variable.hh"
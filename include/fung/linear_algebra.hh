@@ -4,15 +4,18 @@
 #ifndef FUNG_LINEAR_ALGEBRA_HH
 #define FUNG_LINEAR_ALGEBRA_HH
 
+#include "fung/linear_algebra/basis_direction.hh"
 #include "fung/linear_algebra/determinant.hh"
 #include "fung/linear_algebra/deviator.hh"
 #include "fung/linear_algebra/deviatoric_invariants.hh"
 #include "fung/linear_algebra/dimension.hh"
+#include "fung/linear_algebra/isochoric_invariants.hh"
 #include "fung/linear_algebra/principal_invariants.hh"
 #include "fung/linear_algebra/mixed_invariants.hh"
 
 #include "fung/linear_algebra/frobenius_norm.hh"
 #include "fung/linear_algebra/strain_tensor.hh"
+#include "fung/linear_algebra/symmetric_matrix.hh"
 #include "fung/linear_algebra/tensor_product.hh"
 #include "fung/linear_algebra/trace.hh"
 #include "fung/linear_algebra/transpose.hh"
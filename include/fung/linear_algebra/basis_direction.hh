@@ -0,0 +1,141 @@
+#pragma once
+
+#include "rows_and_cols.hh"
+#include <fung/util/at.hh>
+#include <fung/util/static_checks.hh>
+#include <fung/util/zero.hh>
+
+#include <type_traits>
+
+namespace FunG
+{
+    namespace LinearAlgebra
+    {
+        /**
+         * @ingroup LinearAlgebraGroup
+         *
+         * @brief Basis direction \f$E_{ij}\f$, i.e. the matrix whose only non-zero entry is a one
+         * at position (i,j).
+         *
+         * BasisDirection converts to const Matrix&, thus it can be passed as direction to every
+         * function that accepts directions of type Matrix. Its entries can not be modified, such
+         * that they always agree with rowIndex() and colIndex(). Functions that provide overloads
+         * for BasisDirection, such as the strain tensors, only use the indices i and j and avoid
+         * dense matrix products. Gradients and hessians of finalized functions are assembled from
+         * basis directions.
+         */
+        template < class Matrix >
+        class BasisDirection
+        {
+        public:
+            /// Constructor for matrices of constant size, yields \f$E_{00}\f$.
+            template < class M = Matrix,
+                       std::enable_if_t< Checks::isConstantSize< M >() >* = nullptr >
+            BasisDirection() : BasisDirection( 0, 0 )
+            {
+            }
+
+            /**
+             * @brief Constructor for matrices of constant size.
+             * @param i row of the non-zero entry
+             * @param j column of the non-zero entry
+             */
+            template < class M = Matrix,
+                       std::enable_if_t< Checks::isConstantSize< M >() >* = nullptr >
+            BasisDirection( int i, int j ) : E( zero< Matrix >() ), i_( i ), j_( j )
+            {
+                at( E, i, j ) = 1;
+            }
+
+            /**
+             * @brief Constructor for matrices of dynamic size.
+             * @param i row of the non-zero entry
+             * @param j column of the non-zero entry
+             * @param rows number of rows
+             * @param cols number of columns
+             */
+            template < class M = Matrix,
+                       std::enable_if_t< !Checks::isConstantSize< M >() >* = nullptr >
+            BasisDirection( int i, int j, int rows, int cols )
+                : E( zero< Matrix >( rows, cols ) ), i_( i ), j_( j )
+            {
+                at( E, i, j ) = 1;
+            }
+
+            /// Dense matrix \f$E_{ij}\f$.
+            const Matrix& matrix() const noexcept
+            {
+                return E;
+            }
+
+            /// Dense matrix \f$E_{ij}\f$.
+            operator const Matrix&() const noexcept
+            {
+                return E;
+            }
+
+            /// Row of the non-zero entry.
+            int rowIndex() const noexcept
+            {
+                return i_;
+            }
+
+            /// Column of the non-zero entry.
+            int colIndex() const noexcept
+            {
+                return j_;
+            }
+
+        private:
+            Matrix E;
+            int i_ = 0, j_ = 0;
+        };
+
+        /// Check if Direction is BasisDirection< Matrix > or derived from it.
+        template < class Direction, class Matrix >
+        using IsBasisDirection = std::is_base_of< BasisDirection< Matrix >, Direction >;
+
+        /**
+         * @ingroup LinearAlgebraGroup
+         *
+         * @brief Basis direction \f$E_{ij}\f$ with indices i and j known at compile time.
+         *
+         * Derives from BasisDirection< Matrix >, thus every function that provides overloads for
+         * BasisDirection accepts UnitDirection as well.
+         */
+        template < class Matrix, int i, int j >
+        class UnitDirection : public BasisDirection< Matrix >
+        {
+        public:
+            /// Constructor for matrices of constant size.
+            template < class M = Matrix,
+                       std::enable_if_t< Checks::isConstantSize< M >() >* = nullptr >
+            UnitDirection() : BasisDirection< Matrix >( i, j )
+            {
+            }
+
+            /**
+             * @brief Constructor for matrices of dynamic size.
+             * @param rows number of rows
+             * @param cols number of columns
+             */
+            template < class M = Matrix,
+                       std::enable_if_t< !Checks::isConstantSize< M >() >* = nullptr >
+            UnitDirection( int rows, int cols ) : BasisDirection< Matrix >( i, j, rows, cols )
+            {
+            }
+
+            /// Row of the non-zero entry.
+            static constexpr int rowIndex() noexcept
+            {
+                return i;
+            }
+
+            /// Column of the non-zero entry.
+            static constexpr int colIndex() noexcept
+            {
+                return j;
+            }
+        };
+    }
+}
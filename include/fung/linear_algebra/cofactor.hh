@@ -6,6 +6,8 @@
 
 #include <cassert>
 #include "dimension.hh"
+#include "lu_decomposition.hh"
+#include "symmetric_matrix.hh"
 #include "fung/concept_check.hh"
 #include "fung/util/at.hh"
 #include "fung/util/static_checks.hh"
@@ -57,22 +59,33 @@ namespace FunG
         using Id = Detail::CofactorIndices<row,col>;
         return sign(row,col) * (at(A,Id::firstRow,Id::firstCol)*at(B,Id::lastRow,Id::lastCol) - at(A,Id::firstRow,Id::lastCol)*at(B,Id::lastRow,Id::firstCol));
       }
+
+      /// (row,col)-cofactor of a \f$ n\times n \f$ matrix, \f$ n>3 \f$, computed from the LU decomposition of \f$ A^\#_{ij} \f$.
+      template <int row, int col, class Matrix, int n>
+      auto computeCofactorImpl(Matrix const&, Matrix const& A, std::integral_constant<int,n>)
+      {
+        DenseArray< std::decay_t<decltype(at(A,0,0))> , n-1 > minor;
+        for( int i = 0; i < n-1; ++i )
+          for( int j = 0; j < n-1; ++j )
+            minor[i*(n-1)+j] = at(A, i<row ? i : i+1, j<col ? j : j+1);
+        return sign(row,col) * luDeterminant<n-1>(minor);
+      }
     }
     /// @endcond
 
     /**
-     * @brief Compute the \f$(row,col)\f$-cofactor of \f$ A \f$. Implemented for \f$ A\in \mathbb{R}^{n,n} \f$ with \f$ n=2,3 \f$.
+     * @brief Compute the \f$(row,col)\f$-cofactor of \f$ A \f$. Implemented for \f$ A\in \mathbb{R}^{n,n} \f$ with \f$ n\geq 2 \f$.
      *
      * The \f$(i,j)\f$-cofactor of a matrix \f$ A \f$ is \f$ (-1)^{i+j} \det(A^\#_{ij}) \f$, where
      * \f$ A^\#_ij \f$ is obtained from \f$ A \f$ by deleting the \f$i\f$-th row and \f$ j \f$-th column.
+     * For \f$ n>3 \f$ the determinant of \f$ A^\#_{ij} \f$ is computed from its LU decomposition.
      */
     template < int row , int col , class Matrix ,
                std::enable_if_t<Checks::isConstantSize<Matrix>()>* = nullptr ,
                class = Concepts::MatrixConceptCheck<Matrix> >
     auto computeCofactor(Matrix const& A)
     {
-      static_assert( dim<Matrix>() == 2 || dim<Matrix>() == 3 ,
-                     "Cofactors are currently only implemented for 2x2 and 3x3 matrices. Efficient general implementations are non-trivial and may or may not be implemented in the future." );
+      static_assert( dim<Matrix>() >= 2 , "Cofactors are only implemented for square matrices of dimension n>=2." );
       return Detail::computeCofactorImpl<row,col>(A, A, std::integral_constant<int,dim<Matrix>()>());
     }
 
@@ -92,6 +105,19 @@ namespace FunG
       /*if( rows(A) == 3 )*/ return Detail::computeCofactorImpl<row,col>(A, A, std::integral_constant<int,3>());
     }
 
+    /**
+     * @brief Compute the \f$(row,col)\f$-cofactor of a symmetric matrix \f$ A \f$. Implemented for \f$ A\in \mathbb{R}^{n,n} \f$ with \f$ n=2,3 \f$.
+     *
+     * Cofactors of symmetric matrices are symmetric, thus only the cofactors of the upper triangle are computed.
+     */
+    template < int row , int col , class Scalar , int n >
+    auto computeCofactor(SymmetricMatrix<Scalar,n> const& A)
+    {
+      static_assert( n == 2 || n == 3 ,
+                     "Cofactors are currently only implemented for 2x2 and 3x3 matrices. Efficient general implementations are non-trivial and may or may not be implemented in the future." );
+      return Detail::computeCofactorImpl<(row<col ? row : col),(row<col ? col : row)>(A, A, std::integral_constant<int,n>());
+    }
+
     /**
      * @brief Compute the first directional derivative in direction \f$ B \f$ of the \f$(row,col)\f$-cofactor of \f$ A \f$. Implemented for \f$ A\in \mathbb{R}^{n,n} \f$ with \f$ n=2,3 \f$.
      *
@@ -4,15 +4,22 @@
 #ifndef FUNG_LINEAR_ALGEBRA_DETERMINANT_HH
 #define FUNG_LINEAR_ALGEBRA_DETERMINANT_HH
 
+#include <cassert>
+#include <cmath>
+#include <limits>
 #include <type_traits>
 #include <utility>
 
+#include "basis_direction.hh"
 #include "dimension.hh"
+#include "lu_decomposition.hh"
 #include "rows_and_cols.hh"
+#include "symmetric_matrix.hh"
 #include "fung/util/at.hh"
 #include "fung/util/chainer.hh"
 #include "fung/util/exceptions.hh"
 #include "fung/util/static_checks.hh"
+#include "fung/util/storage.hh"
 #include "fung/util/type_traits.hh"
 #include "fung/util/zero.hh"
 
@@ -52,8 +59,287 @@ namespace FunG
             at(dB,1,0) * ( at(dA,0,2) * at(dC,2,1) + at(dA,2,1) * at(dC,0,2) - at(dA,2,2) * at(dC,0,1) - at(dA,0,1) * at(dC,2,2) );
       }
 
+      /// Determinant and its derivatives at \f$ A\in\mathbb{R}^{n,n} \f$, \f$ n=2,3 \f$, evaluated from the point of evaluation only.
+      template <class Matrix, int n>
+      struct DeterminantFormulas;
+
+      template <class Matrix>
+      struct DeterminantFormulas<Matrix,2>
+      {
+        using Scalar = std::decay_t< decltype(at(std::declval<Matrix>(),0,0)) >;
+
+        static Scalar d0(Matrix const& A)
+        {
+          return at(A,0,0) * at(A,1,1) - at(A,0,1) * at(A,1,0);
+        }
+
+        static Scalar d1(Matrix const& A, Matrix const& dA1)
+        {
+          return composeResult(A,dA1);
+        }
+
+        static Scalar d2(Matrix const&, Matrix const& dA1, Matrix const& dA2)
+        {
+          return composeResult(dA2,dA1);
+        }
+
+        static Scalar d3(Matrix const&, Matrix const&, Matrix const&, Matrix const&)
+        {
+          return Scalar(0);
+        }
+
+        /// Entry \f$(i,j)\f$ of the cofactor matrix, for \f$dA_1=E_{ij}\f$.
+        static Scalar d1(Matrix const& A, BasisDirection<Matrix> const& dA1)
+        {
+          const auto i = dA1.rowIndex(), j = dA1.colIndex();
+          return ( i == j ? 1 : -1 ) * at(A,1-i,1-j);
+        }
+
+        static Scalar d2(Matrix const&, BasisDirection<Matrix> const& dA1, BasisDirection<Matrix> const& dA2)
+        {
+          const auto i = dA1.rowIndex(), j = dA1.colIndex();
+          if( i == dA2.rowIndex() || j == dA2.colIndex() ) return Scalar(0);
+          return Scalar( i == j ? 1 : -1 );
+        }
+      };
+
+      template <class Matrix>
+      struct DeterminantFormulas<Matrix,3>
+      {
+        using Scalar = std::decay_t< decltype(at(std::declval<Matrix>(),0,0)) >;
+
+        static Scalar d0(Matrix const& A)
+        {
+          return composeResult(A,A,A);
+        }
+
+        static Scalar d1(Matrix const& A, Matrix const& dA1)
+        {
+          return composeResult(dA1,A,A) + composeResult(A,dA1,A) + composeResult(A,A,dA1);
+        }
+
+        static Scalar d2(Matrix const& A, Matrix const& dA1, Matrix const& dA2)
+        {
+          return composeSemiSymmetricResult(A,dA2,dA1) + composeSemiSymmetricResult(dA1,A,dA2) + composeSemiSymmetricResult(A,dA1,dA2);
+        }
+
+        static Scalar d3(Matrix const&, Matrix const& dA1, Matrix const& dA2, Matrix const& dA3)
+        {
+          return composeSemiSymmetricResult(dA1,dA2,dA3) + composeSemiSymmetricResult(dA1,dA3,dA2) + composeSemiSymmetricResult(dA2,dA1,dA3);
+        }
+
+        /// Entry \f$(i,j)\f$ of the cofactor matrix, for \f$dA_1=E_{ij}\f$.
+        static Scalar d1(Matrix const& A, BasisDirection<Matrix> const& dA1)
+        {
+          const auto i1 = ( dA1.rowIndex() + 1 ) % 3, i2 = ( dA1.rowIndex() + 2 ) % 3;
+          const auto j1 = ( dA1.colIndex() + 1 ) % 3, j2 = ( dA1.colIndex() + 2 ) % 3;
+          return at(A,i1,j1) * at(A,i2,j2) - at(A,i1,j2) * at(A,i2,j1);
+        }
+
+        static Scalar d2(Matrix const& A, BasisDirection<Matrix> const& dA1, BasisDirection<Matrix> const& dA2)
+        {
+          const auto i = dA1.rowIndex(), j = dA1.colIndex(), k = dA2.rowIndex(), l = dA2.colIndex();
+          if( i == k || j == l ) return Scalar(0);
+          return sign(i,k) * sign(j,l) * at(A,3-i-k,3-j-l);
+        }
+
+        static Scalar d3(Matrix const&, BasisDirection<Matrix> const& dA1, BasisDirection<Matrix> const& dA2, BasisDirection<Matrix> const& dA3)
+        {
+          const auto i = dA1.rowIndex(), j = dA1.colIndex(), k = dA2.rowIndex(), l = dA2.colIndex();
+          if( i == k || j == l || dA3.rowIndex() != 3-i-k || dA3.colIndex() != 3-j-l ) return Scalar(0);
+          return Scalar( sign(i,k) * sign(j,l) );
+        }
+
+      private:
+        /// Sign of the permutation \f$(i,k,3-i-k)\f$ of \f$(0,1,2)\f$, for \f$i\neq k\f$.
+        static constexpr int sign(int i, int k)
+        {
+          return k == ( i + 1 ) % 3 ? 1 : -1;
+        }
+      };
+
+      /**
+       * Determinant of \f$ A\in\mathbb{R}^{n,n} \f$ for constant size \f$ n>3 \f$.
+       *
+       * The value is computed from a LU decomposition with partial pivoting. For regular \f$ A \f$ the derivatives are computed
+       * from the adjugate \f$ \mathrm{adj}(A) = \det(A)A^{-1} \f$, i.e. with \f$ X=A^{-1}dA_1, Y=A^{-1}dA_2, Z=A^{-1}dA_3 \f$:
+       * - \f$ \det'(A)dA_1 = \det(A)\mathrm{tr}(X) \f$,
+       * - \f$ \det''(A)(dA_1,dA_2) = \det(A)(\mathrm{tr}(X)\mathrm{tr}(Y) - \mathrm{tr}(XY)) \f$,
+       * - \f$ \det'''(A)(dA_1,dA_2,dA_3) = \det(A)(\mathrm{tr}(X)\mathrm{tr}(Y)\mathrm{tr}(Z) - \mathrm{tr}(X)\mathrm{tr}(YZ) - \mathrm{tr}(Y)\mathrm{tr}(XZ)
+       *   - \mathrm{tr}(Z)\mathrm{tr}(XY) + \mathrm{tr}(XYZ) + \mathrm{tr}(XZY)) \f$.
+       *
+       * For (nearly) singular \f$ A \f$, i.e. if the ratio of the smallest and largest pivot is below \f$ \sqrt{\epsilon} \f$, the
+       * above formulas suffer from cancellation. Then the derivatives are computed from the multilinearity of the determinant in the
+       * rows of its argument, i.e. as sum of determinants of \f$ A \f$ with one, two or three rows replaced by the corresponding rows
+       * of the directions.
+       */
       template <class Matrix, int dim, class = Concepts::SquareMatrixConceptCheck<Matrix> >
-      class DeterminantImpl;
+      class DeterminantImpl
+          : public Chainer< DeterminantImpl<Matrix,dim,Concepts::SquareMatrixConceptCheck<Matrix> > >
+      {
+        static_assert( dim > 3 , "Determinant is only implemented for square matrices of dimension n>=2." );
+        using Scalar = std::decay_t< decltype(at(std::declval<Matrix>(),0,0)) >;
+        using Array = DenseArray<Scalar,dim>;
+
+      public:
+        DeterminantImpl() = default;
+
+        explicit DeterminantImpl(Matrix const& A_) { update(A_); }
+
+        void update(Matrix const& A_)
+        {
+          A = toDenseArray<dim>(A_);
+          LUDecomposition<Scalar,dim> lu(A);
+          value = lu.det();
+          regular = !lu.singular( std::sqrt( std::numeric_limits<Scalar>::epsilon() ) );
+          if( regular ) invA = lu.inverse();
+        }
+
+        auto d0() const { return value; }
+
+        auto d1(Matrix const& dA1) const
+        {
+          if( !regular )
+          {
+            auto result = Scalar(0);
+            for( int i = 0; i < dim; ++i )
+            {
+              auto B = A;
+              replaceRow<dim>(B,dA1,i);
+              result += luDeterminant<dim>(B);
+            }
+            return result;
+          }
+
+          auto trX = Scalar(0);
+          for( int i = 0; i < dim; ++i )
+            for( int k = 0; k < dim; ++k )
+              trX += invA[i*dim+k] * at(dA1,k,i);
+          return value * trX;
+        }
+
+        auto d2(Matrix const& dA1, Matrix const& dA2) const
+        {
+          if( !regular )
+          {
+            auto result = Scalar(0);
+            for( int i = 0; i < dim; ++i )
+              for( int j = 0; j < dim; ++j )
+              {
+                if( i == j ) continue;
+                auto B = A;
+                replaceRow<dim>(B,dA1,i);
+                replaceRow<dim>(B,dA2,j);
+                result += luDeterminant<dim>(B);
+              }
+            return result;
+          }
+
+          const auto X = multiplyWithInverse(dA1), Y = multiplyWithInverse(dA2);
+          return value * ( trace(X) * trace(Y) - traceOfProduct(X,Y) );
+        }
+
+        auto d3(Matrix const& dA1, Matrix const& dA2, Matrix const& dA3) const
+        {
+          if( !regular )
+          {
+            auto result = Scalar(0);
+            for( int i = 0; i < dim; ++i )
+              for( int j = 0; j < dim; ++j )
+                for( int k = 0; k < dim; ++k )
+                {
+                  if( i == j || i == k || j == k ) continue;
+                  auto B = A;
+                  replaceRow<dim>(B,dA1,i);
+                  replaceRow<dim>(B,dA2,j);
+                  replaceRow<dim>(B,dA3,k);
+                  result += luDeterminant<dim>(B);
+                }
+            return result;
+          }
+
+          const auto X = multiplyWithInverse(dA1), Y = multiplyWithInverse(dA2), Z = multiplyWithInverse(dA3);
+          const auto trX = trace(X), trY = trace(Y), trZ = trace(Z);
+          return value * ( trX * trY * trZ - trX * traceOfProduct(Y,Z) - trY * traceOfProduct(X,Z) - trZ * traceOfProduct(X,Y)
+                           + traceOfProduct(X,Y,Z) + traceOfProduct(X,Z,Y) );
+        }
+
+        /// First directional derivative in direction \f$E_{ij}\f$, i.e. \f$\det(A)(A^{-1})_{ji}\f$ for regular \f$A\f$.
+        auto d1(BasisDirection<Matrix> const& dA1) const
+        {
+          if( !regular ) return d1(static_cast<Matrix const&>(dA1));
+          return value * inv(dA1.colIndex(),dA1.rowIndex());
+        }
+
+        /// Second directional derivative in directions \f$E_{ij}\f$ and \f$E_{kl}\f$.
+        auto d2(BasisDirection<Matrix> const& dA1, BasisDirection<Matrix> const& dA2) const
+        {
+          if( !regular ) return d2(static_cast<Matrix const&>(dA1),static_cast<Matrix const&>(dA2));
+          const auto i = dA1.rowIndex(), j = dA1.colIndex(), k = dA2.rowIndex(), l = dA2.colIndex();
+          return value * ( inv(j,i) * inv(l,k) - inv(l,i) * inv(j,k) );
+        }
+
+        /// Third directional derivative in directions \f$E_{ij}\f$, \f$E_{kl}\f$ and \f$E_{mn}\f$.
+        auto d3(BasisDirection<Matrix> const& dA1, BasisDirection<Matrix> const& dA2, BasisDirection<Matrix> const& dA3) const
+        {
+          if( !regular ) return d3(static_cast<Matrix const&>(dA1),static_cast<Matrix const&>(dA2),static_cast<Matrix const&>(dA3));
+          const auto i = dA1.rowIndex(), j = dA1.colIndex(), k = dA2.rowIndex(), l = dA2.colIndex(), m = dA3.rowIndex(), n = dA3.colIndex();
+          const auto trX = inv(j,i), trY = inv(l,k), trZ = inv(n,m);
+          return value * ( trX * trY * trZ - trX * inv(n,k) * inv(l,m) - trY * inv(n,i) * inv(j,m) - trZ * inv(l,i) * inv(j,k)
+                           + inv(n,i) * inv(j,k) * inv(l,m) + inv(l,i) * inv(j,m) * inv(n,k) );
+        }
+
+      private:
+        Scalar inv(int i, int j) const
+        {
+          return invA[i*dim+j];
+        }
+
+        Array multiplyWithInverse(Matrix const& dA) const
+        {
+          Array X{};
+          for( int i = 0; i < dim; ++i )
+            for( int k = 0; k < dim; ++k )
+              for( int j = 0; j < dim; ++j )
+                X[i*dim+j] += invA[i*dim+k] * at(dA,k,j);
+          return X;
+        }
+
+        static Scalar trace(Array const& X)
+        {
+          auto result = Scalar(0);
+          for( int i = 0; i < dim; ++i )
+            result += X[i*dim+i];
+          return result;
+        }
+
+        static Scalar traceOfProduct(Array const& X, Array const& Y)
+        {
+          auto result = Scalar(0);
+          for( int i = 0; i < dim; ++i )
+            for( int k = 0; k < dim; ++k )
+              result += X[i*dim+k] * Y[k*dim+i];
+          return result;
+        }
+
+        static Scalar traceOfProduct(Array const& X, Array const& Y, Array const& Z)
+        {
+          auto result = Scalar(0);
+          for( int i = 0; i < dim; ++i )
+            for( int k = 0; k < dim; ++k )
+            {
+              auto XY = Scalar(0);
+              for( int l = 0; l < dim; ++l )
+                XY += X[i*dim+l] * Y[l*dim+k];
+              result += XY * Z[k*dim+i];
+            }
+          return result;
+        }
+
+        Array A{}, invA{};
+        Scalar value = 0.;
+        bool regular = false;
+      };
 
       template<class Matrix>
       class DeterminantImpl< Matrix , 2 , Concepts::SquareMatrixConceptCheck<Matrix> >
@@ -66,8 +352,8 @@ namespace FunG
 
         void update(Matrix const& A_)
         {
-          A = A_;
-          value = at(A,0,0) * at(A,1,1) - at(A,0,1) * at(A,1,0);
+          A.store(A_);
+          value = DeterminantFormulas<Matrix,2>::d0(A_);
         }
 
         auto d0() const
@@ -77,16 +363,26 @@ namespace FunG
 
         auto d1(Matrix const& dA1) const
         {
-          return composeResult(A, dA1);
+          return DeterminantFormulas<Matrix,2>::d1(A.get(),dA1);
         }
 
         auto d2(Matrix const& dA1, Matrix const& dA2) const
         {
-          return composeResult(dA2,dA1);
+          return DeterminantFormulas<Matrix,2>::d2(A.get(),dA1,dA2);
+        }
+
+        auto d1(BasisDirection<Matrix> const& dA1) const
+        {
+          return DeterminantFormulas<Matrix,2>::d1(A.get(),dA1);
+        }
+
+        auto d2(BasisDirection<Matrix> const& dA1, BasisDirection<Matrix> const& dA2) const
+        {
+          return DeterminantFormulas<Matrix,2>::d2(A.get(),dA1,dA2);
         }
 
       private:
-        Matrix A;
+        FunG::Detail::Storage<Matrix> A;
         std::decay_t< decltype(at(std::declval<Matrix>(),0,0)) > value = 0.;
       };
 
@@ -101,87 +397,219 @@ namespace FunG
 
         void update(Matrix const& A_)
         {
-          A = A_;
-          value = composeResult(A,A,A);
+          A.store(A_);
+          value = DeterminantFormulas<Matrix,3>::d0(A_);
         }
 
         auto d0() const { return value; }
 
         auto d1(Matrix const& dA1) const
         {
-          return composeResult(dA1,A,A) + composeResult(A,dA1,A) + composeResult(A,A,dA1);
+          return DeterminantFormulas<Matrix,3>::d1(A.get(),dA1);
         }
 
         auto d2(Matrix const& dA1, Matrix const& dA2) const
         {
-          return composeSemiSymmetricResult(A,dA2,dA1) + composeSemiSymmetricResult(dA1,A,dA2) + composeSemiSymmetricResult(A,dA1,dA2);
+          return DeterminantFormulas<Matrix,3>::d2(A.get(),dA1,dA2);
         }
 
         auto d3(Matrix const& dA1, Matrix const& dA2, Matrix const& dA3) const
         {
-          return composeSemiSymmetricResult(dA1,dA2,dA3) + composeSemiSymmetricResult(dA1,dA3,dA2) + composeSemiSymmetricResult(dA2,dA1,dA3);
+          return DeterminantFormulas<Matrix,3>::d3(A.get(),dA1,dA2,dA3);
+        }
+
+        auto d1(BasisDirection<Matrix> const& dA1) const
+        {
+          return DeterminantFormulas<Matrix,3>::d1(A.get(),dA1);
+        }
+
+        auto d2(BasisDirection<Matrix> const& dA1, BasisDirection<Matrix> const& dA2) const
+        {
+          return DeterminantFormulas<Matrix,3>::d2(A.get(),dA1,dA2);
+        }
+
+        auto d3(BasisDirection<Matrix> const& dA1, BasisDirection<Matrix> const& dA2, BasisDirection<Matrix> const& dA3) const
+        {
+          return DeterminantFormulas<Matrix,3>::d3(A.get(),dA1,dA2,dA3);
         }
 
       private:
-        Matrix A;
+        FunG::Detail::Storage<Matrix> A;
         std::decay_t< decltype(at(std::declval<Matrix>(),0,0)) > value = 0.;
       };
+
+      /// Determinant of symmetric 2x2 matrices. Derivatives are computed from the cofactor matrix.
+      template <class Scalar>
+      class DeterminantImpl< SymmetricMatrix<Scalar,2> , 2 , Concepts::SquareMatrixConceptCheck< SymmetricMatrix<Scalar,2> > >
+          : public Chainer< DeterminantImpl< SymmetricMatrix<Scalar,2> , 2 , Concepts::SquareMatrixConceptCheck< SymmetricMatrix<Scalar,2> > > >
+      {
+        using Matrix = SymmetricMatrix<Scalar,2>;
+
+      public:
+        DeterminantImpl() = default;
+
+        explicit DeterminantImpl(Matrix const& A) { update(A); }
+
+        void update(Matrix const& A)
+        {
+          cofA = cofactor(A);
+          value = A(0,0) * A(1,1) - A(0,1) * A(0,1);
+        }
+
+        auto d0() const { return value; }
+
+        auto d1(Matrix const& dA1) const
+        {
+          return scalarProduct(cofA,dA1);
+        }
+
+        auto d2(Matrix const& dA1, Matrix const& dA2) const
+        {
+          return scalarProduct(cofactor(dA1),dA2);
+        }
+
+      private:
+        Matrix cofA;
+        Scalar value = 0.;
+      };
+
+      /// Determinant of symmetric 3x3 matrices. Derivatives are computed from the cofactor matrix and its derivative.
+      template <class Scalar>
+      class DeterminantImpl< SymmetricMatrix<Scalar,3> , 3 , Concepts::SquareMatrixConceptCheck< SymmetricMatrix<Scalar,3> > >
+          : public Chainer< DeterminantImpl< SymmetricMatrix<Scalar,3> , 3 , Concepts::SquareMatrixConceptCheck< SymmetricMatrix<Scalar,3> > > >
+      {
+        using Matrix = SymmetricMatrix<Scalar,3>;
+
+      public:
+        DeterminantImpl() = default;
+
+        explicit DeterminantImpl(Matrix const& A_) { update(A_); }
+
+        void update(Matrix const& A_)
+        {
+          A.store(A_);
+          cofA = cofactor(A_);
+          value = A_(0,0) * cofA(0,0) + A_(0,1) * cofA(0,1) + A_(0,2) * cofA(0,2);
+        }
+
+        auto d0() const { return value; }
+
+        auto d1(Matrix const& dA1) const
+        {
+          return scalarProduct(cofA,dA1);
+        }
+
+        auto d2(Matrix const& dA1, Matrix const& dA2) const
+        {
+          return scalarProduct(cofactorDerivative(A.get(),dA1),dA2);
+        }
+
+        auto d3(Matrix const& dA1, Matrix const& dA2, Matrix const& dA3) const
+        {
+          return scalarProduct(cofactorDerivative(dA1,dA2),dA3);
+        }
+
+      private:
+        FunG::Detail::Storage<Matrix> A;
+        Matrix cofA;
+        Scalar value = 0.;
+      };
     }
 
-    /// Determinant of constant size matrix with first three derivatives.
+    /// Determinant of constant size matrix with first three derivatives. Specialized for \f$n=2,3\f$, LU-based for \f$n>3\f$.
     template <class Matrix>
     using ConstantSizeDeterminant = Detail::DeterminantImpl<Matrix,dim<Matrix>()>;
 
-    /// Determinant of dynamic size matrix with first three derivatives.
+    /**
+     * @brief Determinant of dynamic size matrix with first three derivatives.
+     *
+     * Implemented for \f$ A\in\mathbb{R}^{n,n} \f$ with \f$ n=2,3 \f$. The dimension is stored on update and each call
+     * branches to the inlined formulas of the fixed-size determinant. Before the first update, value and derivatives are zero.
+     * Other dimensions raise an OutOfDomainException if FUNG_ENABLE_EXCEPTIONS is defined.
+     */
     template <class Matrix>
     class DynamicSizeDeterminant :
         public Chainer< DynamicSizeDeterminant<Matrix> >
     {
+      using Scalar = std::decay_t< decltype(at(std::declval<Matrix>(),0,0)) >;
+      using Formulas2 = Detail::DeterminantFormulas<Matrix,2>;
+      using Formulas3 = Detail::DeterminantFormulas<Matrix,3>;
+
     public:
       DynamicSizeDeterminant() = default;
 
       /// Constructor.
-      DynamicSizeDeterminant(Matrix const& A) : dim(rows(A))
+      DynamicSizeDeterminant(Matrix const& A)
       {
         update(A);
       }
 
       /// Reset point of evaluation.
-      void update(Matrix const& A)
+      void update(Matrix const& A_)
       {
 #ifdef FUNG_ENABLE_EXCEPTIONS
-        if( rows(A) != cols(A) ) throw NonSymmetricMatrixException("DynamicSizeDeterminant",rows(A),cols(A),__FILE__,__LINE__);
+        if( rows(A_) != cols(A_) ) throw NonSymmetricMatrixException("DynamicSizeDeterminant",rows(A_),cols(A_),__FILE__,__LINE__);
+        if( rows(A_) != 2 && rows(A_) != 3 ) throw OutOfDomainException("DynamicSizeDeterminant","{2,3}",rows(A_),__FILE__,__LINE__);
 #endif
-        dim = rows(A);
-        if( dim == 2 ) det2D.update(A);
-        if( dim == 3 ) det3D.update(A);
+        assert( rows(A_) == 2 || rows(A_) == 3 );
+        dim = rows(A_);
+        A.store(A_);
+        value = ( dim == 2 ) ? Formulas2::d0(A_) : ( dim == 3 ) ? Formulas3::d0(A_) : Scalar(0);
       }
 
       /// Function value.
-      auto d0() const { return ( dim==2 ) ? det2D.d0() : det3D.d0(); }
+      auto d0() const { return value; }
 
       /// First (directional) derivative.
-      auto d1(Matrix const& dA1) const
+      Scalar d1(Matrix const& dA1) const
       {
-        return ( dim==2 ) ? det2D.d1(dA1) : det3D.d1(dA1) ;
+        if( dim == 2 ) return Formulas2::d1(A.get(),dA1);
+        if( dim == 3 ) return Formulas3::d1(A.get(),dA1);
+        return Scalar(0);
       }
 
       /// Second (directional) derivative.
-      auto d2(Matrix const& dA1, Matrix const& dA2) const
+      Scalar d2(Matrix const& dA1, Matrix const& dA2) const
+      {
+        if( dim == 2 ) return Formulas2::d2(A.get(),dA1,dA2);
+        if( dim == 3 ) return Formulas3::d2(A.get(),dA1,dA2);
+        return Scalar(0);
+      }
+
+      /// Third (directional) derivative.
+      Scalar d3(Matrix const& dA1, Matrix const& dA2, Matrix const& dA3) const
+      {
+        if( dim == 3 ) return Formulas3::d3(A.get(),dA1,dA2,dA3);
+        return Scalar(0);
+      }
+
+      /// First (directional) derivative in direction \f$E_{ij}\f$, i.e. the \f$(i,j)\f$-cofactor.
+      Scalar d1(BasisDirection<Matrix> const& dA1) const
+      {
+        if( dim == 2 ) return Formulas2::d1(A.get(),dA1);
+        if( dim == 3 ) return Formulas3::d1(A.get(),dA1);
+        return Scalar(0);
+      }
+
+      /// Second (directional) derivative in directions \f$E_{ij}\f$ and \f$E_{kl}\f$.
+      Scalar d2(BasisDirection<Matrix> const& dA1, BasisDirection<Matrix> const& dA2) const
       {
-        return ( dim==2 ) ? det2D.d2(dA1,dA2) : det3D.d2(dA1,dA2);
+        if( dim == 2 ) return Formulas2::d2(A.get(),dA1,dA2);
+        if( dim == 3 ) return Formulas3::d2(A.get(),dA1,dA2);
+        return Scalar(0);
       }
 
-        /// Third (directional) derivative.
-      auto d3(Matrix const& dA1, Matrix const& dA2, Matrix const& dA3) const
+      /// Third (directional) derivative in directions \f$E_{ij}\f$, \f$E_{kl}\f$ and \f$E_{mn}\f$.
+      Scalar d3(BasisDirection<Matrix> const& dA1, BasisDirection<Matrix> const& dA2, BasisDirection<Matrix> const& dA3) const
       {
-        return ( dim==2 ) ? 0 : det3D.d3(dA1,dA2,dA3);
+        if( dim == 3 ) return Formulas3::d3(A.get(),dA1,dA2,dA3);
+        return Scalar(0);
       }
 
     private:
+      FunG::Detail::Storage<Matrix> A;
+      Scalar value = 0.;
       int dim = 0;
-      Detail::DeterminantImpl<Matrix,2> det2D;
-      Detail::DeterminantImpl<Matrix,3> det3D;
     };
 
     /// Determinant with first three derivatives.
@@ -29,17 +29,21 @@ namespace FunG
               class = Concepts::SquareMatrixConceptCheck<Matrix> >
     auto deviator(const Matrix& A)
     {
-      return identity(A) + (-1./n) * ( trace(A) * constant( unitMatrix<Matrix>() ) );
+      return identity(A) + (-1./n) * ( trace(A) * constant( cachedUnitMatrix<Matrix>() ) );
     }
 
-    /// Generate %deviator \f$ \mathrm{dev}(A) = A - \frac{\mathrm{tr}(A)}{n}I \f$ of a matrix \f$ A\in\mathbb{R}^{n,n} \f$.
+    /**
+     * @brief Generate %deviator \f$ \mathrm{dev}(A) = A - \frac{\mathrm{tr}(A)}{n}I \f$ of a matrix \f$ A\in\mathbb{R}^{n,n} \f$.
+     *
+     * The unit matrix is not copied, but referenced from the instance shared by all deviators of size n (see cachedUnitMatrix).
+     */
     template <class Matrix,
               std::enable_if_t<!Checks::isConstantSize<Matrix>() && !Checks::isFunction<Matrix>()>* = nullptr,
               class = Concepts::SquareMatrixConceptCheck<Matrix>>
     auto deviator(const Matrix& A)
     {
       assert(rows(A)==cols(A));
-      return identity(A) + (-1./rows(A)) * ( trace(A) * constant( unitMatrix<Matrix>() ) );
+      return identity(A) + (-1./rows(A)) * ( trace(A) * constRef( cachedUnitMatrix<Matrix>(rows(A)) ) );
     }
 
     /// Generate %deviator \f$ \mathrm{dev}\circ f\f$.
@@ -7,7 +7,10 @@
 #include <fung/util/at.hh>
 #include <fung/util/chainer.hh>
 #include <fung/util/static_checks.hh>
+#include <fung/util/storage.hh>
+#include "basis_direction.hh"
 #include "rows_and_cols.hh"
+#include "symmetric_matrix.hh"
 
 namespace FunG
 {
@@ -42,6 +45,12 @@ namespace FunG
                         result += at(A,i,j) * at(B,i,j);
                 return result;
             }
+
+            template <class Scalar, int n>
+            inline auto computeScalarProduct(const SymmetricMatrix<Scalar,n>& A, const SymmetricMatrix<Scalar,n>& B)
+            {
+                return Detail::scalarProduct(A,B);
+            }
         }
         /// @endcond
 
@@ -57,8 +66,8 @@ namespace FunG
             /// Reset matrix to compute squared norm from.
             void update(const Matrix& A)
             {
-                A_ = A;
-                value = FrobeniusDetail::computeScalarProduct(A_,A_);
+                A_.store(A);
+                value = FrobeniusDetail::computeScalarProduct(A,A);
             }
 
             /// Squared matrix norm.
@@ -70,7 +79,7 @@ namespace FunG
             /// First directional derivative.
             auto d1(const Matrix& dA) const
             {
-                return 2 * FrobeniusDetail::computeScalarProduct(A_,dA);
+                return 2 * FrobeniusDetail::computeScalarProduct(A_.get(),dA);
             }
 
             /// Second directional derivative.
@@ -79,8 +88,20 @@ namespace FunG
                 return 2 * FrobeniusDetail::computeScalarProduct(dA1,dA2);
             }
 
+            /// First directional derivative in direction \f$E_{ij}\f$, i.e. \f$2A_{ij}\f$.
+            auto d1(const BasisDirection<Matrix>& dA) const
+            {
+                return decltype(value)( 2 * at(A_.get(),dA.rowIndex(),dA.colIndex()) );
+            }
+
+            /// Second directional derivative in directions \f$E_{ij}\f$ and \f$E_{kl}\f$, i.e. \f$2\delta_{ik}\delta_{jl}\f$.
+            auto d2(const BasisDirection<Matrix>& dA1, const BasisDirection<Matrix>& dA2) const
+            {
+                return decltype(value)( dA1.rowIndex() == dA2.rowIndex() && dA1.colIndex() == dA2.colIndex() ? 2 : 0 );
+            }
+
         private:
-            Matrix A_;
+            FunG::Detail::Storage<Matrix> A_;
             std::decay_t<decltype(at(std::declval<Matrix>(),0,0))> value;
         };
 
@@ -94,7 +115,8 @@ namespace FunG
                   std::enable_if_t<!Checks::isFunction<Matrix>()>* = nullptr>
         auto frobeniusNorm(const Matrix& A)
         {
-            return FrobeniusNorm<Matrix>(A);
+            const auto squaredNorm = SquaredFrobeniusNorm<Matrix>(A);
+            return FrobeniusNorm<Matrix>( Sqrt( squaredNorm() ), squaredNorm );
         }
 
         /// Generate Frobenius norm \f$ \|A\| = \sqrt{A\negthinspace : \negthinspace A }= \sqrt{\mathrm{tr}(A^TA)} = \sqrt{\sum_{i,j} A_{ij}^2}. \f$
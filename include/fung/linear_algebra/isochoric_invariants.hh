@@ -0,0 +1,237 @@
+#pragma once
+
+#include "determinant.hh"
+#include "dimension.hh"
+#include <fung/cmath/pow.hh>
+#include <fung/util/at.hh>
+#include <fung/util/chainer.hh>
+#include <fung/util/mathop_traits.hh>
+#include <fung/util/static_checks.hh>
+#include <fung/util/storage.hh>
+#include <fung/util/type_traits.hh>
+
+#include <type_traits>
+#include <utility>
+
+namespace FunG
+{
+    namespace LinearAlgebra
+    {
+        /// @cond
+        namespace Detail
+        {
+            template < class Matrix >
+            using Entry = decay_t< decltype( at( std::declval< const Matrix& >(), 0, 0 ) ) >;
+
+            /// \f$\iota_1(A)=\mathrm{tr}(A)\f$ and its derivatives.
+            template < int n >
+            struct FirstInvariantFormulas
+            {
+                template < class Matrix >
+                auto d0( const Matrix& A ) const
+                {
+                    auto result = at( A, 0, 0 );
+                    for ( int i = 1; i < n; ++i )
+                        result += at( A, i, i );
+                    return result;
+                }
+
+                template < class Matrix >
+                auto d1( const Matrix&, const Matrix& dA ) const
+                {
+                    return d0( dA );
+                }
+
+                template < class Matrix >
+                Entry< Matrix > d2( const Matrix&, const Matrix&, const Matrix& ) const
+                {
+                    return 0;
+                }
+            };
+
+            /// \f$\mathrm{tr}(AN)\f$ for constant \f$N\f$, i.e. \f$\iota_4\f$ for \f$N=M\f$ and
+            /// \f$\iota_6\f$ for \f$N=M^2\f$, and its derivatives.
+            template < class Tensor, int n >
+            struct MixedInvariantFormulas
+            {
+                explicit MixedInvariantFormulas( Tensor N_ ) : N( std::move( N_ ) )
+                {
+                }
+
+                template < class Matrix >
+                auto d0( const Matrix& A ) const
+                {
+                    Entry< Matrix > result = 0;
+                    for ( int i = 0; i < n; ++i )
+                        for ( int j = 0; j < n; ++j )
+                            result += at( A, i, j ) * at( N, j, i );
+                    return result;
+                }
+
+                template < class Matrix >
+                auto d1( const Matrix&, const Matrix& dA ) const
+                {
+                    return d0( dA );
+                }
+
+                template < class Matrix >
+                Entry< Matrix > d2( const Matrix&, const Matrix&, const Matrix& ) const
+                {
+                    return 0;
+                }
+
+            private:
+                Tensor N;
+            };
+
+            /// \f$\iota_5(A)=\mathrm{tr}(A^2M)\f$ and its derivatives.
+            template < class Tensor, int n >
+            struct SecondMixedInvariantFormulas
+            {
+                explicit SecondMixedInvariantFormulas( Tensor M_ ) : M( std::move( M_ ) )
+                {
+                }
+
+                template < class Matrix >
+                auto d0( const Matrix& A ) const
+                {
+                    return 0.5 * d2( A, A, A );
+                }
+
+                template < class Matrix >
+                auto d1( const Matrix& A, const Matrix& dA ) const
+                {
+                    return d2( A, A, dA );
+                }
+
+                /// \f$\mathrm{tr}((XY+YX)M)\f$
+                template < class Matrix >
+                auto d2( const Matrix&, const Matrix& X, const Matrix& Y ) const
+                {
+                    Entry< Matrix > result = 0;
+                    for ( int i = 0; i < n; ++i )
+                        for ( int j = 0; j < n; ++j )
+                            for ( int k = 0; k < n; ++k )
+                                result += ( at( X, i, j ) * at( Y, j, k ) +
+                                            at( Y, i, j ) * at( X, j, k ) ) *
+                                          at( M, k, i );
+                    return result;
+                }
+
+            private:
+                Tensor M;
+            };
+        }
+        /// @endcond
+
+        /**
+         * @ingroup InvariantGroup
+         *
+         * @brief Isochoric (volume-preserving) invariant
+         * \f$\bar\iota(A)=\iota(A)\det(A)^{-k/n}\f$ for \f$A\in\mathbb{R}^{n,n}\f$, \f$n=2,3\f$.
+         *
+         * The invariant \f$\iota\f$, the determinant and its power are evaluated in one node
+         * from a single copy of \f$A\f$. Derivatives are computed with the product and chain
+         * rule from the derivatives of \f$\iota\f$, \f$\det\f$ and \f$t\mapsto t^{-k/n}\f$.
+         * Use mi1, mi2, mi4, mi5 or mi6 to generate this function.
+         *
+         * @tparam Invariant provides d0(A), d1(A,dA) and d2(A,dA,dB) of an invariant
+         * \f$\iota\f$ that is at most quadratic in \f$A\f$
+         */
+        template < class Matrix, class Invariant, int k, int n = dim< Matrix >() >
+        class IsochoricInvariant
+            : public Chainer< IsochoricInvariant< Matrix, Invariant, k, n > >
+        {
+            static_assert( n == 2 || n == 3,
+                           "Isochoric invariants are only implemented for n=2,3." );
+
+            using Scalar = Detail::Entry< Matrix >;
+            using Det = Detail::DeterminantFormulas< Matrix, n >;
+
+        public:
+            /**
+             * @brief Constructor.
+             * @param A matrix to compute the isochoric invariant from
+             * @param iota_ formulas for the invariant
+             */
+            IsochoricInvariant( const Matrix& A, Invariant iota_ ) : iota( std::move( iota_ ) )
+            {
+                update( A );
+            }
+
+            /// Reset matrix to compute the isochoric invariant from.
+            void update( const Matrix& A_ )
+            {
+                A.store( A_ );
+                h.update( Det::d0( A_ ) );
+                iota0 = iota.d0( A_ );
+                value = iota0 * h();
+            }
+
+            /// Function value.
+            const Scalar& d0() const noexcept
+            {
+                return value;
+            }
+
+            /// First directional derivative.
+            Scalar d1( const Matrix& dA ) const
+            {
+                return iota.d1( A.get(), dA ) * h() + iota0 * h.d1( Det::d1( A.get(), dA ) );
+            }
+
+            /// Second directional derivative.
+            Scalar d2( const Matrix& dA, const Matrix& dB ) const
+            {
+                const auto& A_ = A.get();
+                const auto JA = Det::d1( A_, dA ), JB = Det::d1( A_, dB );
+                return iota.d2( A_, dA, dB ) * h() + iota.d1( A_, dA ) * h.d1( JB ) +
+                       iota.d1( A_, dB ) * h.d1( JA ) +
+                       iota0 * ( h.d2( JA, JB ) + h.d1( Det::d2( A_, dA, dB ) ) );
+            }
+
+            /// Third directional derivative.
+            Scalar d3( const Matrix& dA, const Matrix& dB, const Matrix& dC ) const
+            {
+                const auto& A_ = A.get();
+                const auto JA = Det::d1( A_, dA ), JB = Det::d1( A_, dB ),
+                           JC = Det::d1( A_, dC );
+                const auto JAB = Det::d2( A_, dA, dB ), JAC = Det::d2( A_, dA, dC ),
+                           JBC = Det::d2( A_, dB, dC );
+                const auto hAB = h.d2( JA, JB ) + h.d1( JAB ),
+                           hAC = h.d2( JA, JC ) + h.d1( JAC ),
+                           hBC = h.d2( JB, JC ) + h.d1( JBC );
+                const auto hABC = h.d3( JA, JB, JC ) + h.d2( JAB, JC ) + h.d2( JAC, JB ) +
+                                  h.d2( JBC, JA ) + h.d1( Det::d3( A_, dA, dB, dC ) );
+                return iota.d2( A_, dA, dB ) * h.d1( JC ) + iota.d2( A_, dA, dC ) * h.d1( JB ) +
+                       iota.d2( A_, dB, dC ) * h.d1( JA ) + iota.d1( A_, dA ) * hBC +
+                       iota.d1( A_, dB ) * hAC + iota.d1( A_, dC ) * hAB + iota0 * hABC;
+            }
+
+        private:
+            Invariant iota;
+            FunG::Detail::Storage< Matrix > A;
+            Pow< -k, n, cmath_scalar_t< Scalar > > h;
+            Scalar iota0 = 0, value = 0;
+        };
+
+        /// @cond
+        namespace Detail
+        {
+            template < int k, int n, class Invariant, class Matrix,
+                       std::enable_if_t< !Checks::isFunction< Matrix >() >* = nullptr >
+            auto isochoricInvariant( const Matrix& A, Invariant iota )
+            {
+                return IsochoricInvariant< Matrix, Invariant, k, n >( A, std::move( iota ) );
+            }
+
+            template < int k, int n, class Invariant, class F,
+                       std::enable_if_t< Checks::isFunction< F >() >* = nullptr >
+            auto isochoricInvariant( const F& f, Invariant iota )
+            {
+                return isochoricInvariant< k, n >( f(), std::move( iota ) )( f );
+            }
+        }
+        /// @endcond
+    }
+}
@@ -0,0 +1,151 @@
+// Copyright (C) 2015 by Lars Lubkoll. All rights reserved.
+// Released under the terms of the GNU General Public License version 3 or later.
+
+#pragma once
+
+#include <fung/util/at.hh>
+
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+namespace FunG
+{
+    namespace LinearAlgebra
+    {
+        /// @cond
+        namespace Detail
+        {
+            /// Row-major copy of the entries of a \f$n\times n\f$ matrix.
+            template < class Scalar, int n >
+            using DenseArray = std::array< Scalar, n * n >;
+
+            /// Row-major copy of the entries of a fixed size matrix.
+            template < int n, class Matrix >
+            auto toDenseArray( const Matrix& A )
+            {
+                DenseArray< std::decay_t< decltype( at( A, 0, 0 ) ) >, n > a;
+                for ( int i = 0; i < n; ++i )
+                    for ( int j = 0; j < n; ++j )
+                        a[ i * n + j ] = at( A, i, j );
+                return a;
+            }
+
+            /// Overwrite row i of a with row i of B.
+            template < int n, class Scalar, class Matrix >
+            void replaceRow( DenseArray< Scalar, n >& a, const Matrix& B, int i )
+            {
+                for ( int j = 0; j < n; ++j )
+                    a[ i * n + j ] = at( B, i, j );
+            }
+
+            /**
+             * @brief LU decomposition \f$PA=LU\f$ with partial pivoting for \f$A\in\mathbb{R}^{n,n}\f$.
+             *
+             * All loops have compile-time bounds and are thus unrolled by the compiler for small n.
+             * If a pivot vanishes, the decomposition is stopped and the determinant is zero.
+             */
+            template < class Scalar, int n >
+            class LUDecomposition
+            {
+            public:
+                /// Decompose the matrix with row-major entries a.
+                explicit LUDecomposition( DenseArray< Scalar, n > a ) : lu( std::move( a ) )
+                {
+                    using std::abs;
+                    for ( int k = 0; k < n; ++k )
+                    {
+                        auto pivot = k;
+                        for ( int i = k + 1; i < n; ++i )
+                            if ( abs( lu[ i * n + k ] ) > abs( lu[ pivot * n + k ] ) )
+                                pivot = i;
+                        perm[ k ] = pivot;
+
+                        if ( lu[ pivot * n + k ] == Scalar( 0 ) )
+                        {
+                            determinant = Scalar( 0 );
+                            return;
+                        }
+
+                        if ( pivot != k )
+                        {
+                            for ( int j = 0; j < n; ++j )
+                                std::swap( lu[ k * n + j ], lu[ pivot * n + j ] );
+                            determinant = -determinant;
+                        }
+                        determinant *= lu[ k * n + k ];
+                        if ( k == 0 || abs( lu[ k * n + k ] ) < minPivot )
+                            minPivot = abs( lu[ k * n + k ] );
+                        if ( abs( lu[ k * n + k ] ) > maxPivot )
+                            maxPivot = abs( lu[ k * n + k ] );
+
+                        for ( int i = k + 1; i < n; ++i )
+                        {
+                            lu[ i * n + k ] /= lu[ k * n + k ];
+                            for ( int j = k + 1; j < n; ++j )
+                                lu[ i * n + j ] -= lu[ i * n + k ] * lu[ k * n + j ];
+                        }
+                    }
+                }
+
+                /// Determinant \f$\det(A)=\pm\prod_i U_{ii}\f$.
+                Scalar det() const
+                {
+                    return determinant;
+                }
+
+                /**
+                 * @brief Check if \f$A\f$ is (nearly) singular.
+                 * @param relativeTolerance lower bound for the ratio of the smallest and the largest
+                 * absolute value of the pivots
+                 */
+                bool singular( Scalar relativeTolerance = Scalar( 0 ) ) const
+                {
+                    return determinant == Scalar( 0 ) || minPivot <= relativeTolerance * maxPivot;
+                }
+
+                /// Inverse of \f$A\f$ (row-major), computed column by column. Requires !singular().
+                DenseArray< Scalar, n > inverse() const
+                {
+                    DenseArray< Scalar, n > inv{};
+                    for ( int i = 0; i < n; ++i )
+                        inv[ i * n + i ] = Scalar( 1 );
+
+                    for ( int k = 0; k < n; ++k )
+                        if ( perm[ k ] != k )
+                            for ( int j = 0; j < n; ++j )
+                                std::swap( inv[ k * n + j ], inv[ perm[ k ] * n + j ] );
+
+                    for ( int j = 0; j < n; ++j )
+                    {
+                        for ( int i = 1; i < n; ++i )
+                            for ( int k = 0; k < i; ++k )
+                                inv[ i * n + j ] -= lu[ i * n + k ] * inv[ k * n + j ];
+                        for ( int i = n - 1; i >= 0; --i )
+                        {
+                            for ( int k = i + 1; k < n; ++k )
+                                inv[ i * n + j ] -= lu[ i * n + k ] * inv[ k * n + j ];
+                            inv[ i * n + j ] /= lu[ i * n + i ];
+                        }
+                    }
+                    return inv;
+                }
+
+            private:
+                DenseArray< Scalar, n > lu;
+                std::array< int, n > perm{};
+                Scalar determinant = Scalar( 1 );
+                Scalar minPivot = Scalar( 0 ), maxPivot = Scalar( 0 );
+            };
+
+            /// Determinant of a \f$n\times n\f$ matrix, given as row-major array, via LU decomposition.
+            template < int n, class Scalar >
+            Scalar luDeterminant( DenseArray< Scalar, n > a )
+            {
+                return LUDecomposition< Scalar, n >( std::move( a ) ).det();
+            }
+        }
+        /// @endcond
+    }
+}
@@ -98,44 +98,83 @@ namespace FunG
          * \brief Isochoric (volume-preserving), first modified mixed invariant \f$
          * \bar\iota_4(A)=\iota_4\iota_3^{-1/3} \f$, where \f$\iota_4\f$ is the first mixed
          * and \f$\iota_3\f$ is the third principal invariant.
+         *
+         * For \f$n=2,3\f$ this generates a single IsochoricInvariant node.
          * \param x either a square matrix or a function returning a square matrix
          * \param M structural tensor describing principal (fiber) direction
          * \return \f$\bar\iota_4(x)\f$ if x is a matrix, else \f$\bar\iota_4 \circ x\f$
          */
-        template < class Arg, class Matrix, int n = dim< Matrix >() >
+        template < class Arg, class Matrix, int n = dim< Matrix >(),
+                   std::enable_if_t< n == 2 || n == 3 >* = nullptr >
+        auto mi4( const Arg& x, const Matrix& M )
+        {
+            return Detail::isochoricInvariant< 1, n >(
+                x, Detail::MixedInvariantFormulas< Matrix, n >( M ) );
+        }
+
+        /// @cond
+        template < class Arg, class Matrix, int n = dim< Matrix >(),
+                   std::enable_if_t< n != 2 && n != 3 >* = nullptr >
         auto mi4( const Arg& x, const Matrix& M )
         {
             return i4( x, M ) * Pow< -1, n >()( det( x ) );
         }
+        /// @endcond
 
         /**
          * \brief Isochoric (volume-preserving), second modified principal invariant \f$
          * \bar\iota_5(A)=\iota_5\iota_3^{-2/3} \f$, where \f$\iota_5\f$ is the
          * second mixed and \f$\iota_3\f$ is the third principal invariant.
          *
+         * For \f$n=2,3\f$ this generates a single IsochoricInvariant node.
          * \param x either a square matrix or a function returning a square matrix.
          * \param M structural tensor describing principal (fiber) direction
          * \return \f$\bar\iota_5(x)\f$ if x is a matrix, else \f$\bar\iota_5 \circ x\f$
          */
-        template < class Arg, class Matrix, int n = dim< Matrix >() >
+        template < class Arg, class Matrix, int n = dim< Matrix >(),
+                   std::enable_if_t< n == 2 || n == 3 >* = nullptr >
+        auto mi5( const Arg& x, const Matrix& M )
+        {
+            return Detail::isochoricInvariant< 2, n >(
+                x, Detail::SecondMixedInvariantFormulas< Matrix, n >( M ) );
+        }
+
+        /// @cond
+        template < class Arg, class Matrix, int n = dim< Matrix >(),
+                   std::enable_if_t< n != 2 && n != 3 >* = nullptr >
         auto mi5( const Arg& x, const Matrix& M )
         {
             return i5( x, M ) * Pow< -2, n >()( det( x ) );
         }
+        /// @endcond
 
         /**
          * \brief Isochoric (volume-preserving), second modified principal invariant \f$
          * \bar\iota_6(A)=\iota_6\iota_3^{-1/3} \f$, where \f$\iota_6\f$ is the
          * third mixed and \f$\iota_3\f$ is the third principal invariant.
+         *
+         * For \f$n=2,3\f$ this generates a single IsochoricInvariant node.
          * \param x either a square matrix or a function returning a square matrix.
          * \param M structural tensor describing principal (fiber) direction
          * \return \f$\bar\iota_6(x)\f$ if x is a matrix, else \f$\bar\iota_6 \circ x\f$
          */
-        template < class Arg, class Matrix, int n = dim< Matrix >() >
+        template < class Arg, class Matrix, int n = dim< Matrix >(),
+                   std::enable_if_t< n == 2 || n == 3 >* = nullptr >
+        auto mi6( const Arg& x, const Matrix& M )
+        {
+            const Matrix M2 = multiply_via_traits( M, M );
+            return Detail::isochoricInvariant< 1, n >(
+                x, Detail::MixedInvariantFormulas< Matrix, n >( M2 ) );
+        }
+
+        /// @cond
+        template < class Arg, class Matrix, int n = dim< Matrix >(),
+                   std::enable_if_t< n != 2 && n != 3 >* = nullptr >
         auto mi6( const Arg& x, const Matrix& M )
         {
             return i6( x, M ) * ( Pow< -1, n >()( det( x ) ) );
         }
+        /// @endcond
         /** @} */
     }
 }
@@ -3,14 +3,20 @@
 
 #pragma once
 
+#include "basis_direction.hh"
 #include "cofactor.hh"
 #include "determinant.hh"
 #include "dimension.hh"
+#include "isochoric_invariants.hh"
+#include "symmetric_matrix.hh"
 #include "trace.hh"
 #include <fung/cmath/pow.hh>
 #include <fung/util/chainer.hh>
+#include <fung/util/exceptions.hh>
+#include <fung/util/storage.hh>
 #include <fung/util/type_traits.hh>
 
+#include <cassert>
 #include <type_traits>
 
 namespace FunG
@@ -36,8 +42,36 @@ namespace FunG
                        computeCofactorDirectionalDerivative< row, row >( dA, A );
             }
 
-            template < int >
-            struct Compute;
+            /// Sum of the principal \f$2\times 2\f$ minors \f$\frac{1}{2}(\mathrm{tr}(A)^2 -
+            /// \mathrm{tr}(A^2))\f$ for \f$A\in\mathbb{R}^{n,n}\f$, \f$n>3\f$, and its derivatives.
+            template < int n >
+            struct Compute
+            {
+                static_assert( n > 3, "Principal invariants are only implemented for square "
+                                      "matrices of dimension n>=2." );
+
+                template < class Matrix >
+                static auto sumOfDiagonalCofactors( const Matrix& A )
+                {
+                    return 0.5 * sumOfSymmetricCofactorDerivatives( A, A );
+                }
+
+                /// \f$\mathrm{tr}(A)\mathrm{tr}(B) - \mathrm{tr}(AB)\f$
+                template < class Matrix >
+                static auto sumOfSymmetricCofactorDerivatives( const Matrix& A, const Matrix& B )
+                {
+                    using Scalar = std::decay_t< decltype( at( A, 0, 0 ) ) >;
+                    Scalar trA = 0, trB = 0, trAB = 0;
+                    for ( int i = 0; i < n; ++i )
+                    {
+                        trA += at( A, i, i );
+                        trB += at( B, i, i );
+                        for ( int k = 0; k < n; ++k )
+                            trAB += at( A, i, k ) * at( B, k, i );
+                    }
+                    return trA * trB - trAB;
+                }
+            };
 
             template <>
             struct Compute< 2 >
@@ -75,26 +109,89 @@ namespace FunG
                 }
             };
 
-            /// Fallback implementation if matrix size can not be determined at compile time.
-            template <>
-            struct Compute< -1 >
+            /// \f$\iota_2\f$ and its derivatives for IsochoricInvariant.
+            template < int n >
+            struct SecondInvariantFormulas
             {
                 template < class Matrix >
-                static auto sumOfDiagonalCofactors( const Matrix& A )
+                auto d0( const Matrix& A ) const
                 {
-                    if ( rows( A ) == 2 )
-                        return Compute< 2 >::sumOfDiagonalCofactors( A );
-                    /*if(rows(A) == 3)*/ return Compute< 3 >::sumOfDiagonalCofactors( A );
+                    return Compute< n >::sumOfDiagonalCofactors( A );
                 }
 
                 template < class Matrix >
-                static auto sumOfSymmetricCofactorDerivatives( const Matrix& A, const Matrix& B )
+                auto d1( const Matrix& A, const Matrix& dA ) const
+                {
+                    return Compute< n >::sumOfSymmetricCofactorDerivatives( A, dA );
+                }
+
+                template < class Matrix >
+                auto d2( const Matrix&, const Matrix& dA, const Matrix& dB ) const
                 {
-                    if ( rows( A ) == 2 )
+                    return Compute< n >::sumOfSymmetricCofactorDerivatives( dA, dB );
+                }
+            };
+
+            /// Selects Compute< n > for matrices whose size is known at compile time.
+            template < class Matrix, int n = dim< Matrix >() >
+            class ComputeDispatch
+            {
+            public:
+                void select( const Matrix& )
+                {
+                }
+
+                auto sumOfDiagonalCofactors( const Matrix& A ) const
+                {
+                    return Compute< n >::sumOfDiagonalCofactors( A );
+                }
+
+                auto sumOfSymmetricCofactorDerivatives( const Matrix& A, const Matrix& B ) const
+                {
+                    return Compute< n >::sumOfSymmetricCofactorDerivatives( A, B );
+                }
+            };
+
+            /// Selects Compute< 2 > or Compute< 3 > by the dimension of the last matrix, for matrices
+            /// whose size is not known at compile time. Before the first selection all values are
+            /// zero.
+            template < class Matrix >
+            class ComputeDispatch< Matrix, -1 >
+            {
+                using Scalar = std::decay_t< decltype( at( std::declval< Matrix >(), 0, 0 ) ) >;
+
+            public:
+                void select( const Matrix& A )
+                {
+#ifdef FUNG_ENABLE_EXCEPTIONS
+                    if ( rows( A ) != 2 && rows( A ) != 3 )
+                        throw OutOfDomainException( "SecondPrincipalInvariant", "{2,3}", rows( A ),
+                                                    __FILE__, __LINE__ );
+#endif
+                    assert( rows( A ) == 2 || rows( A ) == 3 );
+                    n = rows( A );
+                }
+
+                Scalar sumOfDiagonalCofactors( const Matrix& A ) const
+                {
+                    if ( n == 2 )
+                        return Compute< 2 >::sumOfDiagonalCofactors( A );
+                    if ( n == 3 )
+                        return Compute< 3 >::sumOfDiagonalCofactors( A );
+                    return Scalar( 0 );
+                }
+
+                Scalar sumOfSymmetricCofactorDerivatives( const Matrix& A, const Matrix& B ) const
+                {
+                    if ( n == 2 )
                         return Compute< 2 >::sumOfSymmetricCofactorDerivatives( A, B );
-                    /*if(rows(A) == 3)*/ return Compute< 3 >::sumOfSymmetricCofactorDerivatives(
-                        A, B );
+                    if ( n == 3 )
+                        return Compute< 3 >::sumOfSymmetricCofactorDerivatives( A, B );
+                    return Scalar( 0 );
                 }
+
+            private:
+                int n = 0;
             };
         }
         /// @endcond
@@ -102,7 +199,8 @@ namespace FunG
         /** @addtogroup InvariantGroup, LinearAlgebraGroup
          * @{ */
         /// Second principal invariant \f$ \iota_2(A)=\mathrm{tr}(\mathrm{cof}(A)) \f$ for
-        /// \f$A\in\mathbb{R}^{n,n}\f$.
+        /// \f$A\in\mathbb{R}^{n,n}\f$, \f$n=2,3\f$. For \f$n>3\f$, \f$\iota_2(A)\f$ is the sum of the
+        /// principal \f$2\times 2\f$ minors of \f$A\f$.
         template < class Matrix, class = Concepts::MatrixConceptCheck< Matrix > >
         class SecondPrincipalInvariant
             : public Chainer<
@@ -123,14 +221,9 @@ namespace FunG
             /// Reset matrix to compute second principal invariant from.
             void update( const Matrix& A )
             {
-                if ( !initialized )
-                {
-                    new ( &A_ ) Matrix{A};
-                    initialized = true;
-                }
-                else
-                    A_ = A;
-                value = Detail::Compute< dim< Matrix >() >::sumOfDiagonalCofactors( A );
+                compute.select( A );
+                A_.store( A );
+                value = compute.sumOfDiagonalCofactors( A );
             }
 
             /// Value of the second principal invariant
@@ -145,8 +238,7 @@ namespace FunG
              */
             auto d1( const Matrix& dA1 ) const
             {
-                return Detail::Compute< dim< Matrix >() >::sumOfSymmetricCofactorDerivatives( A_,
-                                                                                              dA1 );
+                return compute.sumOfSymmetricCofactorDerivatives( A_.get(), dA1 );
             }
 
             /**
@@ -156,14 +248,112 @@ namespace FunG
              */
             auto d2( const Matrix& dA1, const Matrix& dA2 ) const
             {
-                return Detail::Compute< dim< Matrix >() >::sumOfSymmetricCofactorDerivatives( dA1,
-                                                                                              dA2 );
+                return compute.sumOfSymmetricCofactorDerivatives( dA1, dA2 );
+            }
+
+            /**
+             * @brief First directional derivative in direction \f$E_{ij}\f$, i.e.
+             * \f$\mathrm{tr}(A)\delta_{ij}-A_{ji}\f$ for \f$n>2\f$.
+             * @param dA1 direction for which the derivative is computed
+             */
+            Detail::Entry< Matrix > d1( const BasisDirection< Matrix >& dA1 ) const
+            {
+                const auto& A = A_.get();
+                const auto n = Detail::numberOfRows( A );
+                if ( n == 2 )
+                    return d1( static_cast< const Matrix& >( dA1 ) );
+
+                const auto i = dA1.rowIndex(), j = dA1.colIndex();
+                if ( i != j )
+                    return -at( A, j, i );
+                Detail::Entry< Matrix > trA = 0;
+                for ( int k = 0; k < n; ++k )
+                    trA += at( A, k, k );
+                return trA - at( A, i, i );
+            }
+
+            /**
+             * @brief Second directional derivative in directions \f$E_{ij}\f$ and \f$E_{kl}\f$,
+             * i.e. \f$\delta_{ij}\delta_{kl}-\delta_{il}\delta_{jk}\f$ for \f$n>2\f$.
+             * @param dA1 direction for which the derivative is computed
+             * @param dA2 direction for which the derivative is computed
+             */
+            Detail::Entry< Matrix > d2( const BasisDirection< Matrix >& dA1,
+                                        const BasisDirection< Matrix >& dA2 ) const
+            {
+                if ( Detail::numberOfRows( A_.get() ) == 2 )
+                    return d2( static_cast< const Matrix& >( dA1 ),
+                               static_cast< const Matrix& >( dA2 ) );
+
+                const auto i = dA1.rowIndex(), j = dA1.colIndex(), k = dA2.rowIndex(),
+                           l = dA2.colIndex();
+                return ( i == j && k == l ? 1 : 0 ) - ( i == l && j == k ? 1 : 0 );
             }
 
         private:
-            Matrix A_;
+            Detail::ComputeDispatch< Matrix > compute;
+            FunG::Detail::Storage< Matrix > A_;
             std::decay_t< decltype( at( std::declval< Matrix >(), 0, 0 ) ) > value = 0;
-            bool initialized = false;
+        };
+
+        /// Second principal invariant \f$ \iota_2(A)=\mathrm{tr}(\mathrm{cof}(A)) \f$ for symmetric
+        /// \f$A\in\mathbb{R}^{n,n}\f$, \f$n=2,3\f$.
+        template < class Scalar, int n >
+        class SecondPrincipalInvariant<
+            SymmetricMatrix< Scalar, n >, Concepts::MatrixConceptCheck< SymmetricMatrix< Scalar, n > > >
+            : public Chainer< SecondPrincipalInvariant<
+                  SymmetricMatrix< Scalar, n >,
+                  Concepts::MatrixConceptCheck< SymmetricMatrix< Scalar, n > > > >
+        {
+            using Matrix = SymmetricMatrix< Scalar, n >;
+
+        public:
+            SecondPrincipalInvariant() = default;
+
+            /**
+             * @brief Constructor.
+             * @param A matrix to compute second principal invariant from
+             */
+            SecondPrincipalInvariant( const Matrix& A )
+            {
+                update( A );
+            }
+
+            /// Reset matrix to compute second principal invariant from.
+            void update( const Matrix& A )
+            {
+                A_.store( A );
+                value = Detail::traceOfCofactor( A );
+            }
+
+            /// Value of the second principal invariant
+            Scalar d0() const
+            {
+                return value;
+            }
+
+            /**
+             * @brief First directional derivative
+             * @param dA1 direction for which the derivative is computed
+             */
+            Scalar d1( const Matrix& dA1 ) const
+            {
+                return Detail::traceOfCofactorDerivative( A_.get(), dA1 );
+            }
+
+            /**
+             * @brief Second directional derivative
+             * @param dA1 direction for which the derivative is computed
+             * @param dA2 direction for which the derivative is computed
+             */
+            Scalar d2( const Matrix& dA1, const Matrix& dA2 ) const
+            {
+                return n == 2 ? Scalar( 0 ) : Detail::traceOfCofactorDerivative( dA1, dA2 );
+            }
+
+        private:
+            FunG::Detail::Storage< Matrix > A_;
+            Scalar value = 0;
         };
 
         /**
@@ -223,25 +413,49 @@ namespace FunG
          * @brief Isochoric (volume-preserving), first modified principal invariant \f$
          * \bar\iota_1(A)=\iota_1\iota_3^{-1/3} \f$, where \f$\iota_1\f$ is the first
          * and \f$\iota_3\f$ is the third principal invariant.
+         *
+         * For \f$n=2,3\f$ this generates a single IsochoricInvariant node.
          * @param x either a square matrix or a function returning a square matrix
          */
-        template < class Arg, int n = dim< Arg >() >
+        template < class Arg, int n = dim< Arg >(),
+                   std::enable_if_t< n == 2 || n == 3 >* = nullptr >
+        auto mi1( const Arg& x )
+        {
+            return Detail::isochoricInvariant< 1, n >( x, Detail::FirstInvariantFormulas< n >() );
+        }
+
+        /// @cond
+        template < class Arg, int n = dim< Arg >(),
+                   std::enable_if_t< n != 2 && n != 3 >* = nullptr >
         auto mi1( const Arg& x )
         {
             return i1( x ) * pow< -1, n >( det( x ) );
         }
+        /// @endcond
 
         /**
          * @brief Isochoric (volume-preserving), second modified principal invariant \f$
          * \bar\iota_2(A)=\iota_2\iota_3^{-2/3} \f$, where \f$\iota_2\f$ is the second
          * and \f$\iota_3\f$ is the third principal invariant.
+         *
+         * For \f$n=2,3\f$ this generates a single IsochoricInvariant node.
          * @param x either a square matrix or a function returning a square matrix
          */
-        template < class Arg, int n = dim< Arg >() >
+        template < class Arg, int n = dim< Arg >(),
+                   std::enable_if_t< n == 2 || n == 3 >* = nullptr >
+        auto mi2( const Arg& x )
+        {
+            return Detail::isochoricInvariant< 2, n >( x, Detail::SecondInvariantFormulas< n >() );
+        }
+
+        /// @cond
+        template < class Arg, int n = dim< Arg >(),
+                   std::enable_if_t< n != 2 && n != 3 >* = nullptr >
         auto mi2( const Arg& x )
         {
             return i2( x ) * pow< -2, n >( det( x ) );
         }
+        /// @endcond
         /** @} */
     }
 }
@@ -31,7 +31,8 @@ namespace FunG
     };
 
     template <class Vector>
-    struct DynamicNumberOfRows< Vector, void_t<Checks::TryMemFn_size<Vector> > >
+    struct DynamicNumberOfRows< Vector, void_t<Checks::TryMemFn_size<Vector>,
+                                               std::enable_if_t<!Checks::hasMemFn_rows<Vector>()> > >
     {
         static decltype(auto) apply(const Vector& v) noexcept
         {
@@ -93,5 +94,25 @@ namespace FunG
     {
       return NumberOfColumns< Matrix >::value;
     }
+
+    /// @cond
+    namespace Detail
+    {
+      /// Number of rows of a matrix of constant or dynamic size.
+      template < class Matrix ,
+                 std::enable_if_t<Checks::isConstantSize<Matrix>()>* = nullptr >
+      constexpr int numberOfRows(const Matrix&)
+      {
+        return rows<Matrix>();
+      }
+
+      template < class Matrix ,
+                 std::enable_if_t<!Checks::isConstantSize<Matrix>()>* = nullptr >
+      int numberOfRows(const Matrix& A)
+      {
+        return rows(A);
+      }
+    }
+    /// @endcond
   }
 }
@@ -1,9 +1,20 @@
 #pragma once
 
+#include "basis_direction.hh"
+#include "dimension.hh"
+#include "rows_and_cols.hh"
+#include "symmetric_matrix.hh"
 #include "transpose.hh"
 #include <fung/mathematical_operations/sum.hh>
 #include <fung/util/chainer.hh>
 #include <fung/util/add_transposed_matrix.hh>
+#include <fung/util/at.hh>
+#include <fung/util/static_checks.hh>
+#include <fung/util/storage.hh>
+#include <fung/util/zero.hh>
+
+#include <type_traits>
+#include <utility>
 
 namespace FunG
 {
@@ -16,6 +27,26 @@ namespace FunG
      */
     namespace LinearAlgebra
     {
+        /// @cond
+        namespace Detail
+        {
+            /// Zero matrix of the same size as A.
+            template < class Matrix,
+                       std::enable_if_t< Checks::isConstantSize< Matrix >() >* = nullptr >
+            Matrix zeroOfSameSize( const Matrix& )
+            {
+                return cachedZero< Matrix >();
+            }
+
+            template < class Matrix,
+                       std::enable_if_t< !Checks::isConstantSize< Matrix >() >* = nullptr >
+            Matrix zeroOfSameSize( const Matrix& A )
+            {
+                return cachedZero< Matrix >( rows( A ), cols( A ) );
+            }
+        }
+        /// @endcond
+
         /**
          * @brief Right Cauchy-Green strain tensor \f$ F^T F \f$ for a symmetric matrix \f$ F \f$.
          *
@@ -51,14 +82,41 @@ namespace FunG
             Matrix d1(const Matrix& dF1) const
             {
                 Matrix FTdF1 = FT * dF1;
-                return addTransposed(FTdF1);
+                addTransposed(FTdF1);
+                return FTdF1;
             }
 
             /// Second directional derivative \f$ dF_2^T dF_1 + dF_1^T dF_2 \f$.
             Matrix d2(const Matrix& dF1, const Matrix& dF2) const
             {
                 Matrix dF2TdF1 = Detail::transpose(dF2) * dF1;
-                return addTransposed(dF2TdF1);
+                addTransposed(dF2TdF1);
+                return dF2TdF1;
+            }
+
+            /// First directional derivative for \f$ dF_1 = E_{ij} \f$, whose only non-zero row and column is \f$ j \f$.
+            Matrix d1(const BasisDirection<Matrix>& dF1) const
+            {
+                Matrix FTdF1 = Detail::zeroOfSameSize(FT);
+                const auto i = dF1.rowIndex(), j = dF1.colIndex();
+                for(int k = 0; k < Detail::numberOfRows(FT); ++k)
+                {
+                    at(FTdF1,k,j) += at(FT,k,i);
+                    at(FTdF1,j,k) += at(FT,k,i);
+                }
+                return FTdF1;
+            }
+
+            /// Second directional derivative for \f$ dF_1 = E_{ij} \f$ and \f$ dF_2 = E_{kl} \f$, which is \f$ \delta_{ik}(E_{lj} + E_{jl}) \f$.
+            Matrix d2(const BasisDirection<Matrix>& dF1, const BasisDirection<Matrix>& dF2) const
+            {
+                Matrix dF2TdF1 = Detail::zeroOfSameSize(FT);
+                if(dF1.rowIndex() == dF2.rowIndex())
+                {
+                    at(dF2TdF1,dF2.colIndex(),dF1.colIndex()) += 1;
+                    at(dF2TdF1,dF1.colIndex(),dF2.colIndex()) += 1;
+                }
+                return dF2TdF1;
             }
 
         private:
@@ -101,14 +159,41 @@ namespace FunG
             Matrix d1(const Matrix& dF1) const
             {
                 Matrix FTdF1 = dF1 * FT;
-                return addTransposed(FTdF1);
+                addTransposed(FTdF1);
+                return FTdF1;
             }
 
             /// Second directional derivative \f$ dF_2^T dF_1 + dF_1^T dF_2 \f$.
             Matrix d2(const Matrix& dF1, const Matrix& dF2) const
             {
                 Matrix dF1dF2T = dF1 * Detail::transpose(dF2);
-                return addTransposed(dF1dF2T);
+                addTransposed(dF1dF2T);
+                return dF1dF2T;
+            }
+
+            /// First directional derivative for \f$ dF_1 = E_{ij} \f$, whose only non-zero row and column is \f$ i \f$.
+            Matrix d1(const BasisDirection<Matrix>& dF1) const
+            {
+                Matrix dF1FT = Detail::zeroOfSameSize(FT);
+                const auto i = dF1.rowIndex(), j = dF1.colIndex();
+                for(int k = 0; k < Detail::numberOfRows(FT); ++k)
+                {
+                    at(dF1FT,i,k) += at(FT,j,k);
+                    at(dF1FT,k,i) += at(FT,j,k);
+                }
+                return dF1FT;
+            }
+
+            /// Second directional derivative for \f$ dF_1 = E_{ij} \f$ and \f$ dF_2 = E_{kl} \f$, which is \f$ \delta_{jl}(E_{ik} + E_{ki}) \f$.
+            Matrix d2(const BasisDirection<Matrix>& dF1, const BasisDirection<Matrix>& dF2) const
+            {
+                Matrix dF1dF2T = Detail::zeroOfSameSize(FT);
+                if(dF1.colIndex() == dF2.colIndex())
+                {
+                    at(dF1dF2T,dF1.rowIndex(),dF2.rowIndex()) += 1;
+                    at(dF1dF2T,dF2.rowIndex(),dF1.rowIndex()) += 1;
+                }
+                return dF1dF2T;
             }
 
         private:
@@ -116,6 +201,124 @@ namespace FunG
         };
 
 
+        /// @cond
+        namespace Detail
+        {
+            /// Upper triangle of \f$ A^T A \f$.
+            template < class Matrix, int n = dim< Matrix >() >
+            auto transposedProduct( const Matrix& A )
+            {
+                SymmetricMatrix< std::decay_t< decltype( at( A, 0, 0 ) ) >, n > C;
+                for ( int i = 0; i < n; ++i )
+                    for ( int j = i; j < n; ++j )
+                    {
+                        C( i, j ) = at( A, 0, i ) * at( A, 0, j );
+                        for ( int k = 1; k < n; ++k )
+                            C( i, j ) += at( A, k, i ) * at( A, k, j );
+                    }
+                return C;
+            }
+
+            /// Upper triangle of \f$ A^T B + B^T A \f$.
+            template < class Matrix, int n = dim< Matrix >() >
+            auto symmetrizedTransposedProduct( const Matrix& A, const Matrix& B )
+            {
+                SymmetricMatrix< std::decay_t< decltype( at( A, 0, 0 ) ) >, n > C;
+                for ( int i = 0; i < n; ++i )
+                    for ( int j = i; j < n; ++j )
+                    {
+                        C( i, j ) = at( A, 0, i ) * at( B, 0, j ) + at( B, 0, i ) * at( A, 0, j );
+                        for ( int k = 1; k < n; ++k )
+                            C( i, j ) += at( A, k, i ) * at( B, k, j ) + at( B, k, i ) * at( A, k, j );
+                    }
+                return C;
+            }
+        }
+        /// @endcond
+
+        /**
+         * @brief Right Cauchy-Green strain tensor \f$ F^T F \f$ with symmetric value and
+         * derivatives.
+         *
+         * Only the upper triangles of \f$F^T F\f$ and its derivatives are computed and returned
+         * as SymmetricMatrix, which reduces the costs of subsequent invariants.
+         */
+        template < class Matrix, class = Concepts::SquareMatrixConceptCheck< Matrix > >
+        class SymmetricRightCauchyGreenStrainTensor
+            : public Chainer< SymmetricRightCauchyGreenStrainTensor<
+                  Matrix, Concepts::SquareMatrixConceptCheck< Matrix > > >
+        {
+            static_assert( Checks::isConstantSize< Matrix >(),
+                           "SymmetricRightCauchyGreenStrainTensor requires matrices of constant size." );
+            using Symmetric =
+                SymmetricMatrix< std::decay_t< decltype( at( std::declval< Matrix >(), 0, 0 ) ) >,
+                                 dim< Matrix >() >;
+
+        public:
+            SymmetricRightCauchyGreenStrainTensor() = default;
+            /**
+             * @brief Constructor.
+             * @param F point of evaluation.
+             */
+            explicit SymmetricRightCauchyGreenStrainTensor( const Matrix& F )
+            {
+                update( F );
+            }
+
+            /// Reset point of evaluation.
+            void update( const Matrix& F )
+            {
+                F_.store( F );
+                FTF = Detail::transposedProduct( F );
+            }
+
+            /// Function value \f$ F^T * F \f$.
+            const Symmetric& d0() const noexcept
+            {
+                return FTF;
+            }
+
+            /// First directional derivative \f$ F^T dF_1 + dF_1^T F \f$.
+            Symmetric d1( const Matrix& dF1 ) const
+            {
+                return Detail::symmetrizedTransposedProduct( F_.get(), dF1 );
+            }
+
+            /// Second directional derivative \f$ dF_2^T dF_1 + dF_1^T dF_2 \f$.
+            Symmetric d2( const Matrix& dF1, const Matrix& dF2 ) const
+            {
+                return Detail::symmetrizedTransposedProduct( dF1, dF2 );
+            }
+
+            /// First directional derivative for \f$ dF_1 = E_{ij} \f$, whose only non-zero row and
+            /// column is \f$ j \f$.
+            Symmetric d1( const BasisDirection< Matrix >& dF1 ) const
+            {
+                Symmetric result( 0 );
+                const auto i = dF1.rowIndex(), j = dF1.colIndex();
+                for ( int k = 0; k < dim< Matrix >(); ++k )
+                    result( k, j ) += at( F_.get(), i, k );
+                result( j, j ) += at( F_.get(), i, j );
+                return result;
+            }
+
+            /// Second directional derivative for \f$ dF_1 = E_{ij} \f$ and \f$ dF_2 = E_{kl} \f$,
+            /// which is \f$ \delta_{ik}(E_{lj} + E_{jl}) \f$.
+            Symmetric d2( const BasisDirection< Matrix >& dF1,
+                          const BasisDirection< Matrix >& dF2 ) const
+            {
+                Symmetric result( 0 );
+                if ( dF1.rowIndex() == dF2.rowIndex() )
+                    result( dF2.colIndex(), dF1.colIndex() ) +=
+                        dF1.colIndex() == dF2.colIndex() ? 2 : 1;
+                return result;
+            }
+
+        private:
+            FunG::Detail::Storage< Matrix > F_;
+            Symmetric FTF;
+        };
+
         /**
          * \brief Generate the right Cauchy-Green strain tensor \f$A*A^T\f$.
          * \param A matrix
@@ -142,6 +345,34 @@ namespace FunG
         }
 
 
+        /**
+         * \brief Generate the right Cauchy-Green strain tensor \f$A^T*A\f$ with symmetric value
+         * and derivatives.
+         * \param A matrix
+         * \return SymmetricRightCauchyGreenStrainTensor<Matrix>(A), or
+         * RightCauchyGreenStrainTensor<Matrix>(A) for matrices of dynamic size
+         */
+        template < class Matrix, std::enable_if_t< !Checks::isFunction< Matrix >() >* = nullptr >
+        auto symmetricStrainTensor( const Matrix& A )
+        {
+            return std::conditional_t< Checks::isConstantSize< Matrix >(),
+                                       SymmetricRightCauchyGreenStrainTensor< Matrix >,
+                                       RightCauchyGreenStrainTensor< Matrix > >{A};
+        }
+
+        /**
+         * \brief Generate the right Cauchy-Green strain tensor \f$f^T*f\f$ with symmetric value
+         * and derivatives, where \f$f:\cdot\mapsto\mathbb{R}^{n,n} \f$.
+         * \param f function object mapping into a space of square matrices
+         * \return symmetricStrainTensor( f() )( f )
+         */
+        template < class F, std::enable_if_t< Checks::isFunction< F >() >* = nullptr >
+        auto symmetricStrainTensor( const F& f )
+        {
+            return symmetricStrainTensor( f() )( f );
+        }
+
+
         /**
          * \brief Generate the left Cauchy-Green strain tensor \f$A^T*A\f$.
          * \param A matrix
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <fung/concept_check.hh>
+#include <fung/util/extract_rows_and_cols.hh>
+#include <fung/util/packed_storage.hh>
+
+#include <array>
+#include <type_traits>
+
+namespace FunG
+{
+    namespace LinearAlgebra
+    {
+        /** @addtogroup LinearAlgebraGroup
+         *  @{ */
+
+        /**
+         * @brief Symmetric matrix in \f$\mathbb{R}^{n,n}\f$ that only stores its upper triangle.
+         *
+         * Entries are held in packed storage (see packedIndex()), i.e. 3 entries for
+         * \f$n=2\f$ and 6 entries for \f$n=3\f$. Access via A(i,j) is valid for all
+         * \f$0\leq i,j<n\f$.
+         */
+        template < class Scalar, int n >
+        class SymmetricMatrix
+        {
+        public:
+            SymmetricMatrix() = default;
+
+            /// Constructor. Sets all entries to value.
+            explicit SymmetricMatrix( Scalar value )
+            {
+                fill( value );
+            }
+
+            /// Number of stored entries.
+            static constexpr int size()
+            {
+                return packedSize( n );
+            }
+
+            /// Access entry \f$A_{ij}=A_{ji}\f$.
+            Scalar& operator()( int i, int j )
+            {
+                return entries[ packedIndex( i, j, n ) ];
+            }
+
+            /// Access entry \f$A_{ij}=A_{ji}\f$.
+            const Scalar& operator()( int i, int j ) const
+            {
+                return entries[ packedIndex( i, j, n ) ];
+            }
+
+            /// Access k-th entry in packed storage.
+            Scalar& packed( int k )
+            {
+                return entries[ k ];
+            }
+
+            /// Access k-th entry in packed storage.
+            const Scalar& packed( int k ) const
+            {
+                return entries[ k ];
+            }
+
+            /// Set all entries to value.
+            void fill( Scalar value )
+            {
+                entries.fill( value );
+            }
+
+            SymmetricMatrix& operator+=( const SymmetricMatrix& other )
+            {
+                for ( int k = 0; k < size(); ++k )
+                    entries[ k ] += other.entries[ k ];
+                return *this;
+            }
+
+            SymmetricMatrix& operator-=( const SymmetricMatrix& other )
+            {
+                for ( int k = 0; k < size(); ++k )
+                    entries[ k ] -= other.entries[ k ];
+                return *this;
+            }
+
+            SymmetricMatrix& operator*=( Scalar a )
+            {
+                for ( auto& entry : entries )
+                    entry *= a;
+                return *this;
+            }
+
+            friend SymmetricMatrix operator+( SymmetricMatrix A, const SymmetricMatrix& B )
+            {
+                return A += B;
+            }
+
+            friend SymmetricMatrix operator-( SymmetricMatrix A, const SymmetricMatrix& B )
+            {
+                return A -= B;
+            }
+
+            friend SymmetricMatrix operator-( SymmetricMatrix A )
+            {
+                return A *= -1;
+            }
+
+            friend SymmetricMatrix operator*( Scalar a, SymmetricMatrix A )
+            {
+                return A *= a;
+            }
+
+            friend SymmetricMatrix operator*( SymmetricMatrix A, Scalar a )
+            {
+                return A *= a;
+            }
+
+            friend bool operator==( const SymmetricMatrix& A, const SymmetricMatrix& B )
+            {
+                return A.entries == B.entries;
+            }
+
+            friend bool operator!=( const SymmetricMatrix& A, const SymmetricMatrix& B )
+            {
+                return !( A == B );
+            }
+
+        private:
+            std::array< Scalar, packedSize( n ) > entries;
+        };
+
+        /// @cond
+        template < class Scalar, int n, class MatrixConceptCheck >
+        struct NumberOfRows< SymmetricMatrix< Scalar, n >, MatrixConceptCheck >
+            : std::integral_constant< int, n >
+        {
+        };
+
+        template < class Scalar, int n, class MatrixConceptCheck >
+        struct NumberOfColumns< SymmetricMatrix< Scalar, n >, MatrixConceptCheck >
+            : std::integral_constant< int, n >
+        {
+        };
+
+        namespace Detail
+        {
+            /// Scalar product \f$A\negthinspace : \negthinspace B\f$, off-diagonal entries are
+            /// counted twice.
+            template < class Scalar, int n >
+            Scalar scalarProduct( const SymmetricMatrix< Scalar, n >& A,
+                                  const SymmetricMatrix< Scalar, n >& B )
+            {
+                auto diagonal = A( 0, 0 ) * B( 0, 0 );
+                auto offDiagonal = Scalar( 0 );
+                for ( int i = 0; i < n; ++i )
+                {
+                    if ( i > 0 )
+                        diagonal += A( i, i ) * B( i, i );
+                    for ( int j = i + 1; j < n; ++j )
+                        offDiagonal += A( i, j ) * B( i, j );
+                }
+                return diagonal + 2 * offDiagonal;
+            }
+
+            /// Cofactor matrix \f$\mathrm{cof}(A)\f$.
+            template < class Scalar >
+            SymmetricMatrix< Scalar, 2 > cofactor( const SymmetricMatrix< Scalar, 2 >& A )
+            {
+                SymmetricMatrix< Scalar, 2 > C;
+                C( 0, 0 ) = A( 1, 1 );
+                C( 0, 1 ) = -A( 0, 1 );
+                C( 1, 1 ) = A( 0, 0 );
+                return C;
+            }
+
+            /// Cofactor matrix \f$\mathrm{cof}(A)\f$.
+            template < class Scalar >
+            SymmetricMatrix< Scalar, 3 > cofactor( const SymmetricMatrix< Scalar, 3 >& A )
+            {
+                SymmetricMatrix< Scalar, 3 > C;
+                C( 0, 0 ) = A( 1, 1 ) * A( 2, 2 ) - A( 1, 2 ) * A( 1, 2 );
+                C( 0, 1 ) = A( 0, 2 ) * A( 1, 2 ) - A( 0, 1 ) * A( 2, 2 );
+                C( 0, 2 ) = A( 0, 1 ) * A( 1, 2 ) - A( 0, 2 ) * A( 1, 1 );
+                C( 1, 1 ) = A( 0, 0 ) * A( 2, 2 ) - A( 0, 2 ) * A( 0, 2 );
+                C( 1, 2 ) = A( 0, 1 ) * A( 0, 2 ) - A( 0, 0 ) * A( 1, 2 );
+                C( 2, 2 ) = A( 0, 0 ) * A( 1, 1 ) - A( 0, 1 ) * A( 0, 1 );
+                return C;
+            }
+
+            /// Directional derivative \f$\mathrm{cof}'(A)dA\f$ of the cofactor matrix, which is
+            /// linear in \f$dA\f$ and independent of \f$A\f$ for \f$n=2\f$.
+            template < class Scalar >
+            SymmetricMatrix< Scalar, 2 > cofactorDerivative( const SymmetricMatrix< Scalar, 2 >&,
+                                                              const SymmetricMatrix< Scalar, 2 >& dA )
+            {
+                return cofactor( dA );
+            }
+
+            /// Directional derivative \f$\mathrm{cof}'(A)dA\f$ of the cofactor matrix, which is
+            /// bilinear and symmetric in \f$A\f$ and \f$dA\f$ for \f$n=3\f$.
+            template < class Scalar >
+            SymmetricMatrix< Scalar, 3 > cofactorDerivative( const SymmetricMatrix< Scalar, 3 >& A,
+                                                              const SymmetricMatrix< Scalar, 3 >& dA )
+            {
+                SymmetricMatrix< Scalar, 3 > C;
+                C( 0, 0 ) = A( 1, 1 ) * dA( 2, 2 ) + dA( 1, 1 ) * A( 2, 2 ) -
+                            2 * A( 1, 2 ) * dA( 1, 2 );
+                C( 0, 1 ) = A( 0, 2 ) * dA( 1, 2 ) + dA( 0, 2 ) * A( 1, 2 ) -
+                            A( 0, 1 ) * dA( 2, 2 ) - dA( 0, 1 ) * A( 2, 2 );
+                C( 0, 2 ) = A( 0, 1 ) * dA( 1, 2 ) + dA( 0, 1 ) * A( 1, 2 ) -
+                            A( 0, 2 ) * dA( 1, 1 ) - dA( 0, 2 ) * A( 1, 1 );
+                C( 1, 1 ) = A( 0, 0 ) * dA( 2, 2 ) + dA( 0, 0 ) * A( 2, 2 ) -
+                            2 * A( 0, 2 ) * dA( 0, 2 );
+                C( 1, 2 ) = A( 0, 1 ) * dA( 0, 2 ) + dA( 0, 1 ) * A( 0, 2 ) -
+                            A( 0, 0 ) * dA( 1, 2 ) - dA( 0, 0 ) * A( 1, 2 );
+                C( 2, 2 ) = A( 0, 0 ) * dA( 1, 1 ) + dA( 0, 0 ) * A( 1, 1 ) -
+                            2 * A( 0, 1 ) * dA( 0, 1 );
+                return C;
+            }
+
+            /// Trace of the cofactor matrix, i.e. the second principal invariant.
+            template < class Scalar >
+            Scalar traceOfCofactor( const SymmetricMatrix< Scalar, 2 >& A )
+            {
+                return A( 0, 0 ) + A( 1, 1 );
+            }
+
+            /// Trace of the cofactor matrix, i.e. the second principal invariant.
+            template < class Scalar >
+            Scalar traceOfCofactor( const SymmetricMatrix< Scalar, 3 >& A )
+            {
+                return A( 0, 0 ) * ( A( 1, 1 ) + A( 2, 2 ) ) + A( 1, 1 ) * A( 2, 2 ) -
+                       ( A( 0, 1 ) * A( 0, 1 ) + A( 0, 2 ) * A( 0, 2 ) + A( 1, 2 ) * A( 1, 2 ) );
+            }
+
+            /// Trace of cofactorDerivative(A,dA).
+            template < class Scalar >
+            Scalar traceOfCofactorDerivative( const SymmetricMatrix< Scalar, 2 >&,
+                                              const SymmetricMatrix< Scalar, 2 >& dA )
+            {
+                return dA( 0, 0 ) + dA( 1, 1 );
+            }
+
+            /// Trace of cofactorDerivative(A,dA).
+            template < class Scalar >
+            Scalar traceOfCofactorDerivative( const SymmetricMatrix< Scalar, 3 >& A,
+                                              const SymmetricMatrix< Scalar, 3 >& dA )
+            {
+                return A( 0, 0 ) * ( dA( 1, 1 ) + dA( 2, 2 ) ) +
+                       A( 1, 1 ) * ( dA( 0, 0 ) + dA( 2, 2 ) ) +
+                       A( 2, 2 ) * ( dA( 0, 0 ) + dA( 1, 1 ) ) -
+                       2 * ( A( 0, 1 ) * dA( 0, 1 ) + A( 0, 2 ) * dA( 0, 2 ) +
+                             A( 1, 2 ) * dA( 1, 2 ) );
+            }
+        }
+        /// @endcond
+
+        /** @} */
+    }
+
+    /// @cond
+    namespace Concepts
+    {
+        /// Symmetric matrices are not closed under multiplication. Thus, functions that accept
+        /// SymmetricMatrix must not multiply their arguments.
+        template < class Scalar, int n >
+        struct SquareMatrixConceptCheck< LinearAlgebra::SymmetricMatrix< Scalar, n > >
+            : MatrixConceptCheck< LinearAlgebra::SymmetricMatrix< Scalar, n > >
+        {
+        };
+    }
+    /// @endcond
+}
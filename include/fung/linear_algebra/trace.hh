@@ -8,6 +8,7 @@
 #include <fung/util/chainer.hh>
 #include <fung/util/exceptions.hh>
 #include <fung/util/type_traits.hh>
+#include "basis_direction.hh"
 #include "dimension.hh"
 #include "rows_and_cols.hh"
 
@@ -88,6 +89,12 @@ namespace FunG
         return Detail::ComputeTrace<dim<Matrix>()>::apply(dA);
       }
 
+      /// First directional derivative in direction \f$E_{ij}\f$, i.e. \f$\delta_{ij}\f$.
+      auto d1(const BasisDirection<Matrix>& dA) const
+      {
+        return decltype(trace)( dA.rowIndex() == dA.colIndex() ? 1 : 0 );
+      }
+
     private:
       std::decay_t< decltype( Detail::ComputeTrace<dim<Matrix>()>::apply(std::declval<Matrix>()) ) > trace = 0;
     };
@@ -131,6 +138,12 @@ namespace FunG
         return result;
       }
 
+      /// First directional derivative in direction \f$E_{ij}\f$, i.e. \f$\delta_{ij}\f$.
+      auto d1(const BasisDirection<Matrix>& dA) const
+      {
+        return decltype(trace)( dA.rowIndex() == dA.colIndex() ? 1 : 0 );
+      }
+
     private:
       std::decay_t< decltype(at(std::declval<Matrix>(),0,0)) > trace = 0;
     };
@@ -4,6 +4,7 @@
 #ifndef FUNG_LINEAR_ALGEBRA_TRANSPOSE_HH
 #define FUNG_LINEAR_ALGEBRA_TRANSPOSE_HH
 
+#include <cassert>
 #include <type_traits>
 
 #include "fung/util/at.hh"
@@ -35,6 +35,21 @@ namespace FunG
       return A;
     }
 
+    /// Shared, immutable unit matrix for the specified constant size matrix type, generated only once.
+    template <class Matrix, class = std::enable_if_t<Checks::isConstantSize<Matrix>()> >
+    const Matrix& cachedUnitMatrix()
+    {
+      static const Matrix A = unitMatrix<Matrix>();
+      return A;
+    }
+
+    /// Shared, immutable unit matrix for the specified dynamic size matrix type, generated only once per size.
+    template <class Matrix, class = std::enable_if_t<!Checks::isConstantSize<Matrix>()> >
+    const Matrix& cachedUnitMatrix(int rows)
+    {
+      return FunG::Detail::sharedInstance<Matrix>(rows, [](int n) { return unitMatrix<Matrix>(n); });
+    }
+
     /** @} */
   }
 }
@@ -2,6 +2,7 @@
 
 #include <fung/cmath/arccos.hh>
 #include <fung/cmath/arcsine.hh>
+#include <fung/cmath/auto_diff.hh>
 #include <fung/cmath/cosine.hh>
 #include <fung/cmath/erf.hh>
 #include <fung/cmath/exp.hh>
@@ -1,24 +1,74 @@
 #pragma once
 
+#include <array>
 #include <type_traits>
 #include <utility>
 
 #include <fung/concept_check.hh>
 #include <fung/util/compute_chain.hh>
 #include <fung/util/compute_sum.hh>
+#include <fung/util/derivative_cache.hh>
 #include <fung/util/derivative_wrappers.hh>
 #include <fung/util/evaluate_if_present.hh>
+#include <fung/util/fused_derivatives.hh>
 #include <fung/util/indexed_type.hh>
+#include <fung/util/node_state.hh>
+#include <fung/util/type_traits.hh>
 
 namespace FunG
 {
     /// @cond
     template < class >
     struct Chainer;
+
+    namespace Detail
+    {
+        template < class >
+        struct ProfileTree;
+    }
     /// @endcond
 
     namespace MathematicalOperations
     {
+        /// @cond
+        namespace ChainDetail
+        {
+            /// Passes the value of the inner function to the outer function.
+            template < class FArg, bool = true >
+            struct InnerValue
+            {
+                template < class G >
+                decltype( auto ) innerValue( const G& g ) const
+                {
+                    return g();
+                }
+            };
+
+#ifdef FUNG_REFERENCE_STORAGE
+            /// Non-scalar values that are returned by copy are cached, since the outer function
+            /// only keeps a reference to its argument.
+            template < class FArg >
+            struct InnerValue< FArg, false >
+            {
+                template < class G >
+                const std::decay_t< FArg >& innerValue( const G& g )
+                {
+                    cache = g();
+                    return cache;
+                }
+
+            private:
+                std::decay_t< FArg > cache;
+            };
+#endif
+
+            template < class G, class FArg = decltype( std::declval< G >()() ) >
+            using InnerValue_t =
+                InnerValue< FArg, std::is_lvalue_reference< FArg >::value ||
+                                      is_arithmetic< std::decay_t< FArg > >::value >;
+        }
+        /// @endcond
+
         /**
          * @ingroup MathematicalOperationsGroup
          *
@@ -28,10 +78,16 @@ namespace FunG
         template < class F, class G, class = Concepts::FunctionConceptCheck< F >,
                    class = Concepts::FunctionConceptCheck< G > >
         struct Chain : Chainer< Chain< F, G, Concepts::FunctionConceptCheck< F >,
-                                       Concepts::FunctionConceptCheck< G > > >
+                                       Concepts::FunctionConceptCheck< G > > >,
+                       ChainDetail::InnerValue_t< G >,
+                       Detail::DerivativeCaches< decay_t< decltype( std::declval< G >()() ) > >
         {
         private:
             using FArg = decltype( std::declval< G >()() );
+            using Caches = Detail::DerivativeCaches< decay_t< FArg > >;
+
+            template < class IndexedArg >
+            using DG1 = Detail::CachedD1< G, IndexedArg, Detail::CacheType< Caches, 0 > >;
 
             template < class IndexedArgX, class IndexedArgY, class IndexedFArgX,
                        class IndexedFArgY >
@@ -61,7 +117,7 @@ namespace FunG
              */
             constexpr Chain( const F& f_, const G& g_ ) : g( g_ ), f( f_ )
             {
-                update_if_present( f, g() );
+                update_if_present( f, this->innerValue( g ) );
             }
 
             /**
@@ -71,30 +127,89 @@ namespace FunG
              */
             constexpr Chain( F&& f_, G&& g_ ) : g( std::move( g_ ) ), f( std::move( f_ ) )
             {
-                update_if_present( f, g() );
+                update_if_present( f, this->innerValue( g ) );
+            }
+
+            /// Constructor for the evaluation of a NodeState, does not update the outer function.
+            constexpr Chain( Detail::BindTag, F f_, G g_ )
+                : g( std::move( g_ ) ), f( std::move( f_ ) )
+            {
+            }
+
+#ifdef FUNG_REFERENCE_STORAGE
+            /// Copy constructor. The outer function is updated to refer to the copied inner
+            /// function.
+            Chain( const Chain& other )
+                : ChainDetail::InnerValue_t< G >( other ), g( other.g ), f( other.f )
+            {
+                update_if_present( f, this->innerValue( g ) );
+            }
+
+            /// Move constructor. The outer function is updated to refer to the moved inner
+            /// function.
+            Chain( Chain&& other )
+                : ChainDetail::InnerValue_t< G >( std::move( other ) ), g( std::move( other.g ) ),
+                  f( std::move( other.f ) )
+            {
+                update_if_present( f, this->innerValue( g ) );
             }
 
+            /// Copy assignment. The outer function is updated to refer to the copied inner
+            /// function.
+            Chain& operator=( const Chain& other )
+            {
+                g = other.g;
+                f = other.f;
+                this->clearCaches();
+                update_if_present( f, this->innerValue( g ) );
+                return *this;
+            }
+
+            /// Move assignment. The outer function is updated to refer to the moved inner
+            /// function.
+            Chain& operator=( Chain&& other )
+            {
+                g = std::move( other.g );
+                f = std::move( other.f );
+                this->clearCaches();
+                update_if_present( f, this->innerValue( g ) );
+                return *this;
+            }
+#endif
+
             /// Update point of evaluation.
             template < class Arg >
             void update( const Arg& x )
             {
+                this->clearCaches();
                 update_if_present( g, x );
-                update_if_present( f, g() );
+                update_if_present( f, this->innerValue( g ) );
+            }
+
+            /// Update point of evaluation. Only derivatives up to order k will be evaluated.
+            template < class Arg, int k >
+            void update( const Arg& x, EvaluationOrder< k > order )
+            {
+                this->clearCaches();
+                update_if_present( g, x, order );
+                update_if_present( f, this->innerValue( g ), order );
             }
 
             /// Update variable corresponding to index.
             template < int index, class Arg >
             void update( const Arg& x )
             {
+                this->clearCaches();
                 update_if_present< index >( g, x );
-                update_if_present( f, g() );
+                update_if_present( f, this->innerValue( g ) );
             }
 
             template < class... IndexedArgs >
             void bulk_update( IndexedArgs&&... args )
             {
+                this->clearCaches();
                 bulk_update_if_present( g, std::forward< IndexedArgs >( args )... );
-                update_if_present( f, g() );
+                update_if_present( f, this->innerValue( g ) );
             }
 
             /// Function value.
@@ -131,8 +246,9 @@ namespace FunG
             auto d2( ArgX const& dx, ArgY const& dy ) const
             {
                 return sum(
-                    chain< IndexedFArgX, IndexedFArgY >( f, D1< G, IndexedArgX >( g, dx ),
-                                                         D1< G, IndexedArgY >( g, dy ) ),
+                    chain< IndexedFArgX, IndexedFArgY >(
+                        f, DG1< IndexedArgX >( g, dx, this->template cache< 0 >() ),
+                        DG1< IndexedArgY >( g, dy, this->template cache< 0 >() ) ),
                     chain< IndexedFArgX >( f, D2< G, IndexedArgX, IndexedArgY >( g, dx, dy ) ) )();
             }
 
@@ -154,9 +270,9 @@ namespace FunG
                                        IndexedFArgY, IndexedFArgZ >::present > >
             auto d3( ArgX const& dx, ArgY const& dy, ArgZ const& dz ) const
             {
-                D1< G, IndexedArgX > dGdx( g, dx );
-                D1< G, IndexedArgY > dGdy( g, dy );
-                D1< G, IndexedArgZ > dGdz( g, dz );
+                DG1< IndexedArgX > dGdx( g, dx, this->template cache< 0 >() );
+                DG1< IndexedArgY > dGdy( g, dy, this->template cache< 0 >() );
+                DG1< IndexedArgZ > dGdz( g, dz, this->template cache< 0 >() );
                 return sum(
                     chain< IndexedFArgX, IndexedFArgY, IndexedFArgZ >( f, dGdx, dGdy, dGdz ),
                     chain< IndexedFArgX, IndexedFArgY >(
@@ -169,9 +285,132 @@ namespace FunG
                         f, D3< G, IndexedArgX, IndexedArgY, IndexedArgZ >( g, dx, dy, dz ) ) )();
             }
 
+            template < class, class, class, bool >
+            friend struct FunG::D1D2;
+
+            template < class, class, int, bool >
+            friend struct FunG::D1D2Set;
+
+            template < class >
+            friend struct FunG::Detail::ProfileTree;
+
+            template < class, class, class >
+            friend class FunG::NodeState;
+
         private:
             G g;
             F f;
         };
     } // namespace MathematicalOperations
+
+    /// @cond
+    /// First derivatives of the inner function enter both derivatives of the chain.
+    template < class F, class G, class CheckF, class CheckG, class IndexedArgX, class IndexedArgY,
+               bool withD1Y >
+    struct D1D2< MathematicalOperations::Chain< F, G, CheckF, CheckG >, IndexedArgX, IndexedArgY,
+                 withD1Y >
+    {
+    private:
+        using FArg = decltype( std::declval< G >()() );
+        using IndexedFArgX = IndexedType< FArg, IndexedArgX::index >;
+        using IndexedFArgY = IndexedType< FArg, IndexedArgY::index >;
+        using Inner = D1D2< G, IndexedArgX, IndexedArgY >;
+
+        Inner inner;
+
+    public:
+        D1D2( const MathematicalOperations::Chain< F, G, CheckF, CheckG >& h,
+              const typename IndexedArgX::type& dx, const typename IndexedArgY::type& dy )
+            : inner( h.g, dx, dy ), d1x( h.f, inner.d1x ), d1y( h.f, inner.d1y ),
+              d2xy( chain< IndexedFArgX, IndexedFArgY >( h.f, inner.d1x, inner.d1y ),
+                    chain< IndexedFArgX >( h.f, inner.d2xy ) )
+        {
+        }
+
+        ComputeChainD1< F, decltype( Inner::d1x ), IndexedFArgX > d1x;
+        std::conditional_t< withD1Y, ComputeChainD1< F, decltype( Inner::d1y ), IndexedFArgY >,
+                            Detail::NotRequested >
+            d1y;
+        ComputeSum< ComputeChainD2< F, decltype( Inner::d1x ), decltype( Inner::d1y ),
+                                    IndexedFArgX, IndexedFArgY >,
+                    ComputeChainD1< F, decltype( Inner::d2xy ), IndexedFArgX > >
+            d2xy;
+    };
+    /// @endcond
+
+    /// @cond
+    /// First and second derivatives of the inner function are computed once per direction resp.
+    /// pair of directions.
+    template < class F, class G, class CheckF, class CheckG, class IndexedArg, int n, bool withD2 >
+    struct D1D2Set< MathematicalOperations::Chain< F, G, CheckF, CheckG >, IndexedArg, n, withD2 >
+    {
+    private:
+        using FArg = decltype( std::declval< G >()() );
+        using IndexedFArg = IndexedType< FArg, IndexedArg::index >;
+        using Inner = D1D2Set< G, IndexedArg, n, withD2 >;
+
+    public:
+        using D1Entry =
+            Detail::Stored< ComputeChainD1< F, typename Inner::D1Entry, IndexedFArg > >;
+        using D2Entry = Detail::Stored<
+            ComputeSum< ComputeChainD2< F, typename Inner::D1Entry, typename Inner::D1Entry,
+                                        IndexedFArg, IndexedFArg >,
+                        ComputeChainD1< F, typename Inner::D2Entry, IndexedFArg > > >;
+
+        D1D2Set( const MathematicalOperations::Chain< F, G, CheckF, CheckG >& h,
+                 const std::array< typename IndexedArg::type, n >& dx )
+        {
+            const Inner inner( h.g, dx );
+            for ( int k = 0; k < n; ++k )
+                d1[ k ] = D1Entry( chain< IndexedFArg >( h.f, inner.d1[ k ] ) );
+            if ( withD2 )
+                for ( int k = 0; k < n; ++k )
+                    for ( int l = k; l < n; ++l )
+                    {
+                        const auto i = packedIndex( k, l, n );
+                        d2[ i ] = D2Entry( sum( chain< IndexedFArg, IndexedFArg >(
+                                                    h.f, inner.d1[ k ], inner.d1[ l ] ),
+                                                chain< IndexedFArg >( h.f, inner.d2[ i ] ) ) );
+                    }
+        }
+
+        std::array< D1Entry, n > d1;
+        std::array< D2Entry, withD2 ? packedSize( n ) : 0 > d2;
+    };
+    /// @endcond
+
+#ifndef FUNG_REFERENCE_STORAGE
+    /// @cond
+    /// The state of the outer function is computed from the value of the inner function.
+    template < class F, class G, class CheckF, class CheckG, class Arg >
+    class NodeState< MathematicalOperations::Chain< F, G, CheckF, CheckG >, Arg >
+    {
+        using Node = MathematicalOperations::Chain< F, G, CheckF, CheckG >;
+        using FArg = decay_t< decltype( std::declval< G >()() ) >;
+
+    public:
+        template < int k >
+        NodeState( const Node& h, const Arg& x, EvaluationOrder< k > order )
+            : g( h.g, x, order ), f( h.f, g.value( h.g ), order )
+        {
+        }
+
+        decltype( auto ) value( const Node& h ) const
+        {
+            return f.value( h.f );
+        }
+
+        auto bind( const Node& h ) const
+        {
+            return MathematicalOperations::Chain< decltype( f.bind( h.f ) ),
+                                                  decltype( g.bind( h.g ) ) >(
+                Detail::BindTag(), f.bind( h.f ), g.bind( h.g ) );
+        }
+
+    private:
+        NodeState< G, Arg > g;
+        NodeState< F, FArg > f;
+    };
+    /// @endcond
+#endif
 } // namespace FunG
@@ -13,6 +13,14 @@
 
 namespace FunG
 {
+    /// @cond
+    namespace Detail
+    {
+        template < class >
+        struct ProfileTree;
+    }
+    /// @endcond
+
     namespace MathematicalOperations
     {
         /**
@@ -72,6 +80,15 @@ namespace FunG
                 value = f().dot( g() );
             }
 
+            /// Update point of evaluation. Only derivatives up to order k will be evaluated.
+            template < class Arg, int k >
+            void update( Arg const& x, EvaluationOrder< k > order )
+            {
+                update_if_present( f, x, order );
+                update_if_present( g, x, order );
+                value = f().dot( g() );
+            }
+
             /// Update variable corresponding to index.
             template < int index, class Arg >
             void update( const Arg& x )
@@ -82,7 +99,7 @@ namespace FunG
             }
 
             /// Function value.
-            constexpr decltype( auto ) d0() const noexcept
+            constexpr const auto& d0() const noexcept
             {
                 return value;
             }
@@ -150,6 +167,9 @@ namespace FunG
                               D3< G, IndexedArgX, IndexedArgY, IndexedArgZ >( g, dx, dy, dz ) ) )();
             }
 
+            template < class >
+            friend struct FunG::Detail::ProfileTree;
+
         private:
             F f;
             G g;
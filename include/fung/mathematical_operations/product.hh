@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <type_traits>
 #include <utility>
 
@@ -7,12 +8,23 @@
 #include <fung/util/chainer.hh>
 #include <fung/util/compute_product.hh>
 #include <fung/util/compute_sum.hh>
+#include <fung/util/derivative_cache.hh>
 #include <fung/util/derivative_wrappers.hh>
 #include <fung/util/evaluate_if_present.hh>
+#include <fung/util/fused_derivatives.hh>
 #include <fung/util/indexed_type.hh>
+#include <fung/util/node_state.hh>
 
 namespace FunG
 {
+    /// @cond
+    namespace Detail
+    {
+        template < class >
+        struct ProfileTree;
+    }
+    /// @endcond
+
     namespace MathematicalOperations
     {
         /**
@@ -23,9 +35,20 @@ namespace FunG
         template < class F, class G, class = Concepts::FunctionConceptCheck< F >,
                    class = Concepts::FunctionConceptCheck< G > >
         struct Product : Chainer< Product< F, G, Concepts::FunctionConceptCheck< F >,
-                                           Concepts::FunctionConceptCheck< G > > >
+                                           Concepts::FunctionConceptCheck< G > > >,
+                         Detail::DerivativeCaches< decay_t< decltype( std::declval< F >()() ) >,
+                                                   decay_t< decltype( std::declval< G >()() ) > >
         {
         private:
+            using Caches = Detail::DerivativeCaches< decay_t< decltype( std::declval< F >()() ) >,
+                                                     decay_t< decltype( std::declval< G >()() ) > >;
+
+            template < class IndexedArg >
+            using DF1 = Detail::CachedD1< F, IndexedArg, Detail::CacheType< Caches, 0 > >;
+
+            template < class IndexedArg >
+            using DG1 = Detail::CachedD1< G, IndexedArg, Detail::CacheType< Caches, 1 > >;
+
             template < class IndexedArg >
             using D1Type = ComputeSum< ComputeProduct< D1< F, IndexedArg >, D0< G > >,
                                        ComputeProduct< D0< F >, D1< G, IndexedArg > > >;
@@ -61,19 +84,39 @@ namespace FunG
             {
             }
 
+            /// Constructor for the evaluation of a NodeState, does not compute the value.
+            template < class InitF, class InitG, class Value >
+            constexpr Product( Detail::BindTag, InitF&& f_, InitG&& g_, Value&& value_ )
+                : f( std::forward< InitF >( f_ ) ), g( std::forward< InitG >( g_ ) ),
+                  value( std::forward< Value >( value_ ) )
+            {
+            }
+
             /// Update point of evaluation.
             template < class Arg >
             void update( Arg const& x )
             {
+                this->clearCaches();
                 update_if_present( f, x );
                 update_if_present( g, x );
                 value = multiply_via_traits( f(), g() );
             }
 
+            /// Update point of evaluation. Only derivatives up to order k will be evaluated.
+            template < class Arg, int k >
+            void update( Arg const& x, EvaluationOrder< k > order )
+            {
+                this->clearCaches();
+                update_if_present( f, x, order );
+                update_if_present( g, x, order );
+                value = multiply_via_traits( f(), g() );
+            }
+
             /// Update variable corresponding to index.
             template < int index, class Arg >
             void update( const Arg& x )
             {
+                this->clearCaches();
                 update_if_present< index >( f, x );
                 update_if_present< index >( g, x );
                 value = multiply_via_traits( f(), g() );
@@ -82,13 +125,14 @@ namespace FunG
             template < class... IndexedArgs >
             void bulk_update( IndexedArgs&&... args )
             {
+                this->clearCaches();
                 bulk_update_if_present( f, args... );
                 bulk_update_if_present( g, std::forward< IndexedArgs >( args )... );
                 value = multiply_via_traits( f(), g() );
             }
 
             /// Function value.
-            constexpr decltype( auto ) d0() const noexcept
+            constexpr const auto& d0() const noexcept
             {
                 return value;
             }
@@ -118,8 +162,10 @@ namespace FunG
             {
                 return sum(
                     product( D2< F, IndexedArgX, IndexedArgY >( f, dx, dy ), D0< G >( g ) ),
-                    product( D1< F, IndexedArgX >( f, dx ), D1< G, IndexedArgY >( g, dy ) ),
-                    product( D1< F, IndexedArgY >( f, dy ), D1< G, IndexedArgX >( g, dx ) ),
+                    product( DF1< IndexedArgX >( f, dx, this->template cache< 0 >() ),
+                             DG1< IndexedArgY >( g, dy, this->template cache< 1 >() ) ),
+                    product( DF1< IndexedArgY >( f, dy, this->template cache< 0 >() ),
+                             DG1< IndexedArgX >( g, dx, this->template cache< 1 >() ) ),
                     product( D0< F >( f ), D2< G, IndexedArgX, IndexedArgY >( g, dx, dy ) ) )();
             }
 
@@ -141,21 +187,33 @@ namespace FunG
                     product( D3< F, IndexedArgX, IndexedArgY, IndexedArgZ >( f, dx, dy, dz ),
                              D0< G >( g ) ),
                     product( D2< F, IndexedArgX, IndexedArgY >( f, dx, dy ),
-                             D1< G, IndexedArgZ >( g, dz ) ),
+                             DG1< IndexedArgZ >( g, dz, this->template cache< 1 >() ) ),
                     product( D2< F, IndexedArgX, IndexedArgZ >( f, dx, dz ),
-                             D1< G, IndexedArgY >( g, dy ) ),
-                    product( D1< F, IndexedArgX >( f, dx ),
+                             DG1< IndexedArgY >( g, dy, this->template cache< 1 >() ) ),
+                    product( DF1< IndexedArgX >( f, dx, this->template cache< 0 >() ),
                              D2< G, IndexedArgY, IndexedArgZ >( g, dy, dz ) ),
                     product( D2< F, IndexedArgY, IndexedArgZ >( f, dy, dz ),
-                             D1< G, IndexedArgX >( g, dx ) ),
-                    product( D1< F, IndexedArgY >( f, dy ),
+                             DG1< IndexedArgX >( g, dx, this->template cache< 1 >() ) ),
+                    product( DF1< IndexedArgY >( f, dy, this->template cache< 0 >() ),
                              D2< G, IndexedArgX, IndexedArgZ >( g, dx, dz ) ),
-                    product( D1< F, IndexedArgZ >( f, dz ),
+                    product( DF1< IndexedArgZ >( f, dz, this->template cache< 0 >() ),
                              D2< G, IndexedArgX, IndexedArgY >( g, dx, dy ) ),
                     product( D0< F >( f ),
                              D3< G, IndexedArgX, IndexedArgY, IndexedArgZ >( g, dx, dy, dz ) ) )();
             }
 
+            template < class, class, class, bool >
+            friend struct FunG::D1D2;
+
+            template < class, class, int, bool >
+            friend struct FunG::D1D2Set;
+
+            template < class >
+            friend struct FunG::Detail::ProfileTree;
+
+            template < class, class, class >
+            friend class FunG::NodeState;
+
         private:
             F f;
             G g;
@@ -164,4 +222,125 @@ namespace FunG
                 value;
         };
     } // namespace MathematicalOperations
+
+    /// @cond
+    /// First derivatives of both factors enter both derivatives of the product.
+    template < class F, class G, class CheckF, class CheckG, class IndexedArgX, class IndexedArgY,
+               bool withD1Y >
+    struct D1D2< MathematicalOperations::Product< F, G, CheckF, CheckG >, IndexedArgX, IndexedArgY,
+                 withD1Y >
+    {
+    private:
+        using FD = D1D2< F, IndexedArgX, IndexedArgY >;
+        using GD = D1D2< G, IndexedArgX, IndexedArgY >;
+        using D1YType = ComputeSum< ComputeProduct< decltype( FD::d1y ), D0< G > >,
+                                    ComputeProduct< D0< F >, decltype( GD::d1y ) > >;
+
+        FD fd;
+        GD gd;
+        D0< F > f0;
+        D0< G > g0;
+
+    public:
+        D1D2( const MathematicalOperations::Product< F, G, CheckF, CheckG >& h,
+              const typename IndexedArgX::type& dx, const typename IndexedArgY::type& dy )
+            : fd( h.f, dx, dy ), gd( h.g, dx, dy ), f0( h.f ), g0( h.g ),
+              d1x( product( fd.d1x, g0 ), product( f0, gd.d1x ) ),
+              d1y( Detail::makeIf< withD1Y >( [this] {
+                  return D1YType( product( fd.d1y, g0 ), product( f0, gd.d1y ) );
+              } ) ),
+              d2xy( product( fd.d2xy, g0 ), product( fd.d1x, gd.d1y ), product( fd.d1y, gd.d1x ),
+                    product( f0, gd.d2xy ) )
+        {
+        }
+
+        ComputeSum< ComputeProduct< decltype( FD::d1x ), D0< G > >,
+                    ComputeProduct< D0< F >, decltype( GD::d1x ) > >
+            d1x;
+        std::conditional_t< withD1Y, D1YType, Detail::NotRequested > d1y;
+        ComputeSum< ComputeProduct< decltype( FD::d2xy ), D0< G > >,
+                    ComputeProduct< decltype( FD::d1x ), decltype( GD::d1y ) >,
+                    ComputeProduct< decltype( FD::d1y ), decltype( GD::d1x ) >,
+                    ComputeProduct< D0< F >, decltype( GD::d2xy ) > >
+            d2xy;
+    };
+    /// @endcond
+
+    /// @cond
+    /// First derivatives of both factors are computed once per direction.
+    template < class F, class G, class CheckF, class CheckG, class IndexedArg, int n, bool withD2 >
+    struct D1D2Set< MathematicalOperations::Product< F, G, CheckF, CheckG >, IndexedArg, n,
+                    withD2 >
+    {
+    private:
+        using FD = D1D2Set< F, IndexedArg, n, withD2 >;
+        using GD = D1D2Set< G, IndexedArg, n, withD2 >;
+
+    public:
+        using D1Entry =
+            Detail::Stored< ComputeSum< ComputeProduct< typename FD::D1Entry, D0< G > >,
+                                        ComputeProduct< D0< F >, typename GD::D1Entry > > >;
+        using D2Entry = Detail::Stored<
+            ComputeSum< ComputeProduct< typename FD::D2Entry, D0< G > >,
+                        ComputeProduct< typename FD::D1Entry, typename GD::D1Entry >,
+                        ComputeProduct< typename FD::D1Entry, typename GD::D1Entry >,
+                        ComputeProduct< D0< F >, typename GD::D2Entry > > >;
+
+        D1D2Set( const MathematicalOperations::Product< F, G, CheckF, CheckG >& h,
+                 const std::array< typename IndexedArg::type, n >& dx )
+        {
+            const FD fd( h.f, dx );
+            const GD gd( h.g, dx );
+            const D0< F > f0( h.f );
+            const D0< G > g0( h.g );
+            for ( int k = 0; k < n; ++k )
+                d1[ k ] = D1Entry( sum( product( fd.d1[ k ], g0 ), product( f0, gd.d1[ k ] ) ) );
+            if ( withD2 )
+                for ( int k = 0; k < n; ++k )
+                    for ( int l = k; l < n; ++l )
+                    {
+                        const auto i = packedIndex( k, l, n );
+                        d2[ i ] = D2Entry(
+                            sum( product( fd.d2[ i ], g0 ), product( fd.d1[ k ], gd.d1[ l ] ),
+                                 product( fd.d1[ l ], gd.d1[ k ] ), product( f0, gd.d2[ i ] ) ) );
+                    }
+        }
+
+        std::array< D1Entry, n > d1;
+        std::array< D2Entry, withD2 ? packedSize( n ) : 0 > d2;
+    };
+    /// @endcond
+
+    /// @cond
+    template < class F, class G, class CheckF, class CheckG, class Arg >
+    class NodeState< MathematicalOperations::Product< F, G, CheckF, CheckG >, Arg >
+    {
+        using Node = MathematicalOperations::Product< F, G, CheckF, CheckG >;
+
+    public:
+        template < int k >
+        NodeState( const Node& h, const Arg& x, EvaluationOrder< k > order )
+            : f( h.f, x, order ), g( h.g, x, order ),
+              productValue( multiply_via_traits( f.value( h.f ), g.value( h.g ) ) )
+        {
+        }
+
+        const auto& value( const Node& ) const noexcept
+        {
+            return productValue;
+        }
+
+        auto bind( const Node& h ) const
+        {
+            return MathematicalOperations::Product< decltype( f.bind( h.f ) ),
+                                                    decltype( g.bind( h.g ) ) >(
+                Detail::BindTag(), f.bind( h.f ), g.bind( h.g ), productValue );
+        }
+
+    private:
+        NodeState< F, Arg > f;
+        NodeState< G, Arg > g;
+        decltype( Node::value ) productValue;
+    };
+    /// @endcond
 } // namespace FunG
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <type_traits>
 #include <utility>
 
@@ -7,11 +8,21 @@
 #include <fung/util/chainer.hh>
 #include <fung/util/derivative_wrappers.hh>
 #include <fung/util/evaluate_if_present.hh>
+#include <fung/util/fused_derivatives.hh>
 #include <fung/util/indexed_type.hh>
 #include <fung/util/mathop_traits.hh>
+#include <fung/util/node_state.hh>
 
 namespace FunG
 {
+    /// @cond
+    namespace Detail
+    {
+        template < class >
+        struct ProfileTree;
+    }
+    /// @endcond
+
     namespace MathematicalOperations
     {
         /**
@@ -34,6 +45,14 @@ namespace FunG
             {
             }
 
+            /// Constructor for the evaluation of a NodeState, does not compute the value.
+            template < class InitF, class Value >
+            constexpr Scale( Detail::BindTag, Scalar a_, InitF&& f_, Value&& value_ )
+                : a( a_ ), f( std::forward< InitF >( f_ ) ),
+                  value( std::forward< Value >( value_ ) )
+            {
+            }
+
             /// Update point of evaluation.
             template < class Arg >
             void update( const Arg& x )
@@ -42,6 +61,14 @@ namespace FunG
                 value = multiply_via_traits( a, f() );
             }
 
+            /// Update point of evaluation. Only derivatives up to order k will be evaluated.
+            template < class Arg, int k >
+            void update( const Arg& x, EvaluationOrder< k > order )
+            {
+                update_if_present( f, x, order );
+                value = multiply_via_traits( a, f() );
+            }
+
             /// Update variable corresponding to index.
             template < int index, class Arg >
             void update( const Arg& x )
@@ -58,7 +85,7 @@ namespace FunG
             }
 
             /// Function value.
-            constexpr decltype( auto ) d0() const noexcept
+            constexpr const auto& d0() const noexcept
             {
                 return value;
             }
@@ -95,10 +122,106 @@ namespace FunG
                     a, D3_< F, IndexedArgX, IndexedArgY, IndexedArgZ >::apply( f, dx, dy, dz ) );
             }
 
+            template < class, class, class, bool >
+            friend struct FunG::D1D2;
+
+            template < class, class, int, bool >
+            friend struct FunG::D1D2Set;
+
+            template < class >
+            friend struct FunG::Detail::ProfileTree;
+
+            template < class, class, class >
+            friend class FunG::NodeState;
+
         private:
             Scalar a = 1.;
             F f;
             std::decay_t< decltype( std::declval< F >()() ) > value;
         };
     } // namespace MathematicalOperations
+
+    /// @cond
+    template < class Scalar, class F, class CheckF, class IndexedArgX, class IndexedArgY,
+               bool withD1Y >
+    struct D1D2< MathematicalOperations::Scale< Scalar, F, CheckF >, IndexedArgX, IndexedArgY,
+                 withD1Y >
+    {
+    private:
+        using FD = D1D2< F, IndexedArgX, IndexedArgY, withD1Y >;
+
+        FD fd;
+
+    public:
+        D1D2( const MathematicalOperations::Scale< Scalar, F, CheckF >& h,
+              const typename IndexedArgX::type& dx, const typename IndexedArgY::type& dy )
+            : fd( h.f, dx, dy ), d1x( h.a, fd.d1x ), d1y( h.a, fd.d1y ), d2xy( h.a, fd.d2xy )
+        {
+        }
+
+        Detail::ComputeScaled< Scalar, decltype( FD::d1x ) > d1x;
+        std::conditional_t< withD1Y, Detail::ComputeScaled< Scalar, decltype( FD::d1y ) >,
+                            Detail::NotRequested >
+            d1y;
+        Detail::ComputeScaled< Scalar, decltype( FD::d2xy ) > d2xy;
+    };
+    /// @endcond
+
+    /// @cond
+    template < class Scalar, class F, class CheckF, class IndexedArg, int n, bool withD2 >
+    struct D1D2Set< MathematicalOperations::Scale< Scalar, F, CheckF >, IndexedArg, n, withD2 >
+    {
+    private:
+        using FD = D1D2Set< F, IndexedArg, n, withD2 >;
+
+    public:
+        using D1Entry = Detail::Stored< Detail::ComputeScaled< Scalar, typename FD::D1Entry > >;
+        using D2Entry = Detail::Stored< Detail::ComputeScaled< Scalar, typename FD::D2Entry > >;
+
+        D1D2Set( const MathematicalOperations::Scale< Scalar, F, CheckF >& h,
+                 const std::array< typename IndexedArg::type, n >& dx )
+        {
+            const FD fd( h.f, dx );
+            for ( int k = 0; k < n; ++k )
+                d1[ k ] = D1Entry( Detail::ComputeScaled< Scalar, typename FD::D1Entry >(
+                    h.a, fd.d1[ k ] ) );
+            for ( auto i = 0u; i < d2.size(); ++i )
+                d2[ i ] = D2Entry( Detail::ComputeScaled< Scalar, typename FD::D2Entry >(
+                    h.a, fd.d2[ i ] ) );
+        }
+
+        std::array< D1Entry, n > d1;
+        std::array< D2Entry, withD2 ? packedSize( n ) : 0 > d2;
+    };
+    /// @endcond
+
+    /// @cond
+    template < class Scalar, class F, class CheckF, class Arg >
+    class NodeState< MathematicalOperations::Scale< Scalar, F, CheckF >, Arg >
+    {
+        using Node = MathematicalOperations::Scale< Scalar, F, CheckF >;
+
+    public:
+        template < int k >
+        NodeState( const Node& h, const Arg& x, EvaluationOrder< k > order )
+            : f( h.f, x, order ), scaledValue( multiply_via_traits( h.a, f.value( h.f ) ) )
+        {
+        }
+
+        const auto& value( const Node& ) const noexcept
+        {
+            return scaledValue;
+        }
+
+        auto bind( const Node& h ) const
+        {
+            return MathematicalOperations::Scale< Scalar, decltype( f.bind( h.f ) ) >(
+                Detail::BindTag(), h.a, f.bind( h.f ), scaledValue );
+        }
+
+    private:
+        NodeState< F, Arg > f;
+        decltype( Node::value ) scaledValue;
+    };
+    /// @endcond
 } // namespace FunG
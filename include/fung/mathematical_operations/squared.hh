@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <type_traits>
 #include <utility>
 
@@ -7,14 +8,25 @@
 #include <fung/util/chainer.hh>
 #include <fung/util/compute_product.hh>
 #include <fung/util/compute_sum.hh>
+#include <fung/util/derivative_cache.hh>
 #include <fung/util/derivative_wrappers.hh>
 #include <fung/util/evaluate_if_present.hh>
+#include <fung/util/fused_derivatives.hh>
 #include <fung/util/indexed_type.hh>
 #include <fung/util/mathop_traits.hh>
+#include <fung/util/node_state.hh>
 #include <fung/util/type_traits.hh>
 
 namespace FunG
 {
+    /// @cond
+    namespace Detail
+    {
+        template < class >
+        struct ProfileTree;
+    }
+    /// @endcond
+
     namespace MathematicalOperations
     {
         /**
@@ -22,9 +34,15 @@ namespace FunG
          * @brief %Squared function \f$f^2\f$.
          */
         template < class F, class = Concepts::FunctionConceptCheck< F > >
-        struct Squared : Chainer< Squared< F, Concepts::FunctionConceptCheck< F > > >
+        struct Squared : Chainer< Squared< F, Concepts::FunctionConceptCheck< F > > >,
+                         Detail::DerivativeCaches< decay_t< decltype( std::declval< F >()() ) > >
         {
         private:
+            using Caches = Detail::DerivativeCaches< decay_t< decltype( std::declval< F >()() ) > >;
+
+            template < class IndexedArg >
+            using DF1 = Detail::CachedD1< F, IndexedArg, Detail::CacheType< Caches, 0 > >;
+
             template < class IndexedArgX, class IndexedArgY >
             using D2Sum =
                 ComputeSum< ComputeProduct< D0< F >, D2< F, IndexedArgX, IndexedArgY > >,
@@ -50,18 +68,36 @@ namespace FunG
             {
             }
 
+            /// Constructor for the evaluation of a NodeState, does not compute the value.
+            template < class InitF, class Value >
+            constexpr Squared( Detail::BindTag, InitF&& f_, Value&& value_ )
+                : f( std::forward< InitF >( f_ ) ), value( std::forward< Value >( value_ ) )
+            {
+            }
+
             /// Update point of evaluation.
             template < class Arg >
             void update( Arg const& x )
             {
+                this->clearCaches();
                 update_if_present( f, x );
                 value = multiply_via_traits( f(), f() );
             }
 
+            /// Update point of evaluation. Only derivatives up to order k will be evaluated.
+            template < class Arg, int k >
+            void update( Arg const& x, EvaluationOrder< k > order )
+            {
+                this->clearCaches();
+                update_if_present( f, x, order );
+                value = multiply_via_traits( f(), f() );
+            }
+
             /// Update variable corresponding to index.
             template < int index, class Arg >
             void update( const Arg& x )
             {
+                this->clearCaches();
                 update_if_present< index >( f, x );
                 value = multiply_via_traits( f(), f() );
             }
@@ -69,12 +105,13 @@ namespace FunG
             template < class... IndexedArgs >
             void bulk_update( IndexedArgs&&... args )
             {
+                this->clearCaches();
                 bulk_update_if_present( f, std::forward< IndexedArgs >( args )... );
                 value = multiply_via_traits( f(), f() );
             }
 
             /// Function value.
-            constexpr decltype( auto ) d0() const noexcept
+            constexpr const auto& d0() const noexcept
             {
                 return value;
             }
@@ -109,8 +146,9 @@ namespace FunG
             {
                 return multiply_via_traits(
                     2, sum( product( D0< F >( f ), D2< F, IndexedArgX, IndexedArgY >( f, dx, dy ) ),
-                            product( D1< F, IndexedArgY >( f, dy ),
-                                     D1< F, IndexedArgX >( f, dx ) ) )() );
+                            product(
+                                DF1< IndexedArgY >( f, dy, this->template cache< 0 >() ),
+                                DF1< IndexedArgX >( f, dx, this->template cache< 0 >() ) ) )() );
             }
 
             /**
@@ -132,14 +170,27 @@ namespace FunG
                 return multiply_via_traits(
                     2, sum( product( D0< F >( f ), D3< F, IndexedArgX, IndexedArgY, IndexedArgZ >(
                                                        f, dx, dy, dz ) ),
-                            product( D1< F, IndexedArgZ >( f, dz ),
+                            product( DF1< IndexedArgZ >( f, dz, this->template cache< 0 >() ),
                                      D2< F, IndexedArgX, IndexedArgY >( f, dx, dy ) ),
-                            product( D1< F, IndexedArgY >( f, dy ),
+                            product( DF1< IndexedArgY >( f, dy, this->template cache< 0 >() ),
                                      D2< F, IndexedArgX, IndexedArgZ >( f, dx, dz ) ),
-                            product( D2< F, IndexedArgY, IndexedArgZ >( f, dy, dz ),
-                                     D1< F, IndexedArgX >( f, dx ) ) )() );
+                            product(
+                                D2< F, IndexedArgY, IndexedArgZ >( f, dy, dz ),
+                                DF1< IndexedArgX >( f, dx, this->template cache< 0 >() ) ) )() );
             }
 
+            template < class, class, class, bool >
+            friend struct FunG::D1D2;
+
+            template < class, class, int, bool >
+            friend struct FunG::D1D2Set;
+
+            template < class >
+            friend struct FunG::Detail::ProfileTree;
+
+            template < class, class, class >
+            friend class FunG::NodeState;
+
         private:
             F f;
             decay_t< decltype(
@@ -147,4 +198,108 @@ namespace FunG
                 value;
         };
     } // namespace MathematicalOperations
+
+    /// @cond
+    /// The first derivatives of f enter both derivatives of its square.
+    template < class F, class CheckF, class IndexedArgX, class IndexedArgY, bool withD1Y >
+    struct D1D2< MathematicalOperations::Squared< F, CheckF >, IndexedArgX, IndexedArgY, withD1Y >
+    {
+    private:
+        using FD = D1D2< F, IndexedArgX, IndexedArgY >;
+        using D1YType =
+            Detail::ComputeScaled< int, ComputeProduct< D0< F >, decltype( FD::d1y ) > >;
+
+        FD fd;
+        D0< F > f0;
+
+    public:
+        D1D2( const MathematicalOperations::Squared< F, CheckF >& h,
+              const typename IndexedArgX::type& dx, const typename IndexedArgY::type& dy )
+            : fd( h.f, dx, dy ), f0( h.f ), d1x( 2, product( f0, fd.d1x ) ),
+              d1y( Detail::makeIf< withD1Y >(
+                  [this] { return D1YType( 2, product( f0, fd.d1y ) ); } ) ),
+              d2xy( 2, sum( product( f0, fd.d2xy ), product( fd.d1y, fd.d1x ) ) )
+        {
+        }
+
+        Detail::ComputeScaled< int, ComputeProduct< D0< F >, decltype( FD::d1x ) > > d1x;
+        std::conditional_t< withD1Y, D1YType, Detail::NotRequested > d1y;
+        Detail::ComputeScaled< int,
+                               ComputeSum< ComputeProduct< D0< F >, decltype( FD::d2xy ) >,
+                                           ComputeProduct< decltype( FD::d1y ),
+                                                           decltype( FD::d1x ) > > >
+            d2xy;
+    };
+    /// @endcond
+
+    /// @cond
+    /// The first derivatives of f are computed once per direction.
+    template < class F, class CheckF, class IndexedArg, int n, bool withD2 >
+    struct D1D2Set< MathematicalOperations::Squared< F, CheckF >, IndexedArg, n, withD2 >
+    {
+    private:
+        using FD = D1D2Set< F, IndexedArg, n, withD2 >;
+        using D1Value =
+            Detail::ComputeScaled< int, ComputeProduct< D0< F >, typename FD::D1Entry > >;
+        using D2Value = Detail::ComputeScaled<
+            int, ComputeSum< ComputeProduct< D0< F >, typename FD::D2Entry >,
+                             ComputeProduct< typename FD::D1Entry, typename FD::D1Entry > > >;
+
+    public:
+        using D1Entry = Detail::Stored< D1Value >;
+        using D2Entry = Detail::Stored< D2Value >;
+
+        D1D2Set( const MathematicalOperations::Squared< F, CheckF >& h,
+                 const std::array< typename IndexedArg::type, n >& dx )
+        {
+            const FD fd( h.f, dx );
+            const D0< F > f0( h.f );
+            for ( int k = 0; k < n; ++k )
+                d1[ k ] = D1Entry( D1Value( 2, product( f0, fd.d1[ k ] ) ) );
+            if ( withD2 )
+                for ( int k = 0; k < n; ++k )
+                    for ( int l = k; l < n; ++l )
+                    {
+                        const auto i = packedIndex( k, l, n );
+                        d2[ i ] = D2Entry( D2Value(
+                            2, sum( product( f0, fd.d2[ i ] ),
+                                    product( fd.d1[ l ], fd.d1[ k ] ) ) ) );
+                    }
+        }
+
+        std::array< D1Entry, n > d1;
+        std::array< D2Entry, withD2 ? packedSize( n ) : 0 > d2;
+    };
+    /// @endcond
+
+    /// @cond
+    template < class F, class CheckF, class Arg >
+    class NodeState< MathematicalOperations::Squared< F, CheckF >, Arg >
+    {
+        using Node = MathematicalOperations::Squared< F, CheckF >;
+
+    public:
+        template < int k >
+        NodeState( const Node& h, const Arg& x, EvaluationOrder< k > order )
+            : f( h.f, x, order ),
+              squaredValue( multiply_via_traits( f.value( h.f ), f.value( h.f ) ) )
+        {
+        }
+
+        const auto& value( const Node& ) const noexcept
+        {
+            return squaredValue;
+        }
+
+        auto bind( const Node& h ) const
+        {
+            return MathematicalOperations::Squared< decltype( f.bind( h.f ) ) >(
+                Detail::BindTag(), f.bind( h.f ), squaredValue );
+        }
+
+    private:
+        NodeState< F, Arg > f;
+        decltype( Node::value ) squaredValue;
+    };
+    /// @endcond
 } // namespace FunG
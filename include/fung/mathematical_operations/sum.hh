@@ -5,14 +5,25 @@
 #include <fung/util/compute_sum.hh>
 #include <fung/util/derivative_wrappers.hh>
 #include <fung/util/evaluate_if_present.hh>
+#include <fung/util/fused_derivatives.hh>
 #include <fung/util/indexed_type.hh>
 #include <fung/util/mathop_traits.hh>
+#include <fung/util/node_state.hh>
 
+#include <array>
 #include <type_traits>
 #include <utility>
 
 namespace FunG
 {
+    /// @cond
+    namespace Detail
+    {
+        template < class >
+        struct ProfileTree;
+    }
+    /// @endcond
+
     namespace MathematicalOperations
     {
         /**
@@ -36,6 +47,14 @@ namespace FunG
             {
             }
 
+            /// Constructor for the evaluation of a NodeState, does not compute the value.
+            template < class InitF, class InitG, class Value >
+            constexpr Sum( Detail::BindTag, InitF&& f_, InitG&& g_, Value&& value_ )
+                : f( std::forward< InitF >( f_ ) ), g( std::forward< InitG >( g_ ) ),
+                  value( std::forward< Value >( value_ ) )
+            {
+            }
+
             /// Update point of evaluation.
             template < class Arg >
             void update( Arg&& x )
@@ -45,6 +64,15 @@ namespace FunG
                 value = add_via_traits( f(), g() );
             }
 
+            /// Update point of evaluation. Only derivatives up to order k will be evaluated.
+            template < class Arg, int k >
+            void update( Arg&& x, EvaluationOrder< k > order )
+            {
+                update_if_present( f, x, order );
+                update_if_present( g, std::forward< Arg >( x ), order );
+                value = add_via_traits( f(), g() );
+            }
+
             /// Update variable corresponding to index.
             template < int index, class Arg >
             void update( Arg&& x )
@@ -63,7 +91,7 @@ namespace FunG
             }
 
             /// Function value.
-            constexpr decltype( auto ) d0() const noexcept
+            constexpr const auto& d0() const noexcept
             {
                 return value;
             }
@@ -108,6 +136,18 @@ namespace FunG
                     std::forward< ArgZ >( dz ) )();
             }
 
+            template < class, class, class, bool >
+            friend struct FunG::D1D2;
+
+            template < class, class, int, bool >
+            friend struct FunG::D1D2Set;
+
+            template < class >
+            friend struct FunG::Detail::ProfileTree;
+
+            template < class, class, class >
+            friend class FunG::NodeState;
+
         private:
             F f;
             G g;
@@ -115,4 +155,96 @@ namespace FunG
                 value;
         };
     } // namespace MathematicalOperations
+
+    /// @cond
+    template < class F, class G, class CheckF, class CheckG, class IndexedArgX, class IndexedArgY,
+               bool withD1Y >
+    struct D1D2< MathematicalOperations::Sum< F, G, CheckF, CheckG >, IndexedArgX, IndexedArgY,
+                 withD1Y >
+    {
+    private:
+        using FD = D1D2< F, IndexedArgX, IndexedArgY, withD1Y >;
+        using GD = D1D2< G, IndexedArgX, IndexedArgY, withD1Y >;
+
+        FD fd;
+        GD gd;
+
+    public:
+        D1D2( const MathematicalOperations::Sum< F, G, CheckF, CheckG >& h,
+              const typename IndexedArgX::type& dx, const typename IndexedArgY::type& dy )
+            : fd( h.f, dx, dy ), gd( h.g, dx, dy ), d1x( fd.d1x, gd.d1x ), d1y( fd.d1y, gd.d1y ),
+              d2xy( fd.d2xy, gd.d2xy )
+        {
+        }
+
+        ComputeSum< decltype( FD::d1x ), decltype( GD::d1x ) > d1x;
+        std::conditional_t< withD1Y, ComputeSum< decltype( FD::d1y ), decltype( GD::d1y ) >,
+                            Detail::NotRequested >
+            d1y;
+        ComputeSum< decltype( FD::d2xy ), decltype( GD::d2xy ) > d2xy;
+    };
+    /// @endcond
+
+    /// @cond
+    template < class F, class G, class CheckF, class CheckG, class IndexedArg, int n, bool withD2 >
+    struct D1D2Set< MathematicalOperations::Sum< F, G, CheckF, CheckG >, IndexedArg, n, withD2 >
+    {
+    private:
+        using FD = D1D2Set< F, IndexedArg, n, withD2 >;
+        using GD = D1D2Set< G, IndexedArg, n, withD2 >;
+
+    public:
+        using D1Entry =
+            Detail::Stored< ComputeSum< typename FD::D1Entry, typename GD::D1Entry > >;
+        using D2Entry =
+            Detail::Stored< ComputeSum< typename FD::D2Entry, typename GD::D2Entry > >;
+
+        D1D2Set( const MathematicalOperations::Sum< F, G, CheckF, CheckG >& h,
+                 const std::array< typename IndexedArg::type, n >& dx )
+        {
+            const FD fd( h.f, dx );
+            const GD gd( h.g, dx );
+            for ( int k = 0; k < n; ++k )
+                d1[ k ] = D1Entry( sum( fd.d1[ k ], gd.d1[ k ] ) );
+            for ( auto i = 0u; i < d2.size(); ++i )
+                d2[ i ] = D2Entry( sum( fd.d2[ i ], gd.d2[ i ] ) );
+        }
+
+        std::array< D1Entry, n > d1;
+        std::array< D2Entry, withD2 ? packedSize( n ) : 0 > d2;
+    };
+    /// @endcond
+
+    /// @cond
+    template < class F, class G, class CheckF, class CheckG, class Arg >
+    class NodeState< MathematicalOperations::Sum< F, G, CheckF, CheckG >, Arg >
+    {
+        using Node = MathematicalOperations::Sum< F, G, CheckF, CheckG >;
+
+    public:
+        template < int k >
+        NodeState( const Node& h, const Arg& x, EvaluationOrder< k > order )
+            : f( h.f, x, order ), g( h.g, x, order ),
+              sumValue( add_via_traits( f.value( h.f ), g.value( h.g ) ) )
+        {
+        }
+
+        const auto& value( const Node& ) const noexcept
+        {
+            return sumValue;
+        }
+
+        auto bind( const Node& h ) const
+        {
+            return MathematicalOperations::Sum< decltype( f.bind( h.f ) ),
+                                                decltype( g.bind( h.g ) ) >(
+                Detail::BindTag(), f.bind( h.f ), g.bind( h.g ), sumValue );
+        }
+
+    private:
+        NodeState< F, Arg > f;
+        NodeState< G, Arg > g;
+        decltype( Node::value ) sumValue;
+    };
+    /// @endcond
 } // namespace FunG
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <fung/batch.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace FunG
+{
+    /// @cond
+    namespace BatchDetail
+    {
+        /// Evaluates chunks of blockSize points until no chunk is left, using a private copy of f.
+        template < int order, class F, class Arg >
+        class Worker
+        {
+        public:
+            Worker( const F& f_, const Batch< Arg >& x_, BatchResult< Arg >& result_,
+                    std::atomic< std::size_t >& nextChunk_, std::exception_ptr& error_,
+                    std::mutex& errorMutex_ )
+                : f( f_ ), x( x_ ), result( result_ ), nextChunk( nextChunk_ ), error( error_ ),
+                  errorMutex( errorMutex_ )
+            {
+            }
+
+            void operator()()
+            {
+                try
+                {
+                    F g( f );
+                    const auto n = x.size();
+                    for ( auto begin = nextChunk++ * blockSize; begin < n;
+                          begin = nextChunk++ * blockSize )
+                        evaluate< order >( g, x, result, begin, std::min( begin + blockSize, n ) );
+                }
+                catch ( ... )
+                {
+                    std::lock_guard< std::mutex > lock( errorMutex );
+                    if ( !error )
+                        error = std::current_exception();
+                }
+            }
+
+        private:
+            const F& f;
+            const Batch< Arg >& x;
+            BatchResult< Arg >& result;
+            std::atomic< std::size_t >& nextChunk;
+            std::exception_ptr& error;
+            std::mutex& errorMutex;
+        };
+    }
+    /// @endcond
+
+    /**
+     * @brief Evaluate f and its derivatives up to order 'order' for all points of a batch, using
+     * several threads.
+     *
+     * Finalized functions store intermediate results in update and can thus not be shared between
+     * threads. Instead, each thread evaluates a private copy of f. Points are processed in chunks
+     * of BatchDetail::blockSize points, that are assigned to the threads on demand. The result is
+     * resized before the threads are started, thus each thread only writes to the entries of its
+     * chunks. Reusing the same result object for subsequent calls avoids memory allocations, except
+     * for the copies of f and the threads.
+     *
+     * If the evaluation throws (see FUNG_ENABLE_EXCEPTIONS), the remaining threads still finish
+     * their work and the first exception is rethrown in the calling thread. The values in result
+     * are unspecified in this case. If a thread can not be started, the threads that are already
+     * running are joined and the std::system_error is rethrown.
+     *
+     * The calling thread takes part in the evaluation. Linking against the threads library of your
+     * platform may be required.
+     *
+     * @param f finalized function, i.e. the return type of finalize( ... ), is not modified
+     * @param x points of evaluation
+     * @param result values and derivatives at all points of evaluation
+     * @param numberOfThreads number of threads, if 0 then std::thread::hardware_concurrency() is
+     * used
+     * @tparam order highest order of computed derivatives (0,1 or 2)
+     */
+    template < int order = 2, class F, class Arg >
+    void parallel_evaluate( const F& f, const Batch< Arg >& x, BatchResult< Arg >& result,
+                            unsigned numberOfThreads = 0 )
+    {
+        BatchDetail::prepare< order >( result, x.size() );
+
+        if ( numberOfThreads == 0 )
+            numberOfThreads = std::max( std::thread::hardware_concurrency(), 1u );
+        const auto numberOfChunks =
+            ( x.size() + BatchDetail::blockSize - 1 ) / BatchDetail::blockSize;
+        numberOfThreads = static_cast< unsigned >(
+            std::max< std::size_t >( std::min< std::size_t >( numberOfThreads, numberOfChunks ),
+                                     1 ) );
+
+        std::atomic< std::size_t > nextChunk( 0 );
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        BatchDetail::Worker< order, F, Arg > worker( f, x, result, nextChunk, error, errorMutex );
+
+        std::vector< std::thread > threads;
+        threads.reserve( numberOfThreads - 1 );
+        try
+        {
+            for ( auto i = 1u; i < numberOfThreads; ++i )
+                threads.emplace_back( worker );
+        }
+        catch ( ... )
+        {
+            // destroying joinable threads calls std::terminate
+            for ( auto& thread : threads )
+                thread.join();
+            throw;
+        }
+        worker();
+        for ( auto& thread : threads )
+            thread.join();
+
+        if ( error )
+            std::rethrow_exception( error );
+    }
+
+    /**
+     * @brief Evaluate f and its derivatives up to order 'order' for all points of a batch, using
+     * several threads.
+     * @param f finalized function, i.e. the return type of finalize( ... ), is not modified
+     * @param x points of evaluation
+     * @param numberOfThreads number of threads, if 0 then std::thread::hardware_concurrency() is
+     * used
+     * @tparam order highest order of computed derivatives (0,1 or 2)
+     * @return values and derivatives at all points of evaluation, see BatchResult
+     */
+    template < int order = 2, class F, class Arg >
+    BatchResult< Arg > parallel_evaluate( const F& f, const Batch< Arg >& x,
+                                          unsigned numberOfThreads = 0 )
+    {
+        BatchResult< Arg > result;
+        parallel_evaluate< order >( f, x, result, numberOfThreads );
+        return result;
+    }
+}
@@ -0,0 +1,441 @@
+#pragma once
+
+#include <fung/finalize.hh>
+#include <fung/mathematical_operations/chain.hh>
+#include <fung/mathematical_operations/dot.hh>
+#include <fung/mathematical_operations/product.hh>
+#include <fung/mathematical_operations/scale.hh>
+#include <fung/mathematical_operations/squared.hh>
+#include <fung/mathematical_operations/sum.hh>
+#include <fung/util/chainer.hh>
+#include <fung/util/derivative_wrappers.hh>
+#include <fung/util/evaluate_if_present.hh>
+#include <fung/util/evaluation_order.hh>
+#include <fung/util/indexed_type.hh>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+
+namespace FunG
+{
+    /// Operations that are recorded by Profiled.
+    enum class ProfiledOperation
+    {
+        update,
+        d0,
+        d1,
+        d2,
+        d3
+    };
+
+    /// Number of calls and cumulative time of one operation of one node.
+    struct ProfileCounter
+    {
+        std::uint64_t calls = 0;
+        std::uint64_t ticks = 0;
+    };
+
+    /// Counters of one node of a profiled function.
+    struct ProfileRecord
+    {
+        /// Node type without the types of its operands, e.g. Sum or Pow<2, 1>.
+        std::string node;
+        /// Depth in the expression tree, 0 for the root.
+        int depth;
+        /// Counters for update, d0, d1, d2 and d3 (see ProfiledOperation).
+        std::array< ProfileCounter, 5 > counters;
+
+        const ProfileCounter& operator[]( ProfiledOperation op ) const
+        {
+            return counters[ static_cast< int >( op ) ];
+        }
+
+        ProfileCounter& operator[]( ProfiledOperation op )
+        {
+            return counters[ static_cast< int >( op ) ];
+        }
+    };
+
+    /**
+     * @brief Records of all nodes of a profiled function, in depth-first order.
+     *
+     * Times are measured in cycles with the time stamp counter on x86 and in nanoseconds else.
+     * They are inclusive, i.e. the time of a node contains the time spent in its operands.
+     */
+    class Profile
+    {
+    public:
+        /// Add record for a node at the specified depth. References to records stay valid.
+        ProfileRecord& add( std::string node, int depth )
+        {
+            records_.push_back( ProfileRecord{std::move( node ), depth, {}} );
+            return records_.back();
+        }
+
+        const std::deque< ProfileRecord >& records() const noexcept
+        {
+            return records_;
+        }
+
+        /// Set all counters to zero.
+        void reset()
+        {
+            for ( auto& record : records_ )
+                record.counters = {};
+        }
+
+        /// Print calls and times per node and operation, operands are indented.
+        void report( std::ostream& os ) const
+        {
+            std::size_t width = 4;
+            for ( const auto& record : records_ )
+                width = std::max( width, 2 * record.depth + record.node.size() );
+
+            const char* names[] = {"update", "d0", "d1", "d2", "d3"};
+            os << std::left << std::setw( width + 2 ) << "node";
+            for ( auto name : names )
+                os << std::right << std::setw( 10 ) << name << std::setw( 14 ) << unit();
+            os << '\n';
+
+            for ( const auto& record : records_ )
+            {
+                os << std::left << std::setw( width + 2 )
+                   << ( std::string( 2 * record.depth, ' ' ) + record.node );
+                for ( const auto& counter : record.counters )
+                    os << std::right << std::setw( 10 ) << counter.calls << std::setw( 14 )
+                       << counter.ticks;
+                os << '\n';
+            }
+        }
+
+        /// Current value of the clock used for profiling.
+        static std::uint64_t ticks() noexcept
+        {
+#if defined( __x86_64__ ) || defined( __i386__ )
+            return __rdtsc();
+#else
+            return std::chrono::duration_cast< std::chrono::nanoseconds >(
+                       std::chrono::steady_clock::now().time_since_epoch() )
+                .count();
+#endif
+        }
+
+        /// Unit of ticks().
+        static const char* unit() noexcept
+        {
+#if defined( __x86_64__ ) || defined( __i386__ )
+            return "cycles";
+#else
+            return "ns";
+#endif
+        }
+
+    private:
+        std::deque< ProfileRecord > records_;
+    };
+
+    /// @cond
+    namespace Detail
+    {
+        /// Counts a call and adds the time until destruction.
+        class ProfileScope
+        {
+        public:
+            explicit ProfileScope( ProfileCounter& counter_ )
+                : counter( counter_ ), start( Profile::ticks() )
+            {
+            }
+
+            ~ProfileScope()
+            {
+                counter.ticks += Profile::ticks() - start;
+                ++counter.calls;
+            }
+
+            ProfileScope( const ProfileScope& ) = delete;
+            ProfileScope& operator=( const ProfileScope& ) = delete;
+
+        private:
+            ProfileCounter& counter;
+            std::uint64_t start;
+        };
+
+        /// Demangled name of F without namespaces and type arguments, e.g. Sum or Pow<2, 1>.
+        template < class F >
+        std::string nodeName()
+        {
+            std::string name = typeid( F ).name();
+#ifdef __GNUG__
+            int status = 0;
+            std::unique_ptr< char, void ( * )( void* ) > demangled(
+                abi::__cxa_demangle( name.c_str(), nullptr, nullptr, &status ), std::free );
+            if ( status == 0 )
+                name = demangled.get();
+#endif
+            const auto templateBegin = name.find( '<' );
+            auto base = name.substr( 0, templateBegin );
+            const auto scope = base.rfind( "::" );
+            if ( scope != std::string::npos )
+                base = base.substr( scope + 2 );
+            if ( templateBegin == std::string::npos )
+                return base;
+
+            // keep top-level non-type arguments
+            std::string arguments, argument;
+            auto level = 0;
+            for ( auto i = templateBegin + 1; i < name.size() && level >= 0; ++i )
+            {
+                const auto c = name[ i ];
+                level += ( c == '<' ) - ( c == '>' );
+                if ( level > 0 || ( c != ',' && level == 0 ) )
+                {
+                    argument += c;
+                    continue;
+                }
+                const auto first = argument.find_first_not_of( ' ' );
+                if ( first != std::string::npos &&
+                     argument.find_first_not_of( "-0123456789", first ) == std::string::npos )
+                    arguments += ( arguments.empty() ? "" : ", " ) + argument.substr( first );
+                argument.clear();
+            }
+            return arguments.empty() ? base : base + "<" + arguments + ">";
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Function that forwards to F and records calls and times of update, d0, d1, d2
+     * and d3.
+     *
+     * Derivatives are present if and only if they are present for F. Use profile( f ) to wrap
+     * each node of f.
+     */
+    template < class F >
+    class Profiled : public Chainer< Profiled< F > >
+    {
+    public:
+        /// Constructor. Counters are stored in the specified record of profile.
+        Profiled( F f_, std::shared_ptr< Profile > profile_, ProfileRecord& record_ )
+            : f( std::move( f_ ) ), profile( std::move( profile_ ) ), record( &record_ )
+        {
+        }
+
+        /// Update point of evaluation.
+        template < class Arg, class G = F,
+                   std::enable_if_t< Detail::HasUpdateWithoutIndex< G, Arg >::value >* = nullptr >
+        void update( Arg&& x )
+        {
+            Detail::ProfileScope scope( ( *record )[ ProfiledOperation::update ] );
+            f.update( std::forward< Arg >( x ) );
+        }
+
+        /// Update point of evaluation. Only derivatives up to order k will be evaluated.
+        template < class Arg, int k, class G = F,
+                   std::enable_if_t< Detail::HasUpdateWithOrder< G, Arg, k >::value >* = nullptr >
+        void update( Arg&& x, EvaluationOrder< k > order )
+        {
+            Detail::ProfileScope scope( ( *record )[ ProfiledOperation::update ] );
+            f.update( std::forward< Arg >( x ), order );
+        }
+
+        /// Update variable corresponding to index.
+        template < int index, class Arg, class G = F,
+                   std::enable_if_t< Detail::HasUpdateWithIndex< G, Arg, index >::value >* =
+                       nullptr >
+        void update( Arg&& x )
+        {
+            Detail::ProfileScope scope( ( *record )[ ProfiledOperation::update ] );
+            f.template update< index >( std::forward< Arg >( x ) );
+        }
+
+        template < class... IndexedArgs, class G = F,
+                   class = decltype( std::declval< G& >().bulk_update(
+                       std::declval< IndexedArgs >()... ) ) >
+        void bulk_update( IndexedArgs&&... args )
+        {
+            Detail::ProfileScope scope( ( *record )[ ProfiledOperation::update ] );
+            f.bulk_update( std::forward< IndexedArgs >( args )... );
+        }
+
+        /// Function value.
+        decltype( auto ) d0() const
+        {
+            Detail::ProfileScope scope( ( *record )[ ProfiledOperation::d0 ] );
+            return f();
+        }
+
+        /// First directional derivative.
+        template < int id, class Arg, class IndexedArg = IndexedType< std::decay_t< Arg >, id >,
+                   class = std::enable_if_t< D1_< F, IndexedArg >::present > >
+        decltype( auto ) d1( Arg&& dx ) const
+        {
+            Detail::ProfileScope scope( ( *record )[ ProfiledOperation::d1 ] );
+            return D1_< F, IndexedArg >::apply( f, std::forward< Arg >( dx ) );
+        }
+
+        /// Second directional derivative.
+        template < int idx, int idy, class ArgX, class ArgY,
+                   class IndexedArgX = IndexedType< std::decay_t< ArgX >, idx >,
+                   class IndexedArgY = IndexedType< std::decay_t< ArgY >, idy >,
+                   class = std::enable_if_t< D2_< F, IndexedArgX, IndexedArgY >::present > >
+        decltype( auto ) d2( ArgX&& dx, ArgY&& dy ) const
+        {
+            Detail::ProfileScope scope( ( *record )[ ProfiledOperation::d2 ] );
+            return D2_< F, IndexedArgX, IndexedArgY >::apply( f, std::forward< ArgX >( dx ),
+                                                              std::forward< ArgY >( dy ) );
+        }
+
+        /// Third directional derivative.
+        template < int idx, int idy, int idz, class ArgX, class ArgY, class ArgZ,
+                   class IndexedArgX = IndexedType< std::decay_t< ArgX >, idx >,
+                   class IndexedArgY = IndexedType< std::decay_t< ArgY >, idy >,
+                   class IndexedArgZ = IndexedType< std::decay_t< ArgZ >, idz >,
+                   class = std::enable_if_t<
+                       D3_< F, IndexedArgX, IndexedArgY, IndexedArgZ >::present > >
+        decltype( auto ) d3( ArgX&& dx, ArgY&& dy, ArgZ&& dz ) const
+        {
+            Detail::ProfileScope scope( ( *record )[ ProfiledOperation::d3 ] );
+            return D3_< F, IndexedArgX, IndexedArgY, IndexedArgZ >::apply(
+                f, std::forward< ArgX >( dx ), std::forward< ArgY >( dy ),
+                std::forward< ArgZ >( dz ) );
+        }
+
+        /// Records of all nodes of the profiled function.
+        const Profile& profileData() const noexcept
+        {
+            return *profile;
+        }
+
+        /// Print calls and times per node and operation (see Profile::report).
+        void report( std::ostream& os ) const
+        {
+            profile->report( os );
+        }
+
+        /// Set all counters to zero.
+        void resetProfile()
+        {
+            profile->reset();
+        }
+
+    private:
+        F f;
+        std::shared_ptr< Profile > profile;
+        ProfileRecord* record;
+    };
+
+    /// @cond
+    namespace Detail
+    {
+        /// Wraps all nodes of F that are visited by Meta::Traverse in Profiled.
+        template < class F >
+        struct ProfileTree
+        {
+            static auto apply( const F& f, const std::shared_ptr< Profile >& profile, int depth )
+            {
+                return Profiled< F >( f, profile, profile->add( nodeName< F >(), depth ) );
+            }
+        };
+
+        template < class F, bool hasVariables >
+        struct ProfileTree< FinalizeImpl< F, hasVariables > >
+        {
+            static auto apply( const FinalizeImpl< F, hasVariables >& f,
+                               const std::shared_ptr< Profile >& profile, int depth )
+            {
+                return finalize( ProfileTree< F >::apply( f, profile, depth ) );
+            }
+        };
+
+        template < class Scalar, class F >
+        struct ProfileTree<
+            MathematicalOperations::Scale< Scalar, F, Concepts::FunctionConceptCheck< F > > >
+        {
+            using Type =
+                MathematicalOperations::Scale< Scalar, F, Concepts::FunctionConceptCheck< F > >;
+
+            static auto apply( const Type& h, const std::shared_ptr< Profile >& profile, int depth )
+            {
+                auto& record = profile->add( nodeName< Type >(), depth );
+                auto f = ProfileTree< F >::apply( h.f, profile, depth + 1 );
+                using Result = MathematicalOperations::Scale< Scalar, decltype( f ) >;
+                return Profiled< Result >( Result( h.a, std::move( f ) ), profile, record );
+            }
+        };
+
+        template < template < class, class > class G, class F >
+        struct ProfileTree< G< F, Concepts::FunctionConceptCheck< F > > >
+        {
+            using Type = G< F, Concepts::FunctionConceptCheck< F > >;
+
+            static auto apply( const Type& h, const std::shared_ptr< Profile >& profile, int depth )
+            {
+                auto& record = profile->add( nodeName< Type >(), depth );
+                auto f = ProfileTree< F >::apply( h.f, profile, depth + 1 );
+                using Result = G< decltype( f ), Concepts::FunctionConceptCheck< decltype( f ) > >;
+                return Profiled< Result >( Result( std::move( f ) ), profile, record );
+            }
+        };
+
+        template < template < class, class, class, class > class H, class F, class G >
+        struct ProfileTree<
+            H< F, G, Concepts::FunctionConceptCheck< F >, Concepts::FunctionConceptCheck< G > > >
+        {
+            using Type =
+                H< F, G, Concepts::FunctionConceptCheck< F >, Concepts::FunctionConceptCheck< G > >;
+
+            static auto apply( const Type& h, const std::shared_ptr< Profile >& profile, int depth )
+            {
+                auto& record = profile->add( nodeName< Type >(), depth );
+                auto f = ProfileTree< F >::apply( h.f, profile, depth + 1 );
+                auto g = ProfileTree< G >::apply( h.g, profile, depth + 1 );
+                using Result = H< decltype( f ), decltype( g ),
+                                  Concepts::FunctionConceptCheck< decltype( f ) >,
+                                  Concepts::FunctionConceptCheck< decltype( g ) > >;
+                return Profiled< Result >( Result( std::move( f ), std::move( g ) ), profile,
+                                           record );
+            }
+        };
+    }
+    /// @endcond
+
+    /**
+     * @brief Wrap each node of f in Profiled, such that calls and times of update, d0, d1, d2
+     * and d3 are recorded per node.
+     *
+     * Sum, Product, Dot, Chain, Scale, Squared and finalize are traversed as in Meta::Traverse,
+     * all other functions are profiled as a whole. Functions that are not wrapped are not
+     * affected, i.e. profiling has no overhead if it is not used.
+     * @code
+     * auto f = profile( compressibleNeoHooke< Pow< 2 >, LN >( c, d0, d1, I ) );
+     * f.update( F );
+     * f.d2( dF, dF );
+     * f.report( std::cout );
+     * @endcode
+     * Fused derivatives (update_and_derivatives) are evaluated separately for profiled nodes.
+     */
+    template < class F >
+    auto profile( const F& f )
+    {
+        return Detail::ProfileTree< F >::apply( f, std::make_shared< Profile >(), 0 );
+    }
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <fung/finalize.hh>
+#include <fung/util/evaluation_order.hh>
+#include <fung/util/node_state.hh>
+#include <fung/variable.hh>
+#include <fung/util/type_traits.hh>
+
+#include <type_traits>
+#include <utility>
+
+namespace FunG
+{
+    /// @cond
+    namespace Detail
+    {
+        /// The node underneath the interface provided by finalize( ... ).
+        template < class F >
+        struct Unfinalized
+        {
+            using type = F;
+        };
+
+        template < class F >
+        struct Unfinalized< FinalizeImpl< F, false > >
+        {
+            using type = F;
+        };
+    }
+    /// @endcond
+
+    /**
+     * @brief Immutable function that provides const and re-entrant evaluation.
+     *
+     * The nodes of a function store the intermediate results of update(x), thus evaluation
+     * mutates the function. Stateless keeps an immutable prototype of the function and stores the
+     * intermediate results of an evaluation at x in a separate State, see NodeState. Nodes that
+     * do not depend on x, such as constants, are not copied into the state. Value and derivatives
+     * are const functions of prototype and state. This allows sharing one Stateless object
+     * between threads. Returned values do not refer to any state.
+     *
+     * Use state(x) to evaluate several derivatives at the same point, without repeating the
+     * update:
+     * @code
+     * const auto f = stateless( compressibleNeoHooke< Pow< 2 >, LN >( c, d0, d1, I ) );
+     * const auto s = f.state( F );
+     * auto value = f( s ), derivative = f.d1( s, dF );
+     * @endcode
+     *
+     * @tparam F function without variables, usually the return type of finalize( ... )
+     */
+    template < class F >
+    class Stateless
+    {
+        using Node = typename Detail::Unfinalized< F >::type;
+        static_assert( !Checks::Has::variable< Node >(),
+                       "Stateless does not support functions with variables." );
+
+    public:
+        /// Intermediate results of an evaluation at some argument of type Arg.
+        template < class Arg >
+        using State = NodeState< Node, Arg >;
+
+        /// Constructor.
+        explicit Stateless( F f ) : prototype( std::move( f ) )
+        {
+        }
+
+        /**
+         * @brief State at x, for which derivatives of all orders can be computed.
+         *
+         * If FUNG_REFERENCE_STORAGE is defined, the returned state may keep a reference to x.
+         * Then x must outlive the state.
+         */
+        template < class Arg >
+        State< Arg > state( const Arg& x ) const
+        {
+            return State< Arg >( node(), x, UpToThirdDerivative() );
+        }
+
+        /// State at x, for which derivatives up to order k can be computed. See state(x) for the
+        /// lifetime of x if FUNG_REFERENCE_STORAGE is defined.
+        template < class Arg, int k >
+        State< Arg > state( const Arg& x, EvaluationOrder< k > order ) const
+        {
+            return State< Arg >( node(), x, order );
+        }
+
+        /// Function value at the point of evaluation of s.
+        template < class Arg >
+        auto operator()( const State< Arg >& s ) const
+        {
+            return decay_t< decltype( s.value( node() ) ) >( s.value( node() ) );
+        }
+
+        /// First directional derivative at the point of evaluation of s.
+        template < class Arg, class ArgX >
+        auto d1( const State< Arg >& s, const ArgX& dx ) const
+        {
+            return decay_t< decltype( finalize( s.bind( node() ) ).d1( dx ) ) >(
+                finalize( s.bind( node() ) ).d1( dx ) );
+        }
+
+        /// Second directional derivative at the point of evaluation of s.
+        template < class Arg, class ArgX, class ArgY >
+        auto d2( const State< Arg >& s, const ArgX& dx, const ArgY& dy ) const
+        {
+            return decay_t< decltype( finalize( s.bind( node() ) ).d2( dx, dy ) ) >(
+                finalize( s.bind( node() ) ).d2( dx, dy ) );
+        }
+
+        /// Third directional derivative at the point of evaluation of s.
+        template < class Arg, class ArgX, class ArgY, class ArgZ >
+        auto d3( const State< Arg >& s, const ArgX& dx, const ArgY& dy, const ArgZ& dz ) const
+        {
+            return decay_t< decltype( finalize( s.bind( node() ) ).d3( dx, dy, dz ) ) >(
+                finalize( s.bind( node() ) ).d3( dx, dy, dz ) );
+        }
+
+        /// Function value at x.
+        template < class Arg >
+        auto operator()( const Arg& x ) const
+        {
+            return ( *this )( state( x, ValueOnly() ) );
+        }
+
+        /// First directional derivative at x.
+        template < class Arg, class ArgX >
+        auto d1( const Arg& x, const ArgX& dx ) const
+        {
+            return d1( state( x, UpToFirstDerivative() ), dx );
+        }
+
+        /// Second directional derivative at x.
+        template < class Arg, class ArgX, class ArgY >
+        auto d2( const Arg& x, const ArgX& dx, const ArgY& dy ) const
+        {
+            return d2( state( x, UpToSecondDerivative() ), dx, dy );
+        }
+
+        /// Third directional derivative at x.
+        template < class Arg, class ArgX, class ArgY, class ArgZ >
+        auto d3( const Arg& x, const ArgX& dx, const ArgY& dy, const ArgZ& dz ) const
+        {
+            return d3( state( x ), dx, dy, dz );
+        }
+
+        /// Access the immutable prototype.
+        const F& function() const noexcept
+        {
+            return prototype;
+        }
+
+    private:
+        const Node& node() const noexcept
+        {
+            return prototype;
+        }
+
+        F prototype;
+    };
+
+    /// Generate Stateless<F>(f).
+    template < class F >
+    auto stateless( F&& f )
+    {
+        return Stateless< std::decay_t< F > >( std::forward< F >( f ) );
+    }
+}
@@ -13,11 +13,11 @@ namespace FunG
 {
   /**
    * @brief Overwrites \f$A\f$ with \f$A+A^T\f$.
-   * @return \f$A+A^T\f$
+   * @return reference to \f$A\f$
    */
   template <class Matrix ,
             std::enable_if_t<Checks::isConstantSize<Matrix>()>* = nullptr >
-  Matrix addTransposed(Matrix& A)
+  Matrix& addTransposed(Matrix& A)
   {
     using LinearAlgebra::dim;
     using Index = decltype(dim<Matrix>());
@@ -30,11 +30,11 @@ namespace FunG
 
   /**
    * @brief Overwrites \f$A\f$ with \f$A+A^T\f$.
-   * @return \f$A+A^T\f$
+   * @return reference to \f$A\f$
    */
   template <class Matrix ,
             std::enable_if_t<!Checks::isConstantSize<Matrix>()>* = nullptr >
-  Matrix addTransposed(Matrix& A)
+  Matrix& addTransposed(Matrix& A)
   {
     using LinearAlgebra::rows;
     using LinearAlgebra::cols;
@@ -25,9 +25,12 @@ namespace FunG
             }
         };
 
-        /// Specialization for the case that matrix entries can be accessed via square brackets: A[i][j].
+        /// Specialization for the case that matrix entries can only be accessed via square brackets: A[i][j].
+        /// Matrices that provide A(i,j) use the default, since A[i][j] may also compile if A[i] is the entry of a
+        /// matrix of packs of scalars (see Simd).
         template <class Matrix>
-        struct EntryOfMatrix< Matrix , void_t< Checks::Try::MemOp::SquareBracketAccessForMatrix< std::decay_t<Matrix> > > >
+        struct EntryOfMatrix< Matrix , std::enable_if_t< Checks::Has::MemOp::SquareBracketAccessForMatrix< std::decay_t<Matrix> >::value &&
+                                                         !Checks::Has::MemOp::RoundBracketAccessForMatrix< std::decay_t<Matrix> >::value > >
         {
             template <class Index, class = std::enable_if_t< std::is_integral<Index>::value > >
             static decltype(auto) apply(Matrix& A, Index i, Index j)
@@ -52,7 +52,7 @@ namespace FunG
             return value;
         }
 
-        decltype( std::declval< X >()() ) value;
+        decay_t< decltype( std::declval< X >()() ) > value;
     };
 
     template < class X, class Y >
@@ -69,7 +69,7 @@ namespace FunG
             return value;
         }
 
-        decltype( std::declval< Y >()() ) value;
+        decay_t< decltype( std::declval< Y >()() ) > value;
     };
     }
 
@@ -55,7 +55,7 @@ namespace FunG
                 return value;
             }
 
-            decltype( std::declval< X >()() ) value;
+            decay_t< decltype( std::declval< X >()() ) > value;
         };
 
         template < class X, class Y >
@@ -72,7 +72,7 @@ namespace FunG
                 return value;
             }
 
-            decltype( std::declval< Y >()() ) value;
+            decay_t< decltype( std::declval< Y >()() ) > value;
         };
     }
 
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <fung/linear_algebra/rows_and_cols.hh>
+#include <fung/util/derivative_wrappers.hh>
+#include <fung/util/type_traits.hh>
+#include <fung/util/voider.hh>
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/// Number of first derivatives that each node caches if FUNG_CACHE_DERIVATIVES is defined. Basis
+/// direction \f$E_{ij}\f$ of a matrix with \f$n\f$ columns is stored in entry \f$(ni+j)\mod\f$
+/// FUNG_DERIVATIVE_CACHE_SIZE, i.e. the default size suffices for the hessian with respect to
+/// matrices with up to 16 entries.
+#ifndef FUNG_DERIVATIVE_CACHE_SIZE
+#define FUNG_DERIVATIVE_CACHE_SIZE 16
+#endif
+
+namespace FunG
+{
+    /// @cond
+    namespace Detail
+    {
+        /// Directions that are identified by indices, such as LinearAlgebra::BasisDirection.
+        template < class Arg, class = void >
+        struct IsIndexedDirection : std::false_type
+        {
+        };
+
+        template < class Arg >
+        struct IsIndexedDirection<
+            Arg, void_t< decltype( std::declval< const Arg& >().rowIndex() ),
+                         decltype( std::declval< const Arg& >().colIndex() ) > > : std::true_type
+        {
+        };
+
+        /// Number of columns of the matrix of a direction of constant size.
+        template < class Arg,
+                   class Matrix = std::decay_t< decltype( std::declval< const Arg& >().matrix() ) >,
+                   std::enable_if_t< Checks::isConstantSize< Matrix >() >* = nullptr >
+        constexpr int columns( const Arg& ) noexcept
+        {
+            return LinearAlgebra::cols< Matrix >();
+        }
+
+        /// Number of columns of the matrix of a direction of dynamic size.
+        template < class Arg,
+                   class Matrix = std::decay_t< decltype( std::declval< const Arg& >().matrix() ) >,
+                   std::enable_if_t< !Checks::isConstantSize< Matrix >() >* = nullptr >
+        int columns( const Arg& dx )
+        {
+            return static_cast< int >( LinearAlgebra::cols( dx.matrix() ) );
+        }
+
+        /// Placeholder if derivatives are not cached.
+        struct NoDerivativeCache
+        {
+        };
+
+        /**
+         * @brief First directional derivatives of a subexpression in indexed directions, i.e.
+         * basis directions \f$E_{ij}\f$ of the variable with index id.
+         *
+         * Each direction is mapped to one entry. Derivatives are stored until clear() is called,
+         * i.e. until the point of evaluation changes. If the entry of a direction is occupied by
+         * another direction, the derivative is not cached. Thus references to cached derivatives
+         * stay valid until the next call of clear().
+         */
+        template < class Value, int size = FUNG_DERIVATIVE_CACHE_SIZE >
+        class DerivativeCache
+        {
+        public:
+            /// Remove all cached derivatives. The 64-bit generation counter does not wrap in
+            /// practice, so entries of earlier generations can never be mistaken for current ones.
+            void clear() noexcept
+            {
+                ++generation;
+            }
+
+            /// Cached derivative in direction dx of the variable with index id, or nullptr.
+            template < int id, class Arg >
+            const Value* find( const Arg& dx ) const
+            {
+                const auto& entry = entries[ slot( dx ) ];
+                if ( entry.generation == generation && entry.id == id &&
+                     entry.i == dx.rowIndex() && entry.j == dx.colIndex() )
+                    return &entry.value;
+                return nullptr;
+            }
+
+            /// Store derivative in direction dx of the variable with index id if its entry is not
+            /// occupied. Returns the stored derivative or nullptr.
+            template < int id, class Arg, class Derivative >
+            const Value* insert( const Arg& dx, Derivative&& value )
+            {
+                auto& entry = entries[ slot( dx ) ];
+                if ( entry.generation == generation )
+                    return nullptr;
+                entry.generation = generation;
+                entry.id = id;
+                entry.i = dx.rowIndex();
+                entry.j = dx.colIndex();
+                entry.value = std::forward< Derivative >( value );
+                return &entry.value;
+            }
+
+        private:
+            struct Entry
+            {
+                std::uint64_t generation = 0;
+                int id = 0, i = 0, j = 0;
+                Value value;
+            };
+
+            template < class Arg >
+            static int slot( const Arg& dx )
+            {
+                return ( columns( dx ) * dx.rowIndex() + dx.colIndex() ) % size;
+            }
+
+            std::array< Entry, size > entries;
+            std::uint64_t generation = 1;
+        };
+
+#ifdef FUNG_CACHE_DERIVATIVES
+        /**
+         * @brief Caches for the first derivatives of the subexpressions of a node, with values of
+         * type Values.
+         *
+         * Defining FUNG_CACHE_DERIVATIVES enables caching in Chain, Product and Squared. Then the
+         * first derivatives of their subexpressions in basis directions are computed once per point
+         * of evaluation and reused in all second and third derivatives, such as in the assembly of
+         * hessians. Derivatives are cached in const member functions, thus a function must not be
+         * evaluated concurrently by several threads.
+         *
+         * Caching pays off if derivatives are requested separately for many basis directions and
+         * the subexpressions are expensive to differentiate, e.g. for third derivatives or
+         * anisotropic models (see the basisTangent and basisThird benchmarks). For cheap models,
+         * such as compressibleNeoHooke, the lookups cost more than they save. hessian() and
+         * gradient() of finalize() already reuse first derivatives of subexpressions without
+         * caching.
+         */
+        template < class... Values >
+        class DerivativeCaches
+        {
+        public:
+            /// Remove all cached derivatives. Called if the point of evaluation changes.
+            void clearCaches() noexcept
+            {
+                clear( std::make_index_sequence< sizeof...( Values ) >() );
+            }
+
+            /// Cache for the k-th subexpression.
+            template < int k >
+            auto& cache() const noexcept
+            {
+                return std::get< k >( caches );
+            }
+
+        private:
+            template < std::size_t... k >
+            void clear( std::index_sequence< k... > ) noexcept
+            {
+                (void)std::initializer_list< int >{( std::get< k >( caches ).clear(), 0 )...};
+            }
+
+            mutable std::tuple< DerivativeCache< Values >... > caches;
+        };
+#else
+        /// Derivatives are not cached. Define FUNG_CACHE_DERIVATIVES to enable caching.
+        template < class... Values >
+        class DerivativeCaches
+        {
+        public:
+            void clearCaches() noexcept
+            {
+            }
+
+            template < int k >
+            NoDerivativeCache cache() const noexcept
+            {
+                return {};
+            }
+        };
+#endif
+
+        /// Type of the k-th cache of Caches.
+        template < class Caches, int k >
+        using CacheType =
+            std::decay_t< decltype( std::declval< const Caches& >().template cache< k >() ) >;
+
+        /// First directional derivative f'(x)dx, taken from cache if possible.
+        template < class F, class IndexedArg, class Cache, class = void >
+        struct CachedD1 : D1< F, IndexedArg >
+        {
+            CachedD1( const F& f, const typename IndexedArg::type& dx, const Cache& )
+                : D1< F, IndexedArg >( f, dx )
+            {
+            }
+        };
+
+        template < class F, class IndexedArg, class Value >
+        struct CachedD1<
+            F, IndexedArg, DerivativeCache< Value >,
+            std::enable_if_t<
+                IsIndexedDirection< typename IndexedArg::type >::value &&
+                D1< F, IndexedArg >::present &&
+                std::is_same< decay_t< decltype( D1_< F, IndexedArg >::apply(
+                                  std::declval< const F& >(),
+                                  std::declval< const typename IndexedArg::type& >() ) ) >,
+                              Value >::value > >
+        {
+            static constexpr bool present = true;
+
+            CachedD1( const F& f, const typename IndexedArg::type& dx,
+                      DerivativeCache< Value >& cache )
+                : cached( cache.template find< IndexedArg::index >( dx ) )
+            {
+                if ( cached == nullptr )
+                {
+                    computed = D1_< F, IndexedArg >::apply( f, dx );
+                    cached = cache.template insert< IndexedArg::index >( dx, computed );
+                }
+            }
+
+            const Value& operator()() const noexcept
+            {
+                return cached != nullptr ? *cached : computed;
+            }
+
+            CachedD1( const CachedD1& ) = delete;
+            CachedD1& operator=( const CachedD1& ) = delete;
+
+        private:
+            const Value* cached;
+            Value computed;
+        };
+    }
+    /// @endcond
+}
@@ -36,7 +36,7 @@ namespace FunG
             {
             }
 
-            decltype( auto ) operator()() const
+            const auto& operator()() const
             {
                 return value;
             }
@@ -60,7 +60,7 @@ namespace FunG
             {
             }
 
-            decltype( auto ) operator()() const
+            const auto& operator()() const
             {
                 return value;
             }
@@ -98,7 +98,7 @@ namespace FunG
             {
             }
 
-            decltype( auto ) operator()() const
+            const auto& operator()() const
             {
                 return value;
             }
@@ -123,7 +123,7 @@ namespace FunG
             {
             }
 
-            decltype( auto ) operator()() const
+            const auto& operator()() const
             {
                 return value;
             }
@@ -166,7 +166,7 @@ namespace FunG
             {
             }
 
-            decltype( auto ) operator()() const
+            const auto& operator()() const
             {
                 return value;
             }
@@ -193,7 +193,7 @@ namespace FunG
             {
             }
 
-            decltype( auto ) operator()() const
+            const auto& operator()() const
             {
                 return value;
             }
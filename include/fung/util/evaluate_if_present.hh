@@ -1,5 +1,6 @@
 #pragma once
 
+#include "evaluation_order.hh"
 #include "voider.hh"
 
 #include <type_traits>
@@ -17,6 +18,10 @@ namespace FunG
         using TryCallOfUpdateWithIndex =
             decltype( std::declval< F >().template update< id >( std::declval< Arg >() ) );
 
+        template < class F, class Arg, int k >
+        using TryCallOfUpdateWithOrder = decltype(
+            std::declval< F >().update( std::declval< Arg >(), EvaluationOrder< k >() ) );
+
         template < class F, class Arg, class = void >
         struct HasUpdateWithoutIndex : std::false_type
         {
@@ -27,6 +32,17 @@ namespace FunG
         {
         };
 
+        template < class F, class Arg, int k, class = void >
+        struct HasUpdateWithOrder : std::false_type
+        {
+        };
+
+        template < class F, class Arg, int k >
+        struct HasUpdateWithOrder< F, Arg, k, void_t< TryCallOfUpdateWithOrder< F, Arg, k > > >
+            : std::true_type
+        {
+        };
+
         template < class F, class Arg, int id, class = void >
         struct HasUpdateWithIndex : std::false_type
         {
@@ -100,6 +116,22 @@ namespace FunG
         f.update( std::forward< Arg >( x ) );
     }
 
+    /// Update f with hint that only derivatives up to order k will be evaluated.
+    template < class F, class Arg, int k,
+               std::enable_if_t< Detail::HasUpdateWithOrder< F, Arg, k >::value >* = nullptr >
+    void update_if_present( F&& f, Arg&& x, EvaluationOrder< k > order )
+    {
+        f.update( std::forward< Arg >( x ), order );
+    }
+
+    /// Update f ignoring the hint, since f does not make use of it.
+    template < class F, class Arg, int k,
+               std::enable_if_t< !Detail::HasUpdateWithOrder< F, Arg, k >::value >* = nullptr >
+    void update_if_present( F&& f, Arg&& x, EvaluationOrder< k > )
+    {
+        update_if_present( std::forward< F >( f ), std::forward< Arg >( x ) );
+    }
+
     template < int id, class F, class Arg,
                std::enable_if_t< !Detail::HasUpdateWithIndex< F, Arg, id >::value >* = nullptr >
     void update_if_present( F&&, Arg&& )
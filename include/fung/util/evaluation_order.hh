@@ -0,0 +1,34 @@
+#pragma once
+
+#include <type_traits>
+
+namespace FunG
+{
+    /**
+     * @brief Hint for update that only derivatives up to the given order will be evaluated.
+     *
+     * Functions that precompute quantities for their derivatives during update may skip this
+     * precomputation if they provide an overload update(x, EvaluationOrder<k>). After such an
+     * update only d0(),...,dk() may be called, until the next update.
+     * Functions that do not provide such an overload are updated via update(x).
+     *
+     * @tparam k highest order of the derivatives that will be evaluated (0 <= k <= 3)
+     */
+    template < int k >
+    struct EvaluationOrder : std::integral_constant< int, k >
+    {
+        static_assert( k >= 0 && k <= 3, "Only derivatives up to third order are supported." );
+    };
+
+    /// Only the function value will be evaluated.
+    using ValueOnly = EvaluationOrder< 0 >;
+
+    /// Only the function value and its first derivative will be evaluated.
+    using UpToFirstDerivative = EvaluationOrder< 1 >;
+
+    /// Only the function value and its first and second derivatives will be evaluated.
+    using UpToSecondDerivative = EvaluationOrder< 2 >;
+
+    /// All derivatives will be evaluated. This is the behaviour of update(x).
+    using UpToThirdDerivative = EvaluationOrder< 3 >;
+}
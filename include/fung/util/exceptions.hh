@@ -8,8 +8,22 @@
 #include <string>
 #include <type_traits>
 
+#include "type_traits.hh"
+
 namespace FunG
 {
+  /// @cond
+  namespace Detail
+  {
+    template <class Value>
+    std::string toString(const Value& value)
+    {
+      using std::to_string;
+      return to_string(value);
+    }
+  }
+  /// @endcond
+
   /** @addtogroup Exceptions
    *   @{ */
 
@@ -34,9 +48,9 @@ namespace FunG
      * @param file file containing the throwing code
      * @param line line containing the throwing code
      */
-    template <class Value, class = std::enable_if_t<std::is_arithmetic<Value>::value> >
+    template <class Value, class = std::enable_if_t<is_arithmetic<Value>::value> >
     OutOfDomainException(const std::string& function, const std::string& range, const Value& value, const std::string& file, const int line) :
-      std::runtime_error(std::string("OutOfDomainException in ") + file + " at line " + std::to_string(line) + ".\n           " + function + ": Argument " + std::to_string(value) + " is outside range " + range + ".\n")
+      std::runtime_error(std::string("OutOfDomainException in ") + file + " at line " + std::to_string(line) + ".\n           " + function + ": Argument " + Detail::toString(value) + " is outside range " + range + ".\n")
     {}
   };
 
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <fung/util/derivative_wrappers.hh>
+#include <fung/util/mathop_traits.hh>
+#include <fung/util/packed_storage.hh>
+#include <fung/util/type_traits.hh>
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+namespace FunG
+{
+    /// @cond
+    namespace Detail
+    {
+        /// Placeholder for a derivative that is not requested.
+        struct NotRequested
+        {
+            static constexpr bool present = false;
+
+            template < class... Args >
+            NotRequested( const Args&... )
+            {
+            }
+        };
+
+        /// Returns make() if requested, else NotRequested.
+        template < bool requested, class Make, std::enable_if_t< requested >* = nullptr >
+        auto makeIf( Make make )
+        {
+            return make();
+        }
+
+        template < bool requested, class Make, std::enable_if_t< !requested >* = nullptr >
+        NotRequested makeIf( Make )
+        {
+            return {};
+        }
+
+        /// Evaluates a*x() if x is present.
+        template < class Scalar, class X, bool = X::present >
+        struct ComputeScaled
+        {
+            static constexpr bool present = false;
+            ComputeScaled( Scalar, const X& )
+            {
+            }
+        };
+
+        template < class Scalar, class X >
+        struct ComputeScaled< Scalar, X, true >
+        {
+            static constexpr bool present = true;
+
+            ComputeScaled( Scalar a, const X& x ) : value( multiply_via_traits( a, x() ) )
+            {
+            }
+
+            decltype( auto ) operator()() const
+            {
+                return value;
+            }
+
+            decay_t< decltype(
+                multiply_via_traits( std::declval< Scalar >(), std::declval< X >()() ) ) >
+                value;
+        };
+
+        /// Copy of the value of the derivative X, empty if X is not present.
+        template < class X, bool = X::present >
+        struct Stored
+        {
+            static constexpr bool present = false;
+
+            Stored() = default;
+
+            Stored( const X& )
+            {
+            }
+        };
+
+        template < class X >
+        struct Stored< X, true >
+        {
+            static constexpr bool present = true;
+
+            Stored() = default;
+
+            Stored( const X& x ) : value( x() )
+            {
+            }
+
+            const auto& operator()() const
+            {
+                return value;
+            }
+
+            decay_t< decltype( std::declval< const X& >()() ) > value;
+        };
+    }
+    /// @endcond
+
+    /**
+     * @brief First and second directional derivatives of f, computed in one traversal.
+     *
+     * The members d1x, d1y and d2xy hold \f$f'(x)dx\f$, \f$f'(x)dy\f$ and \f$f''(x)(dx,dy)\f$
+     * and behave like D1 and D2, i.e. provide present and operator(). If withD1Y is false, then
+     * d1y is not computed.
+     *
+     * This implementation evaluates the derivatives of f separately. Chain, Product, Squared, Scale
+     * and Sum specialize it such that the derivatives of their components are computed only once
+     * and then enter both the first and the second derivative.
+     */
+    template < class F, class IndexedArgX, class IndexedArgY, bool withD1Y = true >
+    struct D1D2
+    {
+        D1D2( const F& f, const typename IndexedArgX::type& dx,
+              const typename IndexedArgY::type& dy )
+            : d1x( f, dx ), d1y( f, dy ), d2xy( f, dx, dy )
+        {
+        }
+
+        D1< F, IndexedArgX > d1x;
+        std::conditional_t< withD1Y, D1< F, IndexedArgY >, Detail::NotRequested > d1y;
+        D2< F, IndexedArgX, IndexedArgY > d2xy;
+    };
+
+    /**
+     * @brief First directional derivatives of f in n directions of the same variable and, if
+     * withD2 is true, second derivatives in all pairs of these, computed in one traversal.
+     *
+     * d1[k] holds \f$f'(x)dx_k\f$ and d2[packedIndex(k,l,n)] holds \f$f''(x)(dx_k,dx_l)\f$ for
+     * \f$k\leq l\f$. Entries behave like D1 and D2, i.e. provide present and operator().
+     *
+     * This implementation evaluates the derivatives of f separately, i.e. calls f.d1 n times and
+     * f.d2 \f$n(n+1)/2\f$ times. Chain, Product, Squared, Scale and Sum specialize it, such that
+     * the derivatives of each subexpression are computed once per direction resp. pair of
+     * directions. In particular the first derivatives of a subexpression enter all second
+     * derivatives without being recomputed. This is used for the assembly of gradients and hessians
+     * in finalize().
+     */
+    template < class F, class IndexedArg, int n, bool withD2 = true >
+    struct D1D2Set
+    {
+        using D1Entry = Detail::Stored< D1< F, IndexedArg > >;
+        using D2Entry = Detail::Stored< D2< F, IndexedArg, IndexedArg > >;
+
+        D1D2Set( const F& f, const std::array< typename IndexedArg::type, n >& dx )
+        {
+            for ( int k = 0; k < n; ++k )
+                d1[ k ] = D1Entry( D1< F, IndexedArg >( f, dx[ k ] ) );
+            if ( withD2 )
+                for ( int k = 0; k < n; ++k )
+                    for ( int l = k; l < n; ++l )
+                        d2[ packedIndex( k, l, n ) ] =
+                            D2Entry( D2< F, IndexedArg, IndexedArg >( f, dx[ k ], dx[ l ] ) );
+        }
+
+        std::array< D1Entry, n > d1;
+        std::array< D2Entry, withD2 ? packedSize( n ) : 0 > d2;
+    };
+}
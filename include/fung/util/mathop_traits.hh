@@ -5,22 +5,47 @@
 
 namespace FunG
 {
+    /// @cond
+    namespace Detail
+    {
+        /// Result of lhs*rhs or lhs+rhs. Plain types, i.e. Eigen::Matrix, are evaluated in order
+        /// to avoid expression templates that refer to temporaries.
+        template < class T, class Result, bool evaluate = true >
+        using Evaluated_t =
+            std::conditional_t< evaluate && !std::is_same< T, Result >::value &&
+                                    std::is_constructible< T, Result >::value,
+                                T, Result >;
+
+        /// Products with scalars and of objects of the same type are evaluated to this type.
+        template < class T, class S, class Result >
+        using EvaluatedProduct_t =
+            Evaluated_t< T, Result,
+                         std::is_arithmetic< S >::value || std::is_same< T, S >::value >;
+    }
+    /// @endcond
+
     template < class T, class = void >
     struct MathOpTraits
     {
         template < class S >
-        static constexpr auto multiply( const T& lhs, const S& rhs )
+        static constexpr Detail::EvaluatedProduct_t<
+            T, S, decltype( std::declval< const T& >() * std::declval< const S& >() ) >
+        multiply( const T& lhs, const S& rhs )
         {
             return lhs * rhs;
         }
 
         template < class S, std::enable_if_t< !std::is_same< S, T >::value >* = nullptr >
-        static constexpr auto multiply( const S& lhs, const T& rhs )
+        static constexpr Detail::EvaluatedProduct_t<
+            T, S, decltype( std::declval< const S& >() * std::declval< const T& >() ) >
+        multiply( const S& lhs, const T& rhs )
         {
             return lhs * rhs;
         }
 
-        static constexpr auto add( const T& lhs, const T& rhs )
+        static constexpr Detail::Evaluated_t<
+            T, decltype( std::declval< const T& >() + std::declval< const T& >() ) >
+        add( const T& lhs, const T& rhs )
         {
             return lhs + rhs;
         }
@@ -95,4 +120,22 @@ namespace FunG
     {
         return MathOpTraits< std::common_type_t< T, S > >::add( lhs, rhs );
     }
+
+    template < class T, class S, std::enable_if_t< std::is_arithmetic< T >::value >* = nullptr,
+               std::enable_if_t< !std::is_arithmetic< std::decay_t< S > >::value &&
+                                 std::is_constructible< std::decay_t< S >, T >::value >* = nullptr >
+    auto add_via_traits( T lhs, S&& rhs )
+    {
+        return MathOpTraits< std::decay_t< S > >::add( std::decay_t< S >( lhs ),
+                                                       std::forward< S >( rhs ) );
+    }
+
+    template < class T, class S, std::enable_if_t< std::is_arithmetic< S >::value >* = nullptr,
+               std::enable_if_t< !std::is_arithmetic< std::decay_t< T > >::value &&
+                                 std::is_constructible< std::decay_t< T >, S >::value >* = nullptr >
+    auto add_via_traits( T&& lhs, S rhs )
+    {
+        return MathOpTraits< std::decay_t< T > >::add( std::forward< T >( lhs ),
+                                                       std::decay_t< T >( rhs ) );
+    }
 }
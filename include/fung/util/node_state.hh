@@ -0,0 +1,147 @@
+#pragma once
+
+#include "derivative_wrappers.hh"
+#include "evaluate_if_present.hh"
+#include "evaluation_order.hh"
+#include "indexed_type.hh"
+
+#include <type_traits>
+#include <utility>
+
+namespace FunG
+{
+    /// @cond
+    namespace Detail
+    {
+        /// Selects the constructors that assemble a node from the states of its children.
+        struct BindTag
+        {
+        };
+    }
+    /// @endcond
+
+    /**
+     * @brief Read-only view of an updated node.
+     *
+     * Forwards the function value and all derivatives that are present in F.
+     */
+    template < class F >
+    class NodeRef
+    {
+    public:
+        /// Constructor. f must outlive this object.
+        explicit NodeRef( const F& f ) noexcept : f( &f )
+        {
+        }
+
+        /// Function value.
+        decltype( auto ) d0() const
+        {
+            return ( *f )();
+        }
+
+        /// Function value.
+        decltype( auto ) operator()() const
+        {
+            return ( *f )();
+        }
+
+        /// First directional derivative.
+        template < int id, class Arg, class IndexedArg = IndexedType< std::decay_t< Arg >, id >,
+                   class = std::enable_if_t< D1_< F, IndexedArg >::present > >
+        decltype( auto ) d1( Arg&& dx ) const
+        {
+            return D1_< F, IndexedArg >::apply( *f, std::forward< Arg >( dx ) );
+        }
+
+        /// Second directional derivative.
+        template < int idx, int idy, class ArgX, class ArgY,
+                   class IndexedArgX = IndexedType< std::decay_t< ArgX >, idx >,
+                   class IndexedArgY = IndexedType< std::decay_t< ArgY >, idy >,
+                   class = std::enable_if_t< D2_< F, IndexedArgX, IndexedArgY >::present > >
+        decltype( auto ) d2( ArgX&& dx, ArgY&& dy ) const
+        {
+            return D2_< F, IndexedArgX, IndexedArgY >::apply( *f, std::forward< ArgX >( dx ),
+                                                              std::forward< ArgY >( dy ) );
+        }
+
+        /// Third directional derivative.
+        template < int idx, int idy, int idz, class ArgX, class ArgY, class ArgZ,
+                   class IndexedArgX = IndexedType< std::decay_t< ArgX >, idx >,
+                   class IndexedArgY = IndexedType< std::decay_t< ArgY >, idy >,
+                   class IndexedArgZ = IndexedType< std::decay_t< ArgZ >, idz >,
+                   class = std::enable_if_t<
+                       D3_< F, IndexedArgX, IndexedArgY, IndexedArgZ >::present > >
+        decltype( auto ) d3( ArgX&& dx, ArgY&& dy, ArgZ&& dz ) const
+        {
+            return D3_< F, IndexedArgX, IndexedArgY, IndexedArgZ >::apply(
+                *f, std::forward< ArgX >( dx ), std::forward< ArgY >( dy ),
+                std::forward< ArgZ >( dz ) );
+        }
+
+    private:
+        const F* f;
+    };
+
+    /**
+     * @brief Intermediate results of a node of type F, updated at some argument of type Arg.
+     *
+     * The state is kept apart from the node, which is not modified. bind(f) combines node and
+     * state to a function that provides the function value and the derivatives at the point of
+     * evaluation, without further updates.
+     *
+     * This generic version stores an updated copy of the node. The composite nodes Sum, Scale,
+     * Product, Squared and Chain specialize NodeState and store only the states of their children
+     * and their own function value. Nodes without update() are used as they are and have an empty
+     * state.
+     */
+    template < class F, class Arg, class = void >
+    class NodeState
+    {
+    public:
+        /// Update a copy of f at x. Only derivatives up to order k will be evaluated.
+        template < int k >
+        NodeState( const F& f, const Arg& x, EvaluationOrder< k > order ) : node( f )
+        {
+            update_if_present( node, x, order );
+        }
+
+        /// Function value of f at the point of evaluation.
+        decltype( auto ) value( const F& ) const
+        {
+            return node();
+        }
+
+        /// Function that evaluates f at the point of evaluation. Must not outlive this state.
+        NodeRef< F > bind( const F& ) const noexcept
+        {
+            return NodeRef< F >( node );
+        }
+
+    private:
+        F node;
+    };
+
+    /// @cond
+    template < class F, class Arg >
+    class NodeState< F, Arg,
+                     std::enable_if_t< !Detail::HasUpdateWithoutIndex< F&, const Arg& >::value > >
+    {
+    public:
+        template < int k >
+        NodeState( const F&, const Arg&, EvaluationOrder< k > ) noexcept
+        {
+        }
+
+        decltype( auto ) value( const F& f ) const
+        {
+            return f();
+        }
+
+        NodeRef< F > bind( const F& f ) const noexcept
+        {
+            return NodeRef< F >( f );
+        }
+    };
+    /// @endcond
+} // namespace FunG
@@ -0,0 +1,21 @@
+#pragma once
+
+namespace FunG
+{
+    /// Number of entries of the upper triangle of a symmetric m x m matrix.
+    constexpr int packedSize( int m )
+    {
+        return m * ( m + 1 ) / 2;
+    }
+
+    /**
+     * @brief Position of entry (k,l) of a symmetric m x m matrix in packed storage.
+     *
+     * Packed storage holds the upper triangle row by row, i.e.
+     * \f$(0,0),(0,1),\ldots,(0,m-1),(1,1),\ldots,(m-1,m-1)\f$.
+     */
+    constexpr int packedIndex( int k, int l, int m )
+    {
+        return k <= l ? k * m - k * ( k - 1 ) / 2 + l - k : packedIndex( l, k, m );
+    }
+}
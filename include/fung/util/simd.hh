@@ -0,0 +1,752 @@
+#pragma once
+
+#include <fung/util/type_traits.hh>
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// GCC warns that packs wider than the vector registers of the selected instruction set, such as
+// Simd<double,4> without AVX, are passed and returned differently than with that instruction set.
+// All functions of this file are templates or inline, thus this only concerns translation units
+// that are compiled with different instruction sets and that is not supported anyway.
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+namespace FunG
+{
+    template < class Scalar, int lanes >
+    class Simd;
+
+    /// @cond
+    namespace SimdDetail
+    {
+        template < class Scalar >
+        struct IEEE754;
+
+        template <>
+        struct IEEE754< double >
+        {
+            static constexpr int mantissaBits = 52;
+            static constexpr int exponentBias = 1023;
+            static constexpr int exponentMask = 0x7ff;
+            static constexpr double maxLog = 7.09782712893383996843E2;
+            static constexpr double minLog = -7.451332191019412076235E2;
+        };
+
+        template <>
+        struct IEEE754< float >
+        {
+            static constexpr int mantissaBits = 23;
+            static constexpr int exponentBias = 127;
+            static constexpr int exponentMask = 0xff;
+            static constexpr float maxLog = 88.72283905206835f;
+            static constexpr float minLog = -103.278929903431851103f;
+        };
+
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > exp( const Simd< Scalar, lanes >& x );
+
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > log( const Simd< Scalar, lanes >& x );
+
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > pow( const Simd< Scalar, lanes >& x, const Simd< Scalar, lanes >& y );
+
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > erf( const Simd< Scalar, lanes >& x );
+
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > floor( const Simd< Scalar, lanes >& x );
+
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > abs( const Simd< Scalar, lanes >& x );
+    }
+    /// @endcond
+
+    /**
+     * @brief Pack of scalars that are processed simultaneously, one per SIMD lane.
+     *
+     * Simd<double,4> (AVX2) or Simd<double,8> (AVX-512) can be used as argument type of the
+     * functions in CMathGroup. Thus a single composed function evaluates 'lanes' points of evaluation
+     * at once, i.e.
+     * @code
+     * using Pack = Simd<double,4>;
+     * auto f = finalize( exp( sqrt( identity( Pack(1.) ) ) ) );
+     * f.update( Pack::load( x ) ); // evaluate at x[0],...,x[3]
+     * @endcode
+     *
+     * Arithmetic is based on the vector extensions of GCC and clang and thus mapped to the
+     * instruction set that is selected at compile time (i.e. via -march=...).
+     *
+     * Comparisons are evaluated lane-wise and return a Simd::Mask. A mask converts to true if it is
+     * set for at least one lane. Therefore domain checks of the form
+     * @code
+     * if( x <= 0 ) throw OutOfDomainException(...);
+     * @endcode
+     * throw if at least one lane is outside the domain.
+     *
+     * The functions exp, log, pow and erf (and thus exp2, log2 and log10) are vectorized, based on
+     * the rational approximations of the Cephes library. All remaining functions of \<cmath\> are
+     * evaluated lane by lane.
+     */
+    template < class Scalar, int lanes >
+    class Simd
+    {
+        static_assert( std::is_floating_point< Scalar >::value,
+                       "Simd: Scalar must be a floating point type." );
+        static_assert( lanes > 0 && ( lanes & ( lanes - 1 ) ) == 0,
+                       "Simd: Number of lanes must be a power of two." );
+
+    public:
+        using value_type = Scalar;
+
+        /// Underlying vector type.
+        typedef Scalar Vector __attribute__( ( vector_size( lanes * sizeof( Scalar ) ) ) );
+
+        /// Integral vector type of the same size, i.e. the result type of comparisons of vectors.
+        using IntegerVector = decltype( std::declval< Vector >() < std::declval< Vector >() );
+
+        /// Result of lane-wise comparisons.
+        class Mask
+        {
+        public:
+            /// Constructor. Set lanes hold -1, others hold 0.
+            explicit Mask( const IntegerVector& mask ) noexcept : mask( mask )
+            {
+            }
+
+            /// True if the mask is set for at least one lane.
+            explicit operator bool() const noexcept
+            {
+                return any( *this );
+            }
+
+            /// Access i-th lane.
+            bool operator[]( int i ) const noexcept
+            {
+                return mask[ i ] != 0;
+            }
+
+            /// Access underlying vector.
+            const IntegerVector& vector() const noexcept
+            {
+                return mask;
+            }
+
+            /// Lane-wise negation.
+            friend Mask operator!( const Mask& a ) noexcept
+            {
+                return Mask( ~a.mask );
+            }
+
+            /// Lane-wise conjunction.
+            friend Mask operator&&( const Mask& a, const Mask& b ) noexcept
+            {
+                return Mask( a.mask & b.mask );
+            }
+
+            /// Lane-wise disjunction.
+            friend Mask operator||( const Mask& a, const Mask& b ) noexcept
+            {
+                return Mask( a.mask | b.mask );
+            }
+
+            /// True if the mask is set for at least one lane.
+            friend bool any( const Mask& a ) noexcept
+            {
+                for ( int i = 0; i < lanes; ++i )
+                    if ( a.mask[ i ] )
+                        return true;
+                return false;
+            }
+
+            /// True if the mask is set for all lanes.
+            friend bool all( const Mask& a ) noexcept
+            {
+                for ( int i = 0; i < lanes; ++i )
+                    if ( !a.mask[ i ] )
+                        return false;
+                return true;
+            }
+
+        private:
+            IntegerVector mask;
+        };
+
+        /// Default constructor, initializes all lanes with zero.
+        Simd() noexcept : v{}
+        {
+        }
+
+        /// Initialize all lanes with x.
+        Simd( Scalar x ) noexcept : v( Vector{} + x )
+        {
+        }
+
+        /// Construct from underlying vector.
+        explicit Simd( const Vector& v ) noexcept : v( v )
+        {
+        }
+
+        /// Load 'lanes' consecutive values, starting at x.
+        static Simd load( const Scalar* x ) noexcept
+        {
+            Simd y;
+            std::memcpy( &y.v, x, sizeof( Vector ) );
+            return y;
+        }
+
+        /// Store all lanes to 'lanes' consecutive values, starting at x.
+        void store( Scalar* x ) const noexcept
+        {
+            std::memcpy( x, &v, sizeof( Vector ) );
+        }
+
+        /// Number of lanes.
+        static constexpr int size() noexcept
+        {
+            return lanes;
+        }
+
+        /// Access i-th lane.
+        Scalar operator[]( int i ) const noexcept
+        {
+            return v[ i ];
+        }
+
+        /// Set i-th lane to x.
+        void set( int i, Scalar x ) noexcept
+        {
+            v[ i ] = x;
+        }
+
+        /// Access underlying vector.
+        const Vector& vector() const noexcept
+        {
+            return v;
+        }
+
+        Simd& operator+=( const Simd& y ) noexcept
+        {
+            v += y.v;
+            return *this;
+        }
+
+        Simd& operator-=( const Simd& y ) noexcept
+        {
+            v -= y.v;
+            return *this;
+        }
+
+        Simd& operator*=( const Simd& y ) noexcept
+        {
+            v *= y.v;
+            return *this;
+        }
+
+        Simd& operator/=( const Simd& y ) noexcept
+        {
+            v /= y.v;
+            return *this;
+        }
+
+        friend Simd operator-( const Simd& x ) noexcept
+        {
+            return Simd( -x.v );
+        }
+
+        friend Simd operator+( Simd x, const Simd& y ) noexcept
+        {
+            return x += y;
+        }
+
+        friend Simd operator-( Simd x, const Simd& y ) noexcept
+        {
+            return x -= y;
+        }
+
+        friend Simd operator*( Simd x, const Simd& y ) noexcept
+        {
+            return x *= y;
+        }
+
+        friend Simd operator/( Simd x, const Simd& y ) noexcept
+        {
+            return x /= y;
+        }
+
+        friend Mask operator<( const Simd& x, const Simd& y ) noexcept
+        {
+            return Mask( x.v < y.v );
+        }
+
+        friend Mask operator<=( const Simd& x, const Simd& y ) noexcept
+        {
+            return Mask( x.v <= y.v );
+        }
+
+        friend Mask operator>( const Simd& x, const Simd& y ) noexcept
+        {
+            return Mask( x.v > y.v );
+        }
+
+        friend Mask operator>=( const Simd& x, const Simd& y ) noexcept
+        {
+            return Mask( x.v >= y.v );
+        }
+
+        friend Mask operator==( const Simd& x, const Simd& y ) noexcept
+        {
+            return Mask( x.v == y.v );
+        }
+
+        friend Mask operator!=( const Simd& x, const Simd& y ) noexcept
+        {
+            return Mask( x.v != y.v );
+        }
+
+        /// Lane-wise selection, i.e. x[i] if mask[i] is set, else y[i].
+        friend Simd select( const Mask& mask, const Simd& x, const Simd& y ) noexcept
+        {
+            return Simd( mask.vector() ? x.v : y.v );
+        }
+
+        friend Simd exp( const Simd& x ) noexcept
+        {
+            return SimdDetail::exp( x );
+        }
+
+        friend Simd exp2( const Simd& x ) noexcept
+        {
+            return SimdDetail::exp( x * Scalar( 0.693147180559945309417232121458176568 ) );
+        }
+
+        friend Simd log( const Simd& x ) noexcept
+        {
+            return SimdDetail::log( x );
+        }
+
+        friend Simd log2( const Simd& x ) noexcept
+        {
+            return SimdDetail::log( x ) * Scalar( 1.44269504088896340735992468100189214 );
+        }
+
+        friend Simd log10( const Simd& x ) noexcept
+        {
+            return SimdDetail::log( x ) * Scalar( 0.434294481903251827651128918916605082 );
+        }
+
+        /// Power function. For z = pow(x,y) the relative error is below (2 + |ln(z)|) machine
+        /// epsilon, as the error of the internally computed \f$ \log_2|x| \f$ is scaled with y.
+        friend Simd pow( const Simd& x, const Simd& y ) noexcept
+        {
+            return SimdDetail::pow( x, y );
+        }
+
+        friend Simd erf( const Simd& x ) noexcept
+        {
+            return SimdDetail::erf( x );
+        }
+
+        friend Simd floor( const Simd& x ) noexcept
+        {
+            return SimdDetail::floor( x );
+        }
+
+        friend Simd abs( const Simd& x ) noexcept
+        {
+            return SimdDetail::abs( x );
+        }
+
+        friend Simd sqrt( const Simd& x ) noexcept
+        {
+            return laneWise( x, []( Scalar t ) { return std::sqrt( t ); } );
+        }
+
+        friend Simd cbrt( const Simd& x ) noexcept
+        {
+            return laneWise( x, []( Scalar t ) { return std::cbrt( t ); } );
+        }
+
+        friend Simd sin( const Simd& x ) noexcept
+        {
+            return laneWise( x, []( Scalar t ) { return std::sin( t ); } );
+        }
+
+        friend Simd cos( const Simd& x ) noexcept
+        {
+            return laneWise( x, []( Scalar t ) { return std::cos( t ); } );
+        }
+
+        friend Simd tan( const Simd& x ) noexcept
+        {
+            return laneWise( x, []( Scalar t ) { return std::tan( t ); } );
+        }
+
+        friend Simd asin( const Simd& x ) noexcept
+        {
+            return laneWise( x, []( Scalar t ) { return std::asin( t ); } );
+        }
+
+        friend Simd acos( const Simd& x ) noexcept
+        {
+            return laneWise( x, []( Scalar t ) { return std::acos( t ); } );
+        }
+
+        /// String representation of the form (x[0], ..., x[lanes-1]).
+        friend std::string to_string( const Simd& x )
+        {
+            std::string str = "(";
+            for ( int i = 0; i < lanes; ++i )
+                str += ( i == 0 ? "" : ", " ) + std::to_string( x[ i ] );
+            return str + ")";
+        }
+
+    private:
+        template < class Function >
+        static Simd laneWise( Simd x, Function f ) noexcept
+        {
+            for ( int i = 0; i < lanes; ++i )
+                x.v[ i ] = f( x.v[ i ] );
+            return x;
+        }
+
+        Vector v;
+    };
+
+    /// Register Simd as arithmetic type.
+    template < class Scalar, int lanes >
+    struct is_arithmetic< Simd< Scalar, lanes > > : std::true_type
+    {
+    };
+
+    /// @cond
+    namespace SimdDetail
+    {
+        template < class Simd >
+        typename Simd::IntegerVector toBits( const Simd& x ) noexcept
+        {
+            typename Simd::IntegerVector bits;
+            std::memcpy( &bits, &x.vector(), sizeof( bits ) );
+            return bits;
+        }
+
+        template < class Simd >
+        Simd fromBits( const typename Simd::IntegerVector& bits ) noexcept
+        {
+            typename Simd::Vector v;
+            std::memcpy( &v, &bits, sizeof( v ) );
+            return Simd( v );
+        }
+
+        /// \f$ 2^n \f$ for integral n in the range of normalized floating point numbers.
+        template < class Simd >
+        Simd pow2( const typename Simd::IntegerVector& n ) noexcept
+        {
+            using Traits = IEEE754< typename Simd::value_type >;
+            return fromBits< Simd >( ( n + Traits::exponentBias ) << Traits::mantissaBits );
+        }
+
+        /// Evaluate polynomial \f$ c_0x^{n-1} + \dots + c_{n-1} \f$.
+        template < class Simd, std::size_t n >
+        Simd polevl( const Simd& x, const double ( &c )[ n ] ) noexcept
+        {
+            using Scalar = typename Simd::value_type;
+            Simd y( static_cast< Scalar >( c[ 0 ] ) );
+            for ( std::size_t i = 1; i < n; ++i )
+                y = y * x + static_cast< Scalar >( c[ i ] );
+            return y;
+        }
+
+        /// Evaluate polynomial \f$ x^n + c_0x^{n-1} + \dots + c_{n-1} \f$.
+        template < class Simd, std::size_t n >
+        Simd p1evl( const Simd& x, const double ( &c )[ n ] ) noexcept
+        {
+            using Scalar = typename Simd::value_type;
+            Simd y = x + static_cast< Scalar >( c[ 0 ] );
+            for ( std::size_t i = 1; i < n; ++i )
+                y = y * x + static_cast< Scalar >( c[ i ] );
+            return y;
+        }
+
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > abs( const Simd< Scalar, lanes >& x )
+        {
+            using Integer = std::decay_t< decltype( toBits( x )[ 0 ] ) >;
+            return fromBits< Simd< Scalar, lanes > >( toBits( x ) &
+                                                      std::numeric_limits< Integer >::max() );
+        }
+
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > floor( const Simd< Scalar, lanes >& x )
+        {
+            using S = Simd< Scalar, lanes >;
+            using Vector = typename S::Vector;
+            using IntegerVector = typename S::IntegerVector;
+            const Scalar integral = Scalar( 1 ) / std::numeric_limits< Scalar >::epsilon();
+
+            const auto truncated =
+                S( __builtin_convertvector( __builtin_convertvector( x.vector(), IntegerVector ),
+                                            Vector ) );
+            const auto y = select( truncated > x, truncated - Scalar( 1 ), truncated );
+            // large numbers are integral, nan is left unchanged
+            return select( abs( x ) < integral, y, x );
+        }
+
+        /// \f$ x2^n \f$ for integral n with \f$ x2^n \f$ in the range of floating point numbers.
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > ldexp( const Simd< Scalar, lanes >& x,
+                                     const Simd< Scalar, lanes >& n )
+        {
+            using S = Simd< Scalar, lanes >;
+            using IntegerVector = typename S::IntegerVector;
+
+            // scale in two steps, as 2^n is not representable for the largest and smallest n
+            const auto k = __builtin_convertvector( n.vector(), IntegerVector );
+            const IntegerVector k1 = k >> 1;
+            return x * pow2< S >( k1 ) * pow2< S >( k - k1 );
+        }
+
+        /// Decompose positive, finite x into \f$ m2^e \f$ with m in [0.5,1[.
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > frexp( const Simd< Scalar, lanes >& x, Simd< Scalar, lanes >& e )
+        {
+            using S = Simd< Scalar, lanes >;
+            using Vector = typename S::Vector;
+            using Traits = IEEE754< Scalar >;
+            using Integer = std::decay_t< decltype( toBits( x )[ 0 ] ) >;
+            const auto subnormalShift = Traits::mantissaBits + 2;
+            const Scalar subnormalScaling = Integer( 1 ) << subnormalShift;
+
+            // scale subnormal numbers to the range of normalized numbers
+            const auto subnormal = x < std::numeric_limits< Scalar >::min();
+            auto bits = toBits( select( subnormal, x * subnormalScaling, x ) );
+
+            e = S( __builtin_convertvector(
+                ( ( bits >> Traits::mantissaBits ) & Traits::exponentMask ) -
+                    ( Traits::exponentBias - 1 ),
+                Vector ) );
+            e = select( subnormal, e - Scalar( subnormalShift ), e );
+            const Integer exponentBits = Integer( Traits::exponentMask ) << Traits::mantissaBits;
+            bits = ( bits & ~exponentBits ) |
+                   ( Integer( Traits::exponentBias - 1 ) << Traits::mantissaBits );
+            return fromBits< S >( bits );
+        }
+
+        /// exp(x) for \f$ |x| \le \ln(2)/2 \f$, Cephes, exp.c
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > expReduced( const Simd< Scalar, lanes >& x )
+        {
+            static const double P[] = {1.26177193074810590878E-4, 3.02994407707441961300E-2,
+                                       9.99999999999999999910E-1};
+            static const double Q[] = {3.00198505138664455042E-6, 2.52448340349684104192E-3,
+                                       2.27265548208155028766E-1, 2.00000000000000000009E0};
+
+            const auto xx = x * x;
+            const auto px = x * polevl( xx, P );
+            return Scalar( 1 ) + Scalar( 2 ) * px / ( polevl( xx, Q ) - px );
+        }
+
+        // Cephes, exp.c
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > exp( const Simd< Scalar, lanes >& x )
+        {
+            using S = Simd< Scalar, lanes >;
+            using Traits = IEEE754< Scalar >;
+            const Scalar log2e = 1.4426950408889634073599;
+            const Scalar c1 = 6.93145751953125E-1;
+            const Scalar c2 = 1.42860682030941723212E-6;
+
+            auto y = select( x > Traits::maxLog, S( Traits::maxLog ),
+                             select( x < Traits::minLog, S( Traits::minLog ), x ) );
+            // express exp(x) as exp(y) * 2^n with |y| <= ln(2)/2
+            const auto n = floor( log2e * y + Scalar( 0.5 ) );
+            y -= n * c1;
+            y -= n * c2;
+            y = ldexp( expReduced( y ), n );
+
+            return select( x > Traits::maxLog, S( std::numeric_limits< Scalar >::infinity() ),
+                           select( x < Traits::minLog, S( 0 ), y ) );
+        }
+
+        // Cephes, log.c
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > log( const Simd< Scalar, lanes >& x )
+        {
+            using S = Simd< Scalar, lanes >;
+            static const double P[] = {1.01875663804580931796E-4, 4.97494994976747001425E-1,
+                                       4.70579119878881725854E0,  1.44989225341610930846E1,
+                                       1.79368678507819816313E1,  7.70838733755885391666E0};
+            static const double Q[] = {1.12873587189167450590E1, 4.52279145837532221105E1,
+                                       8.29875266912776603211E1, 7.11544750618563894466E1,
+                                       2.31251620126765340583E1};
+            const Scalar sqrtHalf = 0.70710678118654752440;
+
+            S e;
+            auto m = frexp( x, e );
+            const auto small = m < sqrtHalf;
+            e = select( small, e - Scalar( 1 ), e );
+            m = select( small, m + m - Scalar( 1 ), m - Scalar( 1 ) );
+
+            // log(1+m) = m - m^2/2 + m^3 P(m)/Q(m)
+            const auto z = m * m;
+            auto y = m * ( z * polevl( m, P ) / p1evl( m, Q ) );
+            y -= e * Scalar( 2.121944400546905827679e-4 );
+            y -= Scalar( 0.5 ) * z;
+            y += m;
+            y += e * Scalar( 0.693359375 );
+
+            const auto inf = std::numeric_limits< Scalar >::infinity();
+            y = select( x == inf, S( inf ), y );
+            y = select( x == Scalar( 0 ), S( -inf ), y );
+            return select( x < Scalar( 0 ) || x != x,
+                           S( std::numeric_limits< Scalar >::quiet_NaN() ), y );
+        }
+
+        // Cephes, pow.c
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > pow( const Simd< Scalar, lanes >& x, const Simd< Scalar, lanes >& y )
+        {
+            using S = Simd< Scalar, lanes >;
+            using Limits = std::numeric_limits< Scalar >;
+            // 2^(-i/16), rounded to double
+            static const double A[] = {
+                1.0,                0.9576032806985737, 0.9170040432046712, 0.8781260801866497,
+                0.8408964152537145, 0.8052451659746271, 0.7711054127039704, 0.7384130729697497,
+                0.7071067811865476, 0.6771277734684463, 0.6484197773255048, 0.620928906036742,
+                0.5946035575013605, 0.5693943173783458, 0.5452538663326288, 0.5221368912137069,
+                0.5};
+            // 2^(-2i/16) - A[2i]
+            static const double B[] = {0.0,
+                                       1.64155361212281360176E-17,
+                                       4.09950501029074826006E-17,
+                                       3.97491740484881042808E-17,
+                                       -4.83364665672645672553E-17,
+                                       1.26912513974441574796E-17,
+                                       1.99100761573282305549E-17,
+                                       -1.52339103990623557348E-17,
+                                       0.0};
+            static const double P[] = {4.97778295871696322025E-1, 3.73336776063286838734E0,
+                                       7.69994162726912503298E0, 4.66651806774358464979E0};
+            static const double Q[] = {9.33340916416696166113E0, 2.79999886606328401649E1,
+                                       3.35994905342304405431E1, 1.39995542032307539578E1};
+            const Scalar log2eMinusOne = 0.44269504088896340736;
+            const Scalar ln2 = 0.693147180559945309417232121458176568;
+            // bounds of 16 log2 of the result
+            const Scalar maxExponent = 16 * Limits::max_exponent - 1;
+            const Scalar minExponent = 16 * ( Limits::min_exponent - Limits::digits );
+            const auto a = []( int i ) { return static_cast< Scalar >( A[ i ] ); };
+            // split off multiples of 1/16
+            const auto reduce = []( const S& t ) {
+                return Scalar( 0.0625 ) * floor( Scalar( 16 ) * t );
+            };
+
+            const auto ax = abs( x );
+            S e;
+            const auto m = frexp( ax, e );
+
+            // find 2^(-i/16) close to m, and the rounding error of its representation
+            S i( 0 ), ai( 1 ), bi( 0 );
+            for ( int k = 1; k <= 8; ++k )
+            {
+                const auto smaller = m <= a( 2 * k - 1 );
+                i = select( smaller, S( Scalar( 2 * k ) ), i );
+                ai = select( smaller, S( a( 2 * k ) ), ai );
+                bi = select( smaller,
+                             S( static_cast< Scalar >( A[ 2 * k ] - a( 2 * k ) + B[ k ] ) ), bi );
+            }
+
+            // log2(|x|) = w + z with w = e - i/16 and z = log2(1+v), v = m/2^(-i/16) - 1
+            const auto v = ( m - ai - bi ) / ai;
+            auto z = v * v;
+            auto w = v * ( z * polevl( v, P ) / p1evl( v, Q ) ) - Scalar( 0.5 ) * z;
+            w += log2eMinusOne * w;
+            z = w + log2eMinusOne * v + v;
+            w = e - Scalar( 0.0625 ) * i;
+
+            // y log2(|x|) in extended precision, separating multiples of 1/16
+            const auto ya = reduce( y );
+            const auto yb = y - ya;
+            const auto F = z * y + w * yb;
+            const auto Fa = reduce( F );
+            const auto Fb = F - Fa;
+            const auto G = Fa + w * ya;
+            const auto Ga = reduce( G );
+            const auto Gb = G - Ga;
+            const auto H = Fb + Gb;
+            const auto Ha = reduce( H );
+            const auto n16 = Scalar( 16 ) * ( Ga + Ha );
+            const auto overflow = n16 > maxExponent;
+            const auto underflow = n16 < minExponent;
+
+            // y log2(|x|) = n + f with integral n and f in [-0.5,0.5], where f is exact up to
+            // rounding, as Ga + Ha is a multiple of 1/16 and H - Ha is in [0,1/16[
+            const auto t = Scalar( 0.0625 ) *
+                           select( overflow, S( maxExponent ),
+                                   select( underflow, S( minExponent ), n16 ) );
+            const auto h = H - Ha;
+            const auto n = floor( t + h + Scalar( 0.5 ) );
+            auto result = ldexp( expReduced( ( t - n + h ) * ln2 ), n );
+
+            const auto inf = Limits::infinity();
+            result = select( overflow, S( inf ), select( underflow, S( 0 ), result ) );
+            result =
+                select( ax == Scalar( 0 ), select( y < Scalar( 0 ), S( inf ), S( 0 ) ), result );
+            result = select( ax == inf, select( y < Scalar( 0 ), S( 0 ), S( inf ) ), result );
+            const auto grows = ( ax > Scalar( 1 ) && y > Scalar( 0 ) ) ||
+                               ( ax < Scalar( 1 ) && y < Scalar( 0 ) );
+            result = select( abs( y ) == inf,
+                             select( ax == Scalar( 1 ), S( 1 ), select( grows, S( inf ), S( 0 ) ) ),
+                             result );
+
+            // negative base requires integral exponent
+            const auto negative = x < Scalar( 0 );
+            const auto integral = floor( y ) == y;
+            const auto odd = integral && ( Scalar( 2 ) * floor( Scalar( 0.5 ) * y ) != y );
+            result = select( negative && odd, -result, result );
+            result = select( ( negative && !integral ) || x != x || y != y,
+                             S( Limits::quiet_NaN() ), result );
+            return select( y == Scalar( 0 ) || x == Scalar( 1 ), S( 1 ), result );
+        }
+
+        // Cephes, ndtr.c
+        template < class Scalar, int lanes >
+        Simd< Scalar, lanes > erf( const Simd< Scalar, lanes >& x )
+        {
+            static const double T[] = {9.60497373987051638749E0, 9.00260197203842689217E1,
+                                       2.23200534594684319226E3, 7.00332514112805075473E3,
+                                       5.55923013010394962768E4};
+            static const double U[] = {3.35617141647503099647E1, 5.21357949780152679795E2,
+                                       4.59432382970980127987E3, 2.26290000613890934246E4,
+                                       4.92673942608635921086E4};
+            static const double P[] = {2.46196981473530512524E-10, 5.64189564831068821977E-1,
+                                       7.46321056442269912687E0,   4.86371970985681366614E1,
+                                       1.96520832956077098242E2,   5.26445194995477358631E2,
+                                       9.34528527171957607540E2,   1.02755188689515710272E3,
+                                       5.57535335369399327526E2};
+            static const double Q[] = {1.32281951154744992508E1, 8.67072140885989742329E1,
+                                       3.54937778887819891062E2, 9.75708501743205489753E2,
+                                       1.82390916687909736289E3, 2.24633760818710981792E3,
+                                       1.65666309194161350182E3, 5.57535340817727675546E2};
+
+            const auto z = x * x;
+            const auto ax = abs( x );
+            const auto small = x * polevl( z, T ) / p1evl( z, U );
+            // 1 - erfc(|x|) for |x| > 1
+            const auto large = Scalar( 1 ) - exp( -z ) * polevl( ax, P ) / p1evl( ax, Q );
+            return select( ax <= Scalar( 1 ), small, select( x < Scalar( 0 ), -large, large ) );
+        }
+    }
+    /// @endcond
+}
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <fung/util/simd.hh>
+
+#include <Eigen/Core>
+
+namespace Eigen
+{
+    /// Use FunG::Simd as scalar type of Eigen matrices, such that matrices of packs hold 'lanes'
+    /// matrices, one per lane (see FunG::evaluate for batches of matrices).
+    template < class Scalar, int lanes >
+    struct NumTraits< FunG::Simd< Scalar, lanes > > : GenericNumTraits< Scalar >
+    {
+        using Real = FunG::Simd< Scalar, lanes >;
+        using NonInteger = FunG::Simd< Scalar, lanes >;
+        using Nested = FunG::Simd< Scalar, lanes >;
+        using Literal = FunG::Simd< Scalar, lanes >;
+
+        enum
+        {
+            IsComplex = 0,
+            IsInteger = 0,
+            IsSigned = 1,
+            RequireInitialization = 1,
+            ReadCost = 1,
+            AddCost = 1,
+            MulCost = 1
+        };
+    };
+
+    /// @cond
+    template < class Scalar, int lanes, class BinaryOp >
+    struct ScalarBinaryOpTraits< FunG::Simd< Scalar, lanes >, Scalar, BinaryOp >
+    {
+        using ReturnType = FunG::Simd< Scalar, lanes >;
+    };
+
+    template < class Scalar, int lanes, class BinaryOp >
+    struct ScalarBinaryOpTraits< Scalar, FunG::Simd< Scalar, lanes >, BinaryOp >
+    {
+        using ReturnType = FunG::Simd< Scalar, lanes >;
+    };
+    /// @endcond
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+namespace FunG
+{
+    /// @cond
+    namespace Detail
+    {
+#ifdef FUNG_REFERENCE_STORAGE
+        /**
+         * @brief Storage for the argument of update.
+         *
+         * If FUNG_REFERENCE_STORAGE is defined only a reference to the argument is kept. Then
+         * arguments passed to update must outlive the evaluation of the function and its
+         * derivatives. Inside chains this holds automatically, since the arguments of the outer
+         * function are owned by the inner function.
+         */
+        template < class T >
+        class Storage
+        {
+        public:
+            void store( const T& x ) noexcept
+            {
+                value = &x;
+            }
+
+            const T& get() const noexcept
+            {
+                return *value;
+            }
+
+        private:
+            const T* value = nullptr;
+        };
+#else
+        /**
+         * @brief Storage for the argument of update.
+         *
+         * Holds a copy of the argument. Define FUNG_REFERENCE_STORAGE to only keep a reference.
+         */
+        template < class T >
+        class Storage
+        {
+        public:
+            void store( const T& x )
+            {
+                value = x;
+            }
+
+            const T& get() const noexcept
+            {
+                return value;
+            }
+
+        private:
+            T value;
+        };
+#endif
+    }
+    /// @endcond
+}
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <cmath>
+#include <utility>
+
+namespace FunG
+{
+    /// @cond
+    namespace Detail
+    {
+        /// Scalar version of select( mask, x, y ) for packs of scalars, see Simd.
+        template < class Scalar >
+        Scalar select( bool mask, const Scalar& x, const Scalar& y )
+        {
+            return mask ? x : y;
+        }
+    }
+    /// @endcond
+
+    /**
+     * @brief Scalar that carries its first three derivatives with respect to one variable, i.e.
+     * a truncated Taylor expansion of third order.
+     *
+     * Evaluating a function g for Taylor<Scalar>::variable(x) yields \f$g(x)\f$, \f$g'(x)\f$,
+     * \f$g''(x)\f$ and \f$g'''(x)\f$ in one pass. This allows differentiating scalar code that is
+     * written generically in its argument type, such as a tabulated hardening law:
+     * @code
+     * auto g = []( auto x ) { using std::exp; return x < 1 ? x * x : exp( x - 1 ); };
+     * const auto y = g( Taylor<>::variable( 2. ) ); // y.d0(), y.d1(), y.d2(), y.d3()
+     * @endcode
+     * Functions of \<cmath\> must be called unqualified (i.e. after using std::exp), such that
+     * the overloads for Taylor are found. Comparisons only consider the function values.
+     *
+     * With Scalar = Simd<double,4> each operation processes four points of evaluation.
+     *
+     * @tparam Scalar double or a pack of scalars, such as Simd<double,4>
+     */
+    template < class Scalar = double >
+    class Taylor
+    {
+    public:
+        /// Constant, i.e. all derivatives vanish.
+        Taylor( Scalar value = Scalar( 0 ) )
+            : Taylor( std::move( value ), Scalar( 0 ), Scalar( 0 ), Scalar( 0 ) )
+        {
+        }
+
+        /// Value and first three derivatives.
+        Taylor( Scalar value, Scalar d1, Scalar d2, Scalar d3 )
+            : v0( std::move( value ) ), v1( std::move( d1 ) ), v2( std::move( d2 ) ),
+              v3( std::move( d3 ) )
+        {
+        }
+
+        /// Independent variable, i.e. \f$x'=1\f$.
+        static Taylor variable( Scalar x )
+        {
+            return Taylor( std::move( x ), Scalar( 1 ), Scalar( 0 ), Scalar( 0 ) );
+        }
+
+        /// Function value.
+        const Scalar& d0() const noexcept
+        {
+            return v0;
+        }
+
+        /// First derivative.
+        const Scalar& d1() const noexcept
+        {
+            return v1;
+        }
+
+        /// Second derivative.
+        const Scalar& d2() const noexcept
+        {
+            return v2;
+        }
+
+        /// Third derivative.
+        const Scalar& d3() const noexcept
+        {
+            return v3;
+        }
+
+        Taylor& operator+=( const Taylor& y )
+        {
+            v0 += y.v0;
+            v1 += y.v1;
+            v2 += y.v2;
+            v3 += y.v3;
+            return *this;
+        }
+
+        Taylor& operator+=( const Scalar& a )
+        {
+            v0 += a;
+            return *this;
+        }
+
+        Taylor& operator-=( const Taylor& y )
+        {
+            v0 -= y.v0;
+            v1 -= y.v1;
+            v2 -= y.v2;
+            v3 -= y.v3;
+            return *this;
+        }
+
+        Taylor& operator-=( const Scalar& a )
+        {
+            v0 -= a;
+            return *this;
+        }
+
+        /// Leibniz rule.
+        Taylor& operator*=( const Taylor& y )
+        {
+            v3 = v3 * y.v0 + 3 * ( v2 * y.v1 + v1 * y.v2 ) + v0 * y.v3;
+            v2 = v2 * y.v0 + 2 * v1 * y.v1 + v0 * y.v2;
+            v1 = v1 * y.v0 + v0 * y.v1;
+            v0 *= y.v0;
+            return *this;
+        }
+
+        Taylor& operator*=( const Scalar& a )
+        {
+            v0 *= a;
+            v1 *= a;
+            v2 *= a;
+            v3 *= a;
+            return *this;
+        }
+
+        Taylor& operator/=( const Taylor& y )
+        {
+            return *this *= reciprocal( y );
+        }
+
+        Taylor& operator/=( const Scalar& a )
+        {
+            return *this *= Scalar( 1 ) / a;
+        }
+
+        friend Taylor operator+( const Taylor& x )
+        {
+            return x;
+        }
+
+        friend Taylor operator-( const Taylor& x )
+        {
+            return Taylor( -x.v0, -x.v1, -x.v2, -x.v3 );
+        }
+
+        friend Taylor operator+( Taylor x, const Taylor& y )
+        {
+            return x += y;
+        }
+
+        friend Taylor operator+( Taylor x, const Scalar& a )
+        {
+            return x += a;
+        }
+
+        friend Taylor operator+( const Scalar& a, Taylor x )
+        {
+            return x += a;
+        }
+
+        friend Taylor operator-( Taylor x, const Taylor& y )
+        {
+            return x -= y;
+        }
+
+        friend Taylor operator-( Taylor x, const Scalar& a )
+        {
+            return x -= a;
+        }
+
+        friend Taylor operator-( const Scalar& a, const Taylor& x )
+        {
+            return -x + a;
+        }
+
+        friend Taylor operator*( Taylor x, const Taylor& y )
+        {
+            return x *= y;
+        }
+
+        friend Taylor operator*( Taylor x, const Scalar& a )
+        {
+            return x *= a;
+        }
+
+        friend Taylor operator*( const Scalar& a, Taylor x )
+        {
+            return x *= a;
+        }
+
+        friend Taylor operator/( Taylor x, const Taylor& y )
+        {
+            return x /= y;
+        }
+
+        friend Taylor operator/( Taylor x, const Scalar& a )
+        {
+            return x /= a;
+        }
+
+        friend Taylor operator/( const Scalar& a, const Taylor& x )
+        {
+            return reciprocal( x ) *= a;
+        }
+
+        friend auto operator<( const Taylor& x, const Taylor& y )
+        {
+            return x.v0 < y.v0;
+        }
+
+        friend auto operator<=( const Taylor& x, const Taylor& y )
+        {
+            return x.v0 <= y.v0;
+        }
+
+        friend auto operator>( const Taylor& x, const Taylor& y )
+        {
+            return x.v0 > y.v0;
+        }
+
+        friend auto operator>=( const Taylor& x, const Taylor& y )
+        {
+            return x.v0 >= y.v0;
+        }
+
+        friend auto operator==( const Taylor& x, const Taylor& y )
+        {
+            return x.v0 == y.v0;
+        }
+
+        friend auto operator!=( const Taylor& x, const Taylor& y )
+        {
+            return x.v0 != y.v0;
+        }
+
+        friend Taylor exp( const Taylor& x )
+        {
+            using std::exp;
+            const auto e_x = exp( x.v0 );
+            return compose( x, e_x, e_x, e_x, e_x );
+        }
+
+        friend Taylor log( const Taylor& x )
+        {
+            using std::log;
+            const auto inv = Scalar( 1 ) / x.v0;
+            return compose( x, log( x.v0 ), inv, -inv * inv, 2 * inv * inv * inv );
+        }
+
+        friend Taylor sqrt( const Taylor& x )
+        {
+            using std::sqrt;
+            const auto root = sqrt( x.v0 );
+            const auto inv = Scalar( 1 ) / x.v0;
+            const auto first = Scalar( 0.5 ) / root;
+            const auto second = Scalar( -0.5 ) * first * inv;
+            return compose( x, root, first, second, Scalar( -1.5 ) * second * inv );
+        }
+
+        /// \f$x^a\f$. For \f$x=0\f$ derivatives whose factor \f$a(a-1)\cdots\f$ vanishes are zero.
+        friend Taylor pow( const Taylor& x, const Scalar& a )
+        {
+            using std::pow;
+            using Detail::select;
+            const auto term = [&x]( const Scalar& c, const Scalar& exponent ) {
+                return select( c == Scalar( 0 ), Scalar( 0 ), c * pow( x.v0, exponent ) );
+            };
+            const auto c2 = a * ( a - 1 );
+            return compose( x, pow( x.v0, a ), term( a, a - 1 ), term( c2, a - 2 ),
+                            term( c2 * ( a - 2 ), a - 3 ) );
+        }
+
+        /// \f$x^y=\exp(y\log(x))\f$ for \f$x>0\f$.
+        friend Taylor pow( const Taylor& x, const Taylor& y )
+        {
+            return exp( y * log( x ) );
+        }
+
+        friend Taylor sin( const Taylor& x )
+        {
+            using std::sin;
+            using std::cos;
+            const auto s = sin( x.v0 );
+            const auto c = cos( x.v0 );
+            return compose( x, s, c, -s, -c );
+        }
+
+        friend Taylor cos( const Taylor& x )
+        {
+            using std::sin;
+            using std::cos;
+            const auto s = sin( x.v0 );
+            const auto c = cos( x.v0 );
+            return compose( x, c, -s, -c, s );
+        }
+
+        friend Taylor tan( const Taylor& x )
+        {
+            using std::tan;
+            const auto t = tan( x.v0 );
+            const auto first = 1 + t * t;
+            const auto second = 2 * t * first;
+            return compose( x, t, first, second, 2 * ( first * first + t * second ) );
+        }
+
+        friend Taylor erf( const Taylor& x )
+        {
+            using std::erf;
+            using std::exp;
+            const auto first = Scalar( 2 / std::sqrt( M_PI ) ) * exp( -x.v0 * x.v0 );
+            return compose( x, erf( x.v0 ), first, -2 * x.v0 * first,
+                            ( 4 * x.v0 * x.v0 - 2 ) * first );
+        }
+
+    private:
+        /// Derivatives of \f$f(x)\f$ from the derivatives of f at x.d0() (Faa di Bruno).
+        static Taylor compose( const Taylor& x, Scalar f0, const Scalar& f1, const Scalar& f2,
+                               const Scalar& f3 )
+        {
+            const auto dx2 = x.v1 * x.v1;
+            return Taylor( std::move( f0 ), f1 * x.v1, f2 * dx2 + f1 * x.v2,
+                           f3 * dx2 * x.v1 + 3 * f2 * x.v1 * x.v2 + f1 * x.v3 );
+        }
+
+        static Taylor reciprocal( const Taylor& x )
+        {
+            const auto inv = Scalar( 1 ) / x.v0;
+            const auto inv2 = inv * inv;
+            return compose( x, inv, -inv2, 2 * inv2 * inv, -6 * inv2 * inv2 );
+        }
+
+        Scalar v0, v1, v2, v3;
+    };
+}
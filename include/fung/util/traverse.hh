@@ -4,6 +4,17 @@
 
 namespace FunG
 {
+    /// @cond
+    namespace MathematicalOperations
+    {
+        template < class, class, class >
+        struct Scale;
+    }
+
+    template < class >
+    class Profiled;
+    /// @endcond
+
     namespace Meta
     {
         template < class F, template < class > class Operation,
@@ -20,10 +31,13 @@ namespace FunG
         {
         };
 
-        // for Scale
-        template < template < class, class, class > class G, class Scalar, class F,
-                   template < class > class Operation, template < class, class > class Combine >
-        struct Traverse< G< Scalar, F, Concepts::FunctionConceptCheck< F > >, Operation, Combine >
+        // for Scale (not matched via a template template parameter, since with C++17 this would
+        // also match the binary operations below if both operands have the same type)
+        template < class Scalar, class F, template < class > class Operation,
+                   template < class, class > class Combine >
+        struct Traverse<
+            MathematicalOperations::Scale< Scalar, F, Concepts::FunctionConceptCheck< F > >,
+            Operation, Combine >
             : Traverse< F, Operation, Combine >
         {
         };
@@ -36,6 +50,13 @@ namespace FunG
         {
         };
 
+        // for Profiled
+        template < class F, template < class > class Operation,
+                   template < class, class > class Combine >
+        struct Traverse< Profiled< F >, Operation, Combine > : Traverse< F, Operation, Combine >
+        {
+        };
+
         // For Sum, Product, Chain
         template < template < class, class, class, class > class H, class F, class G,
                    template < class > class Operation, template < class, class > class Combine >
@@ -48,4 +48,14 @@ namespace FunG
     /// Access underlying type (if it is hidden by expression templates).
     template < class F >
     using remove_reference_t = typename Decay< std::remove_reference_t< F > >::type;
+
+    /**
+     * @brief Scalar type of the functions in CMathGroup for arguments of type F.
+     *
+     * This is double for built-in arithmetic types and F for registered arithmetic types, such as
+     * Simd.
+     */
+    template < class F >
+    using cmath_scalar_t =
+        std::conditional_t< std::is_arithmetic< decay_t< F > >::value, double, decay_t< F > >;
 }
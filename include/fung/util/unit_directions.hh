@@ -0,0 +1,87 @@
+#pragma once
+
+#include <fung/linear_algebra/basis_direction.hh>
+#include <fung/linear_algebra/rows_and_cols.hh>
+#include <fung/util/at.hh>
+#include <fung/util/static_checks.hh>
+#include <fung/util/type_traits.hh>
+#include <fung/util/zero.hh>
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+namespace FunG
+{
+    /// @cond
+    namespace Detail
+    {
+        /// Access to the scalar components of arithmetic types and matrices of constant size.
+        template < class Arg, bool = is_arithmetic< Arg >::value >
+        struct Components
+        {
+            using Scalar = Arg;
+            static constexpr int value = 1;
+
+            static Scalar& entry( Arg& x, int )
+            {
+                return x;
+            }
+        };
+
+        template < class Matrix >
+        struct Components< Matrix, false >
+        {
+            static_assert( Checks::isConstantSize< Matrix >(),
+                           "Access to components requires arguments of constant size." );
+
+            using Scalar = std::decay_t< decltype( at( std::declval< Matrix& >(), 0, 0 ) ) >;
+            static constexpr int value =
+                LinearAlgebra::rows< Matrix >() * LinearAlgebra::cols< Matrix >();
+
+            static decltype( auto ) entry( Matrix& A, int k )
+            {
+                return at( A, k / LinearAlgebra::cols< Matrix >(),
+                           k % LinearAlgebra::cols< Matrix >() );
+            }
+        };
+
+        /// Unit directions \f$e_k\f$, where entries are enumerated row-wise for matrices.
+        template < class Arg >
+        auto unitDirections()
+        {
+            std::array< Arg, Components< Arg >::value > e;
+            for ( int k = 0; k < Components< Arg >::value; ++k )
+            {
+                e[ k ] = zero< Arg >();
+                Components< Arg >::entry( e[ k ], k ) = 1;
+            }
+            return e;
+        }
+
+        /// Unit directions \f$e_k\f$ of arithmetic types, see unitDirections().
+        template < class Arg, std::enable_if_t< is_arithmetic< Arg >::value >* = nullptr >
+        auto basisDirections()
+        {
+            return unitDirections< Arg >();
+        }
+
+        template < class Matrix, std::size_t... k >
+        auto basisDirections( std::index_sequence< k... > )
+        {
+            constexpr int cols = LinearAlgebra::cols< Matrix >();
+            return std::array< LinearAlgebra::BasisDirection< Matrix >, sizeof...( k ) >{
+                {LinearAlgebra::BasisDirection< Matrix >( int( k ) / cols, int( k ) % cols )...}};
+        }
+
+        /// Unit directions \f$e_k\f$ of matrices as LinearAlgebra::BasisDirection, enumerated
+        /// row-wise, such that functions may exploit their sparsity.
+        template < class Matrix, std::enable_if_t< !is_arithmetic< Matrix >::value >* = nullptr >
+        auto basisDirections()
+        {
+            return basisDirections< Matrix >(
+                std::make_index_sequence< Components< Matrix >::value >() );
+        }
+    }
+    /// @endcond
+}
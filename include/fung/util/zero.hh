@@ -4,6 +4,8 @@
 #ifndef FUNG_UTIL_ZERO_HH
 #define FUNG_UTIL_ZERO_HH
 
+#include <map>
+#include <mutex>
 #include <utility>
 
 #include "static_checks.hh"
@@ -20,6 +22,34 @@ namespace FunG
     template <class Matrix>
     using TryCallToFill   = decltype(std::declval<Matrix>().fill(0));
   }
+
+  namespace Detail
+  {
+    /**
+     * @brief Immutable instance create(key), shared by all threads and created only once per key.
+     *
+     * Instances live until program exit, thus the returned reference may be stored. Each thread remembers the last
+     * requested instance, so that repeated requests for the same key do not lock.
+     */
+    template <class T, class Key, class Create>
+    const T& sharedInstance(const Key& key, Create create)
+    {
+      static thread_local const T* last = nullptr;
+      static thread_local Key lastKey{};
+      if( last != nullptr && lastKey == key )
+        return *last;
+
+      static std::mutex mutex;
+      static std::map<Key,T> instances;
+      std::lock_guard<std::mutex> lock(mutex);
+      auto entry = instances.find(key);
+      if( entry == end(instances) )
+        entry = instances.emplace(key, create(key)).first;
+      lastKey = key;
+      last = &entry->second;
+      return *last;
+    }
+  }
   /// @endcond
 
   /// Specialize this struct for your matrix type if a zero matrix cannot be generated via Matrix(0.).
@@ -75,6 +105,30 @@ namespace FunG
     Matrix m(rows,cols);
     return Zero<Matrix>::generate(m);
   }
+
+  /**
+   * @brief Shared, immutable zero matrix, generated only once per type.
+   * @return constant reference to constant size zero matrix
+   */
+  template <class Matrix,
+            class = std::enable_if_t<Checks::isConstantSize<Matrix>() || is_arithmetic<Matrix>::value> >
+  const Matrix& cachedZero()
+  {
+    static const Matrix m = zero<Matrix>();
+    return m;
+  }
+
+  /**
+   * @brief Shared, immutable zero matrix, generated only once per type and size.
+   * @return constant reference to dynamic size zero matrix
+   */
+  template <class Matrix,
+            class = std::enable_if_t<!Checks::isConstantSize<Matrix>() && !is_arithmetic<Matrix>::value> >
+  const Matrix& cachedZero(int rows, int cols)
+  {
+    return Detail::sharedInstance<Matrix>(std::make_pair(rows,cols),
+                                          [](const std::pair<int,int>& size) { return zero<Matrix>(size.first,size.second); });
+  }
 }
 
 #endif // FUNG_UTIL_ZERO_HH
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <fung/linear_algebra/basis_direction.hh>
 #include <fung/util/traverse.hh>
 
 #include <limits>
@@ -69,7 +70,7 @@ namespace FunG
             }
         };
 
-        template < class T, class Other >
+        template < class T, class Other, class = void >
         struct ExtractReturnValue;
 
         template < class T >
@@ -81,6 +82,20 @@ namespace FunG
             }
         };
 
+        /// Directions of a type derived from T or LinearAlgebra::BasisDirection< T >.
+        template < class T, class Direction >
+        struct ExtractReturnValue<
+            T, Direction,
+            std::enable_if_t< !std::is_same< T, Direction >::value &&
+                              ( std::is_base_of< T, Direction >::value ||
+                                LinearAlgebra::IsBasisDirection< Direction, T >::value ) > >
+        {
+            static const T& apply( const Direction& x )
+            {
+                return x;
+            }
+        };
+
         template < class T, class Gradient >
         struct ExtractReturnValue< T, std::tuple< T, Gradient > >
         {
@@ -367,11 +382,15 @@ namespace FunG
             }
         } // namespace Has
 
-        /// Check if variable with index id has type Type.
+        /// Check if variable with index id has type Type or is a base of Type, or if Type is a
+        /// LinearAlgebra::BasisDirection for this variable.
         template < class F, class Type, int id >
         struct CheckArgument
         {
-            static constexpr bool value = ContainsType< Variable_t< F, id >, Type >::value;
+            static constexpr bool value =
+                ContainsType< Variable_t< F, id >, Type >::value ||
+                std::is_base_of< Variable_t< F, id >, Type >::value ||
+                LinearAlgebra::IsBasisDirection< Type, Variable_t< F, id > >::value;
         };
         /** @} */
     } // namespace Checks
@@ -0,0 +1,196 @@
+#define FUNG_ENABLE_EXCEPTIONS
+#include <fung/cmath/auto_diff.hh>
+#include <fung/cmath/cosine.hh>
+#include <fung/cmath/erf.hh>
+#include <fung/cmath/exp.hh>
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/cmath/sine.hh>
+#include <fung/cmath/tan.hh>
+#include <fung/concept_check.hh>
+#include <fung/finalize.hh>
+#include <fung/generate.hh>
+#include <fung/identity.hh>
+#include <fung/util/simd.hh>
+#include <fung/util/taylor.hh>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+
+namespace
+{
+    using FunG::Taylor;
+
+    /// Compares all derivatives of g at x, computed in forward mode, with those of the function f.
+    template < class Function, class Reference >
+    void expectSameDerivatives( Function g, Reference f, double x )
+    {
+        f.update( x );
+        const auto y = g( Taylor<>::variable( x ) );
+        EXPECT_NEAR( y.d0(), f.d0(), 1e-14 * std::abs( f.d0() ) );
+        EXPECT_NEAR( y.d1(), f.d1( 1. ), 1e-14 * std::abs( f.d1( 1. ) ) );
+        EXPECT_NEAR( y.d2(), f.d2( 1., 1. ), 1e-14 * std::abs( f.d2( 1., 1. ) ) );
+        EXPECT_NEAR( y.d3(), f.d3( 1., 1., 1. ), 1e-14 * std::abs( f.d3( 1., 1., 1. ) ) );
+    }
+
+    /// Piecewise linear interpolation of tabulated values, smoothed by a logarithmic term.
+    template < class Scalar >
+    Scalar hardening( const Scalar& x )
+    {
+        using std::log;
+        static const std::array< double, 4 > strain{{0., 0.1, 0.2, 0.4}};
+        static const std::array< double, 4 > stress{{1., 1.5, 1.8, 2.}};
+        int i = 0;
+        while ( i < 2 && x > strain[ i + 1 ] )
+            ++i;
+        const auto t = ( x - strain[ i ] ) / ( strain[ i + 1 ] - strain[ i ] );
+        return ( 1 - t ) * stress[ i ] + t * stress[ i + 1 ] + 0.1 * x * log( 1 + x );
+    }
+}
+
+TEST( TaylorTest, ArithmeticConcept )
+{
+    FunG::Concepts::ArithmeticConceptCheck< Taylor<> >();
+    const auto f = FunG::identity( Taylor<>::variable( 2. ) );
+    EXPECT_EQ( f.d0().d1(), 1. );
+}
+
+TEST( TaylorTest, Arithmetic )
+{
+    const auto x = Taylor<>::variable( 2. );
+    const auto y = ( x * x * x - 2 * x + 1. ) / ( 1 + x ) - 3. / x;
+    // y = x^2 - x - 1 + 2/(1+x) - 3/x
+    EXPECT_DOUBLE_EQ( y.d0(), 4. - 2. - 1. + 2. / 3. - 1.5 );
+    EXPECT_DOUBLE_EQ( y.d1(), 4. - 1. - 2. / 9. + 0.75 );
+    EXPECT_DOUBLE_EQ( y.d2(), 2. + 4. / 27. - 0.75 );
+    EXPECT_DOUBLE_EQ( y.d3(), -12. / 81. + 1.125 );
+
+    EXPECT_TRUE( x < 3 );
+    EXPECT_TRUE( 1 < x );
+    EXPECT_TRUE( x == Taylor<>( 2. ) );
+}
+
+TEST( TaylorTest, ElementaryFunctions )
+{
+    using std::cos;
+    using std::erf;
+    using std::exp;
+    using std::log;
+    using std::pow;
+    using std::sin;
+    using std::sqrt;
+    using std::tan;
+    const auto x = 0.7;
+    expectSameDerivatives( []( auto y ) { return exp( y ); }, FunG::Exp(), x );
+    expectSameDerivatives( []( auto y ) { return log( y ); }, FunG::LN(), x );
+    expectSameDerivatives( []( auto y ) { return sqrt( y ); }, FunG::Sqrt(), x );
+    expectSameDerivatives( []( auto y ) { return pow( y, 2.5 ); }, FunG::Pow< 5, 2 >(), x );
+    expectSameDerivatives( []( auto y ) { return sin( y ); }, FunG::Sin(), x );
+    expectSameDerivatives( []( auto y ) { return cos( y ); }, FunG::Cos(), x );
+    expectSameDerivatives( []( auto y ) { return tan( y ); }, FunG::Tan(), x );
+    expectSameDerivatives( []( auto y ) { return erf( y ); }, FunG::Erf(), x );
+    expectSameDerivatives( []( auto y ) { return pow( y, 1 + y ); },
+                           FunG::finalize( FunG::exp( ( 1 + FunG::identity( x ) ) *
+                                                      FunG::ln( FunG::identity( x ) ) ) ),
+                           x );
+}
+
+TEST( TaylorTest, PowAtZero )
+{
+    using std::pow;
+    const auto y = pow( Taylor<>::variable( 0. ), 2. );
+    EXPECT_EQ( y.d0(), 0. );
+    EXPECT_EQ( y.d1(), 0. );
+    EXPECT_EQ( y.d2(), 2. );
+    EXPECT_EQ( y.d3(), 0. );
+
+    const auto z = pow( Taylor<>::variable( 0. ), 3. );
+    EXPECT_EQ( z.d0(), 0. );
+    EXPECT_EQ( z.d1(), 0. );
+    EXPECT_EQ( z.d2(), 0. );
+    EXPECT_EQ( z.d3(), 6. );
+
+    using Pack = FunG::Simd< double, 4 >;
+    const auto a = Pack::load( std::array< double, 4 >{{0., 1., 2., 3.}}.data() );
+    const auto w = pow( Taylor< Pack >::variable( Pack( 0. ) ), a );
+    const std::array< std::array< double, 4 >, 4 > expected{
+        {{{1., 0., 0., 0.}}, {{0., 1., 0., 0.}}, {{0., 0., 2., 0.}}, {{0., 0., 0., 6.}}}};
+    for ( int k = 0; k < Pack::size(); ++k )
+    {
+        EXPECT_EQ( w.d0()[ k ], expected[ k ][ 0 ] );
+        EXPECT_EQ( w.d1()[ k ], expected[ k ][ 1 ] );
+        EXPECT_EQ( w.d2()[ k ], expected[ k ][ 2 ] );
+        EXPECT_EQ( w.d3()[ k ], expected[ k ][ 3 ] );
+    }
+}
+
+TEST( TaylorTest, Simd )
+{
+    using Pack = FunG::Simd< double, 4 >;
+    using std::exp;
+    using std::log;
+    const auto g = []( auto y ) { return exp( y ) * log( 1 + y * y ) / y; };
+    const auto x = Pack::load( std::array< double, 4 >{{0.5, 1., 1.5, 2.}}.data() );
+    const auto y = g( Taylor< Pack >::variable( x ) );
+    for ( int k = 0; k < Pack::size(); ++k )
+    {
+        const auto z = g( Taylor<>::variable( x[ k ] ) );
+        EXPECT_NEAR( y.d0()[ k ], z.d0(), 1e-14 * std::abs( z.d0() ) );
+        EXPECT_NEAR( y.d1()[ k ], z.d1(), 1e-14 * std::abs( z.d1() ) );
+        EXPECT_NEAR( y.d2()[ k ], z.d2(), 1e-14 * std::abs( z.d2() ) );
+        EXPECT_NEAR( y.d3()[ k ], z.d3(), 1e-14 * std::abs( z.d3() ) );
+    }
+}
+
+TEST( AutoDiffTest, Leaf )
+{
+    using std::exp;
+    auto f = FunG::autoDiff( []( auto x ) { return exp( x ); } );
+    expectSameDerivatives( []( auto x ) { return exp( x ); }, f, 0.3 );
+    f.update( 0.3 );
+    EXPECT_DOUBLE_EQ( f.d1( 2. ), 2 * exp( 0.3 ) );
+    EXPECT_DOUBLE_EQ( f.d2( 2., 3. ), 6 * exp( 0.3 ) );
+    EXPECT_DOUBLE_EQ( f.d3( 2., 3., 4. ), 24 * exp( 0.3 ) );
+}
+
+TEST( AutoDiffTest, EvaluatesOnlyOnUpdate )
+{
+    int evaluations = 0;
+    auto f = FunG::autoDiff( [&evaluations]( auto x ) {
+        ++evaluations;
+        return x * x;
+    } );
+    EXPECT_EQ( evaluations, 0 );
+    f.update( 2. );
+    EXPECT_EQ( evaluations, 1 );
+    EXPECT_EQ( f.d1(), 4. );
+}
+
+TEST( AutoDiffTest, TabulatedHardening )
+{
+    auto f = FunG::autoDiff( []( auto x ) { return hardening( x ); } );
+    for ( auto x : {0.05, 0.15, 0.3} )
+    {
+        f.update( x );
+        const auto h = 1e-6;
+        EXPECT_DOUBLE_EQ( f(), hardening( x ) );
+        EXPECT_NEAR( f.d1(), ( hardening( x + h ) - hardening( x - h ) ) / ( 2 * h ), 1e-8 );
+        EXPECT_NEAR( f.d2(), 0.1 * ( 2 + x ) / ( ( 1 + x ) * ( 1 + x ) ), 1e-14 );
+        EXPECT_NEAR( f.d3(), -0.1 * ( 3 + x ) / ( ( 1 + x ) * ( 1 + x ) * ( 1 + x ) ), 1e-14 );
+    }
+}
+
+TEST( AutoDiffTest, Composition )
+{
+    using std::log;
+    const auto x = 0.4;
+    const auto h = 1 + FunG::Pow< 2 >()( FunG::identity( x ) );
+    auto f = FunG::finalize( FunG::autoDiff( []( auto y ) { return log( y ); } )( h ) );
+    auto g = FunG::finalize( FunG::ln( h ) );
+    EXPECT_DOUBLE_EQ( f(), g() );
+    EXPECT_DOUBLE_EQ( f.d1( 1. ), g.d1( 1. ) );
+    EXPECT_DOUBLE_EQ( f.d2( 1., 1. ), g.d2( 1., 1. ) );
+    EXPECT_DOUBLE_EQ( f.d3( 1., 1., 1. ), g.d3( 1., 1., 1. ) );
+}
@@ -386,3 +386,18 @@ TEST( PowDefaultTest, D3 )
     EXPECT_DOUBLE_EQ( fun.d3(), 0.5 * 1.5 * 2.5 * pow( x1(), -0.5 ) );
     EXPECT_DOUBLE_EQ( fun.d3( dx, dy, dz ), 0.5 * 1.5 * 2.5 * pow( x1(), -0.5 ) * dx * dy * dz );
 }
+
+TEST( PowDefaultTest, UpdateWithEvaluationOrder )
+{
+    FunG::Pow< 5, 2 > fun;
+    fun.update( x1(), FunG::ValueOnly() );
+    EXPECT_DOUBLE_EQ( fun.d0(), pow( x1(), 2.5 ) );
+    fun.update( x1(), FunG::UpToFirstDerivative() );
+    EXPECT_DOUBLE_EQ( fun.d0(), pow( x1(), 2.5 ) );
+    EXPECT_DOUBLE_EQ( fun.d1(), 2.5 * pow( x1(), 1.5 ) );
+    fun.update( x1(), FunG::UpToSecondDerivative() );
+    EXPECT_DOUBLE_EQ( fun.d1(), 2.5 * pow( x1(), 1.5 ) );
+    EXPECT_DOUBLE_EQ( fun.d2(), 1.5 * 2.5 * pow( x1(), 0.5 ) );
+    fun.update( x1(), FunG::UpToThirdDerivative() );
+    EXPECT_DOUBLE_EQ( fun.d3(), 0.5 * 1.5 * 2.5 * pow( x1(), -0.5 ) );
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#define FUNG_ENABLE_EXCEPTIONS
+#include <fung/cmath/erf.hh>
+#include <fung/cmath/exp.hh>
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/cmath/sine.hh>
+#include <fung/finalize.hh>
+#include <fung/identity.hh>
+#include <fung/generate.hh>
+#include <fung/util/simd.hh>
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    using Pack = FunG::Simd< double, 4 >;
+
+    template < class Function, class Reference >
+    void expectLaneWiseNear( Function f, Reference g, double a, double b, double tolerance )
+    {
+        const int n = 1000;
+        for ( int i = 0; i < n; i += Pack::size() )
+        {
+            Pack x;
+            for ( int k = 0; k < Pack::size(); ++k )
+                x.set( k, a + ( b - a ) * ( i + k ) / n );
+
+            const auto y = f( x );
+            for ( int k = 0; k < Pack::size(); ++k )
+                EXPECT_NEAR( y[ k ], g( x[ k ] ), tolerance * std::abs( g( x[ k ] ) ) )
+                    << "x = " << x[ k ];
+        }
+    }
+}
+
+TEST( SimdTest, Arithmetic )
+{
+    const auto x = Pack::load( std::array< double, 4 >{{1., 2., 3., 4.}}.data() );
+    const auto y = 2 * x - 1. / x;
+    for ( int k = 0; k < Pack::size(); ++k )
+        EXPECT_DOUBLE_EQ( y[ k ], 2 * ( k + 1 ) - 1. / ( k + 1 ) );
+
+    EXPECT_TRUE( static_cast< bool >( x > 3. ) );
+    EXPECT_FALSE( all( x > 3. ) );
+    EXPECT_FALSE( static_cast< bool >( x > 4. || x < 1. ) );
+    EXPECT_DOUBLE_EQ( select( x < 2.5, x, Pack( 0. ) )[ 1 ], 2. );
+    EXPECT_DOUBLE_EQ( select( x < 2.5, x, Pack( 0. ) )[ 2 ], 0. );
+}
+
+TEST( SimdTest, Exp )
+{
+    expectLaneWiseNear( []( Pack x ) { return exp( x ); }, []( double x ) { return std::exp( x ); },
+                        -700, 700, 1e-15 );
+    EXPECT_EQ( exp( Pack( 1000. ) )[ 0 ], std::numeric_limits< double >::infinity() );
+    EXPECT_EQ( exp( Pack( -1000. ) )[ 0 ], 0. );
+}
+
+TEST( SimdTest, Log )
+{
+    expectLaneWiseNear( []( Pack x ) { return log( x ); }, []( double x ) { return std::log( x ); },
+                        1e-3, 1e3, 1e-15 );
+    expectLaneWiseNear( []( Pack x ) { return log( x ); }, []( double x ) { return std::log( x ); },
+                        1e-310, 1e-300, 1e-15 );
+    EXPECT_EQ( log( Pack( 0. ) )[ 0 ], -std::numeric_limits< double >::infinity() );
+    EXPECT_TRUE( std::isnan( log( Pack( -1. ) )[ 0 ] ) );
+}
+
+TEST( SimdTest, Pow )
+{
+    expectLaneWiseNear( []( Pack x ) { return pow( x, -8. ); },
+                        []( double x ) { return std::pow( x, -8. ); }, -3.001, 3, 1e-14 );
+    expectLaneWiseNear( []( Pack x ) { return pow( x, 2. / 3 ); },
+                        []( double x ) { return std::pow( x, 2. / 3 ); }, 0, 10, 1e-15 );
+    EXPECT_TRUE( std::isnan( pow( Pack( -1. ), 0.5 )[ 0 ] ) );
+    EXPECT_DOUBLE_EQ( pow( Pack( 0. ), 0. )[ 0 ], 1. );
+    EXPECT_EQ( pow( Pack( 0. ), -1. )[ 0 ], std::numeric_limits< double >::infinity() );
+    EXPECT_EQ( pow( Pack( 2. ), 1025. )[ 0 ], std::numeric_limits< double >::infinity() );
+    EXPECT_EQ( pow( Pack( 2. ), -1100. )[ 0 ], 0. );
+    EXPECT_DOUBLE_EQ( pow( Pack( -2. ), 3. )[ 0 ], -8. );
+}
+
+TEST( SimdTest, PowLargeExponents )
+{
+    const auto eps = std::numeric_limits< double >::epsilon();
+    for ( auto x : {1e-100, 0.3, 0.99, 0.9999, 1.0001, 1.01, 1.7, 3., 1e100} )
+        for ( int i = -250; i <= 250; i += Pack::size() )
+        {
+            // y * ln(x) in [-700,700]
+            Pack y;
+            for ( int k = 0; k < Pack::size(); ++k )
+                y.set( k, 2.8 * ( i + k ) / std::log( x ) );
+
+            const auto z = pow( Pack( x ), y );
+            for ( int k = 0; k < Pack::size(); ++k )
+            {
+                const auto expected = std::pow( x, y[ k ] );
+                EXPECT_NEAR( z[ k ], expected,
+                             ( 2 + std::abs( std::log( expected ) ) ) * eps * expected )
+                    << "x = " << x << ", y = " << y[ k ];
+            }
+        }
+}
+
+TEST( SimdTest, Erf )
+{
+    expectLaneWiseNear( []( Pack x ) { return erf( x ); }, []( double x ) { return std::erf( x ); },
+                        -6, 6, 1e-15 );
+}
+
+TEST( SimdTest, CMathFunctions )
+{
+    auto x = Pack( 0.5 );
+    x.set( 1, 1.5 );
+    x.set( 2, 2.5 );
+    x.set( 3, 3.5 );
+
+    FunG::CMath::LN< Pack > ln( x );
+    FunG::CMath::Erf< Pack > erf( x );
+    FunG::Pow< 5, 2, Pack > pow( x );
+    for ( int k = 0; k < Pack::size(); ++k )
+    {
+        FunG::LN ln0( x[ k ] );
+        EXPECT_NEAR( ln()[ k ], ln0(), 1e-15 );
+        EXPECT_NEAR( ln.d3()[ k ], ln0.d3(), 1e-14 * std::abs( ln0.d3() ) );
+
+        FunG::Erf erf0( x[ k ] );
+        EXPECT_NEAR( erf.d1()[ k ], erf0.d1(), 1e-15 );
+
+        FunG::Pow< 5, 2 > pow0( x[ k ] );
+        EXPECT_NEAR( pow()[ k ], pow0(), 1e-14 * pow0() );
+        EXPECT_NEAR( pow.d2( 2. )[ k ], pow0.d2( 2. ), 1e-14 * pow0.d2( 2. ) );
+    }
+
+    x.set( 2, -1 );
+    EXPECT_THROW( ln.update( x ), FunG::OutOfDomainException );
+}
+
+TEST( SimdTest, ComposedFunction )
+{
+    using namespace FunG;
+    const auto generate = []( auto x ) {
+        return finalize( exp( sqrt( identity( x ) ) ) + ln( pow< 3 >( identity( x ) ) ) +
+                         sin( identity( x ) ) * erf( identity( x ) ) );
+    };
+
+    double xs[] = {0.25, 1., 2., 8.};
+    auto f = generate( Pack::load( xs ) );
+    const Pack dx = 1.;
+    for ( int k = 0; k < Pack::size(); ++k )
+    {
+        auto g = generate( xs[ k ] );
+        EXPECT_NEAR( f()[ k ], g(), 1e-14 * std::abs( g() ) );
+        EXPECT_NEAR( f.d1( dx )[ k ], g.d1( 1. ), 1e-14 * std::abs( g.d1( 1. ) ) );
+        EXPECT_NEAR( f.d2( dx, dx )[ k ], g.d2( 1., 1. ), 1e-14 * std::abs( g.d2( 1., 1. ) ) );
+        EXPECT_NEAR( f.d3( dx, dx, dx )[ k ], g.d3( 1., 1., 1. ),
+                     1e-13 * std::abs( g.d3( 1., 1., 1. ) ) );
+    }
+}
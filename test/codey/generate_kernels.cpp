@@ -0,0 +1,41 @@
+// Generates the kernels that are checked in kernels.cpp.
+
+#include "models.hh"
+
+#include <codey/codey.hh>
+#include <codey/eigen.hh>
+
+#include <fstream>
+#include <iostream>
+
+int main( int argc, char* argv[] )
+{
+    if ( argc != 2 )
+    {
+        std::cerr << "Usage: " << argv[ 0 ] << " <output file>" << std::endl;
+        return 1;
+    }
+
+    using codey::Expression;
+    const auto x = codey::input< Expression >();
+    const auto F2 = codey::input< models::M2< Expression > >();
+    const auto F3 = codey::input< models::M3< Expression > >();
+
+    // Models are constructed in the reference configuration, as in kernels.cpp.
+    const auto I2 = models::M2< Expression >::Identity().eval();
+    const auto I3 = models::M3< Expression >::Identity().eval();
+
+    std::ofstream file( argv[ 1 ] );
+    file << "#pragma once\n\n#include <math.h>\n\n"
+         << codey::kernel( "scalarChain", models::scalarChain( Expression( 1. ) ), x ) << "\n"
+         << codey::kernel< 0 >( "scalarChainValue", models::scalarChain( Expression( 1. ) ), x )
+         << "\n"
+         << codey::kernel( "compressibleNeoHooke", models::compressibleNeoHooke( I3 ), F3 ) << "\n"
+         << codey::kernel< 1 >( "compressibleNeoHookeGradient",
+                                models::compressibleNeoHooke( I3 ), F3 )
+         << "\n"
+         << codey::kernel( "compressibleMooneyRivlin", models::compressibleMooneyRivlin( I3 ), F3 )
+         << "\n"
+         << codey::kernel( "modifiedNeoHooke2D", models::modifiedNeoHooke2D( I2 ), F2 );
+    return file ? 0 : 1;
+}
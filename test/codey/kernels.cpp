@@ -0,0 +1,151 @@
+#define FUNG_ENABLE_EXCEPTIONS
+#include "models.hh"
+
+#include <codey/codey.hh>
+
+#include <kernels.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    using codey::Expression;
+
+    constexpr double tolerance = 1e-12;
+
+    template < class Scalar >
+    using M2 = models::M2< Scalar >;
+
+    template < class Scalar >
+    using M3 = models::M3< Scalar >;
+
+    template < class Arg >
+    Arg fromComponents( const double* x )
+    {
+        using Components = FunG::Detail::Components< Arg >;
+        auto arg = FunG::zero< Arg >();
+        for ( int k = 0; k < Components::value; ++k )
+            Components::entry( arg, k ) = x[ k ];
+        return arg;
+    }
+
+    template < class Arg, std::size_t n = FunG::Detail::Components< Arg >::value, class Kernel,
+               class F >
+    void checkKernel( Kernel kernel, F f, const std::array< double, n >& x )
+    {
+        std::array< double, 1 > value;
+        std::array< double, n > gradient;
+        std::array< double, n * n > hessian;
+        kernel( x.data(), value.data(), gradient.data(), hessian.data() );
+
+        f.update( fromComponents< Arg >( x.data() ) );
+        const auto e = FunG::Detail::unitDirections< Arg >();
+        const auto scale = std::max( 1., std::abs( f() ) );
+        EXPECT_NEAR( value[ 0 ], f(), tolerance * scale );
+        for ( std::size_t k = 0; k < n; ++k )
+        {
+            EXPECT_NEAR( gradient[ k ], f.d1( e[ k ] ), tolerance * scale );
+            for ( std::size_t l = 0; l < n; ++l )
+                EXPECT_NEAR( hessian[ k * n + l ], f.d2( e[ k ], e[ l ] ), tolerance * scale );
+        }
+    }
+
+    const std::array< double, 9 > F = {{1.1, 0.2, -0.1, 0.05, 0.9, 0.3, 0.1, -0.2, 1.2}};
+}
+
+TEST( CodeyExpressionTest, ConstantFolding )
+{
+    const auto x = Expression::input( 0, "x[0]" );
+    EXPECT_TRUE( ( Expression( 2. ) * 3. + 1. ).isConstant( 7. ) );
+    EXPECT_TRUE( ( x * 0. ).isConstant( 0. ) );
+    EXPECT_TRUE( ( x * 1. ) == x );
+    EXPECT_TRUE( ( x + 0. ) == x );
+    EXPECT_TRUE( ( x - x ).isConstant( 0. ) );
+    EXPECT_TRUE( -( -x ) == x );
+    EXPECT_TRUE( exp( Expression( 0. ) ).isConstant( 1. ) );
+    EXPECT_EQ( to_string( x + ( -x * x ) ), "(x[0] - (x[0] * x[0]))" );
+}
+
+TEST( CodeyExpressionTest, Comparisons )
+{
+    const auto x = Expression::input( 0, "x[0]" );
+    EXPECT_TRUE( Expression( 1. ) < Expression( 2. ) );
+    EXPECT_TRUE( x == x );
+    EXPECT_FALSE( x != x );
+    EXPECT_THROW( x < 2., std::logic_error );
+    EXPECT_THROW( x >= 2., std::logic_error );
+    EXPECT_THROW( x == x + 1., std::logic_error );
+    EXPECT_THROW( x != x + 1., std::logic_error );
+}
+
+TEST( CodeyExpressionTest, NonFiniteLiterals )
+{
+    const auto x = Expression::input( 0, "x[0]" );
+    EXPECT_EQ( to_string( x * ( Expression( 1. ) / 0. ) ), "(x[0] * INFINITY)" );
+    EXPECT_EQ( to_string( x + log( Expression( 0. ) ) ), "(x[0] + -INFINITY)" );
+    EXPECT_EQ( to_string( x * sqrt( Expression( -1. ) ) ), "(x[0] * NAN)" );
+}
+
+TEST( CodeyExpressionTest, Evaluate )
+{
+    const auto x = Expression::input( 0, "x[0]" );
+    const auto y = Expression::input( 1, "x[1]" );
+    const auto z = sqrt( x ) * log( y ) / ( x + y ) - pow( x, y );
+    const std::array< double, 2 > values = {{2., 3.}};
+    EXPECT_DOUBLE_EQ( evaluate( z, values.data() ),
+                      std::sqrt( 2. ) * std::log( 3. ) / 5. - std::pow( 2., 3. ) );
+}
+
+TEST( CodeyKernelTest, CommonSubexpressionsAreComputedOnce )
+{
+    const auto x = codey::input< Expression >();
+    const auto code = codey::kernel( "f", FunG::finalize( exp( FunG::identity( x ) ) ), x );
+    EXPECT_EQ( code, "static inline void f( const double* x, double* f, double* df, double* ddf "
+                     ")\n{\n    const double t0 = exp(x[0]);\n    f[0] = t0;\n    df[0] = t0;\n"
+                     "    ddf[0] = t0;\n}\n" );
+}
+
+TEST( CodeyKernelTest, ScalarChain )
+{
+    const auto f = models::scalarChain( 1. );
+    for ( auto x : {0.3, 1.2, 2.7} )
+        checkKernel< double >( scalarChain, f, {{x}} );
+
+    std::array< double, 1 > value;
+    scalarChainValue( &F[ 0 ], value.data() );
+    auto g = f;
+    g.update( F[ 0 ] );
+    EXPECT_NEAR( value[ 0 ], g(), tolerance );
+}
+
+TEST( CodeyKernelTest, CompressibleNeoHooke )
+{
+    const auto f = models::compressibleNeoHooke( M3< double >::Identity().eval() );
+    checkKernel< M3< double > >( compressibleNeoHooke, f, F );
+
+    std::array< double, 1 > value;
+    std::array< double, 9 > gradient, reference;
+    std::array< double, 81 > hessian;
+    compressibleNeoHookeGradient( F.data(), value.data(), gradient.data() );
+    compressibleNeoHooke( F.data(), value.data(), reference.data(), hessian.data() );
+    for ( int k = 0; k < 9; ++k )
+        EXPECT_DOUBLE_EQ( gradient[ k ], reference[ k ] );
+}
+
+TEST( CodeyKernelTest, CompressibleMooneyRivlin )
+{
+    checkKernel< M3< double > >( compressibleMooneyRivlin,
+                      models::compressibleMooneyRivlin( M3< double >::Identity().eval() ), F );
+}
+
+TEST( CodeyKernelTest, ModifiedNeoHooke2D )
+{
+    checkKernel< M2< double > >( modifiedNeoHooke2D,
+                      models::modifiedNeoHooke2D( M2< double >::Identity().eval() ),
+                      {{1.1, 0.2, -0.1, 0.9}} );
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <fung/examples/rubber/mooney_rivlin.hh>
+#include <fung/examples/rubber/neo_hooke.hh>
+#include <fung/fung.hh>
+
+#include <Eigen/Dense>
+
+// Models for which kernels are generated (with Scalar=codey::Expression) and that are used as
+// reference (with Scalar=double).
+namespace models
+{
+    template < class Scalar >
+    using M2 = Eigen::Matrix< Scalar, 2, 2 >;
+
+    template < class Scalar >
+    using M3 = Eigen::Matrix< Scalar, 3, 3 >;
+
+    template < class Scalar >
+    auto scalarChain( const Scalar& x )
+    {
+        using namespace FunG;
+        const auto id = identity( x );
+        return finalize( exp( sqrt( id ) ) * sin( id ) + ln( pow< 3 >( id ) + 1. ) * cos( id ) +
+                         erf( id ) );
+    }
+
+    template < class Scalar >
+    auto compressibleNeoHooke( const M3< Scalar >& F )
+    {
+        return FunG::compressibleNeoHooke< FunG::Pow< 2, 1, Scalar >,
+                                           FunG::CMath::LN< Scalar > >( 1., 2., 3., F );
+    }
+
+    template < class Scalar >
+    auto compressibleMooneyRivlin( const M3< Scalar >& F )
+    {
+        return FunG::compressibleMooneyRivlin< FunG::Pow< 2, 1, Scalar >,
+                                               FunG::CMath::LN< Scalar > >( 1., 2., 3., 4., F );
+    }
+
+    template < class Scalar >
+    auto modifiedNeoHooke2D( const M2< Scalar >& F )
+    {
+        return FunG::modifiedIncompressibleNeoHooke( 1., F );
+    }
+}
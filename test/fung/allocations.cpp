@@ -0,0 +1,114 @@
+// Checks that evaluation with dynamic size matrices of bounded capacity does not allocate after
+// warm-up. Eigen's check for forbidden allocations is redirected to a counter, thus this file
+// must be compiled into its own executable.
+
+namespace
+{
+    int forbiddenAllocations = 0;
+}
+
+#define EIGEN_RUNTIME_NO_MALLOC
+#define eigen_assert( x )                                                                          \
+    do                                                                                             \
+    {                                                                                              \
+        if ( !( x ) )                                                                              \
+            ++forbiddenAllocations;                                                                \
+    } while ( false )
+
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/examples/biomechanics/adipose_tissue_sommer_holzapfel.hh>
+#include <fung/examples/biomechanics/muscle_tissue_martins.hh>
+#include <fung/examples/biomechanics/skin_tissue_hendriks.hh>
+#include <fung/examples/rubber/mooney_rivlin.hh>
+#include <fung/examples/rubber/neo_hooke.hh>
+
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+
+#include <tuple>
+
+namespace
+{
+    using FunG::LN;
+    using FunG::Pow;
+    constexpr int dim = 3;
+    using BM = Eigen::Matrix< double, Eigen::Dynamic, Eigen::Dynamic, 0, dim, dim >;
+
+    template < class Matrix >
+    Matrix deformationGradient()
+    {
+        Matrix F( dim, dim );
+        F << 1.1, 0.1, 0, 0.2, 1, 0.1, 0, -0.1, 0.9;
+        return F;
+    }
+
+    template < class Matrix >
+    Matrix fiberTensor()
+    {
+        Matrix A = Matrix::Zero( dim, dim );
+        A( 0, 0 ) = 1;
+        return A;
+    }
+
+    template < class Matrix >
+    Matrix unitMatrix()
+    {
+        return Matrix::Identity( dim, dim );
+    }
+
+    /// Number of allocations in update, d1, d2 and d3 after one evaluation for warm-up.
+    template < class Matrix, class Function >
+    int allocationsAfterWarmUp( Function f )
+    {
+        const Matrix F = deformationGradient< Matrix >();
+        Matrix dF = Matrix::Zero( dim, dim ), dG = Matrix::Zero( dim, dim );
+        dF( 0, 1 ) = 1;
+        dG( 2, 2 ) = 1;
+
+        auto evaluate = [&] {
+            f.update( F );
+            return f() + f.d1( dF ) + f.d2( dF, dG ) + f.d3( dF, dG, dF ) +
+                   std::get< 2 >( f.update_and_derivatives( F, dF, dG ) );
+        };
+
+        evaluate();
+        forbiddenAllocations = 0;
+        Eigen::internal::set_is_malloc_allowed( false );
+        evaluate();
+        Eigen::internal::set_is_malloc_allowed( true );
+        return forbiddenAllocations;
+    }
+}
+
+TEST( AllocationTest, Rubber )
+{
+    EXPECT_EQ( allocationsAfterWarmUp< BM >( FunG::compressibleNeoHooke< Pow< 2 >, LN, BM, dim >(
+                   1., 1., 1., unitMatrix< BM >() ) ),
+               0 );
+    EXPECT_EQ( allocationsAfterWarmUp< BM >(
+                   FunG::modifiedCompressibleNeoHooke< Pow< 2 >, LN, BM, dim >(
+                       1., 1., 1., unitMatrix< BM >() ) ),
+               0 );
+    EXPECT_EQ( allocationsAfterWarmUp< BM >(
+                   FunG::compressibleMooneyRivlin< Pow< 2 >, LN, BM, dim >(
+                       1., 1., 1., 1., unitMatrix< BM >() ) ),
+               0 );
+}
+
+TEST( AllocationTest, Biomechanics )
+{
+    EXPECT_EQ( allocationsAfterWarmUp< BM >(
+                   FunG::compressibleSkin_Hendriks< Pow< 2 >, LN, BM, dim >( 1., 1.,
+                                                                            unitMatrix< BM >() ) ),
+               0 );
+    EXPECT_EQ( allocationsAfterWarmUp< BM >(
+                   FunG::compressibleAdiposeTissue_SommerHolzapfel< Pow< 2 >, LN, BM, dim >(
+                       1., 1., fiberTensor< BM >(), unitMatrix< BM >() ) ),
+               0 );
+    EXPECT_EQ( allocationsAfterWarmUp< BM >(
+                   FunG::compressibleMuscleTissue_Martins< Pow< 2 >, LN, BM, dim >(
+                       1., 1., fiberTensor< BM >(), unitMatrix< BM >() ) ),
+               0 );
+}
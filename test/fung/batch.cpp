@@ -0,0 +1,166 @@
+#include <fung/batch.hh>
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/examples/rubber/neo_hooke.hh>
+#include <fung/finalize.hh>
+#include <fung/generate.hh>
+#include <fung/identity.hh>
+#include <fung/util/simd.hh>
+#include <fung/util/simd_eigen.hh>
+
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+
+namespace
+{
+    using M = Eigen::Matrix< double, 3, 3 >;
+
+    auto generateDeformationGradient( double s )
+    {
+        M F;
+        F << 1 + s, 0.1 * s, 0, 0.2 * s, 1, 0.1, 0, -0.1 * s, 1 - 0.1 * s;
+        return F;
+    }
+
+    auto generateBatch( std::size_t n )
+    {
+        FunG::Batch< M > x( n );
+        for ( std::size_t p = 0; p < n; ++p )
+            x.set( p, generateDeformationGradient( 0.01 * p ) );
+        return x;
+    }
+}
+
+TEST( BatchTest, StorageLayout )
+{
+    FunG::Batch< M > x( 3 );
+    x.set( 1, generateDeformationGradient( 1 ) );
+    EXPECT_EQ( x.components(), 9 );
+    EXPECT_DOUBLE_EQ( x.component( 0 )[ 1 ], 2. );
+    EXPECT_DOUBLE_EQ( x.component( 3 )[ 1 ], 0.2 );
+    EXPECT_DOUBLE_EQ( x( 5, 1 ), 0.1 );
+    EXPECT_TRUE( x[ 1 ] == generateDeformationGradient( 1 ) );
+}
+
+TEST( BatchTest, Scalar )
+{
+    using namespace FunG;
+    auto f = finalize( Pow< 3 >() << identity( 1. ) );
+    Batch< double > x( 100 );
+    for ( std::size_t p = 0; p < x.size(); ++p )
+        x.set( p, 0.5 * p );
+
+    auto result = evaluate( f, x );
+    for ( std::size_t p = 0; p < x.size(); ++p )
+    {
+        const auto t = 0.5 * p;
+        EXPECT_DOUBLE_EQ( result.d0( 0, p ), t * t * t );
+        EXPECT_DOUBLE_EQ( result.d1( 0, p ), 3 * t * t );
+        EXPECT_DOUBLE_EQ( result.d2( 0, p ), 6 * t );
+    }
+}
+
+TEST( BatchTest, Simd )
+{
+    using namespace FunG;
+    using Pack = Simd< double, 4 >;
+    auto f = finalize( CMath::LN< Pack >()( Pow< 3, 1, Pack >()( identity( Pack( 1. ) ) ) ) );
+    auto g = finalize( LN()( Pow< 3 >()( identity( 1. ) ) ) );
+    // last pack is only partially filled
+    Batch< double > x( 103 );
+    for ( std::size_t p = 0; p < x.size(); ++p )
+        x.set( p, 0.5 + 0.1 * p );
+
+    BatchResult< double > result;
+    evaluate( f, x, result );
+    for ( std::size_t p = 0; p < x.size(); ++p )
+    {
+        g.update( x[ p ] );
+        EXPECT_NEAR( result.d0( 0, p ), g(), 1e-14 );
+        EXPECT_NEAR( result.d1( 0, p ), g.d1( 1. ), 1e-14 );
+        EXPECT_NEAR( result.d2( 0, p ), g.d2( 1., 1. ), 1e-14 );
+    }
+
+    Batch< double > y( 3 );
+    for ( std::size_t p = 0; p < y.size(); ++p )
+        y.set( p, 1. + p );
+    const auto values = evaluate< 0 >( f, y );
+    EXPECT_DOUBLE_EQ( values.d0( 0, 2 ), std::log( 27. ) );
+}
+
+TEST( BatchTest, CompressibleNeoHooke )
+{
+    using namespace FunG;
+    auto f = compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., M::Identity().eval() );
+    auto g = f;
+    const auto x = generateBatch( 150 );
+
+    BatchResult< M > result;
+    evaluate( f, x, result );
+    ASSERT_EQ( result.d0.size(), x.size() );
+    ASSERT_EQ( result.d2.components(), 81 );
+
+    for ( std::size_t p = 0; p < x.size(); ++p )
+    {
+        g.update( x[ p ] );
+        EXPECT_DOUBLE_EQ( result.d0( 0, p ), g() );
+        for ( int k = 0; k < 9; ++k )
+        {
+            M dF = M::Zero();
+            dF( k / 3, k % 3 ) = 1;
+            EXPECT_DOUBLE_EQ( result.d1( k, p ), g.d1( dF ) );
+            for ( int l = 0; l < 9; ++l )
+            {
+                M dG = M::Zero();
+                dG( l / 3, l % 3 ) = 1;
+                EXPECT_DOUBLE_EQ( result.d2( k * 9 + l, p ), g.d2( dF, dG ) );
+            }
+        }
+    }
+}
+
+TEST( BatchTest, CompressibleNeoHookeSimd )
+{
+    using namespace FunG;
+    using Pack = Simd< double, 4 >;
+    using MP = Eigen::Matrix< Pack, 3, 3 >;
+    auto f = compressibleNeoHooke< Pow< 2, 1, Pack >, CMath::LN< Pack > >( 1., 1., 1.,
+                                                                           MP::Identity().eval() );
+    auto g = compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., M::Identity().eval() );
+    // last pack is only partially filled
+    const auto x = generateBatch( 150 );
+
+    BatchResult< M > result;
+    evaluate( f, x, result );
+    ASSERT_EQ( result.d0.size(), x.size() );
+    ASSERT_EQ( result.d2.components(), 81 );
+
+    for ( std::size_t p = 0; p < x.size(); ++p )
+    {
+        g.update( x[ p ] );
+        EXPECT_NEAR( result.d0( 0, p ), g(), 1e-13 );
+        const auto dg = g.gradient< M >();
+        const auto H = g.packedHessian< M >();
+        for ( int k = 0; k < 9; ++k )
+        {
+            EXPECT_NEAR( result.d1( k, p ), dg( k / 3, k % 3 ), 1e-13 );
+            for ( int l = 0; l < 9; ++l )
+                EXPECT_NEAR( result.d2( k * 9 + l, p ), H[ packedIndex( k, l, 9 ) ], 1e-13 );
+        }
+    }
+}
+
+TEST( BatchTest, ValuesOnly )
+{
+    using namespace FunG;
+    auto f = incompressibleNeoHooke( 1., M::Identity().eval() );
+    const auto x = generateBatch( 10 );
+
+    auto result = evaluate< 0 >( f, x );
+    EXPECT_EQ( result.d0.size(), x.size() );
+    EXPECT_EQ( result.d1.size(), 0u );
+    EXPECT_EQ( result.d2.size(), 0u );
+    f.update( x[ 7 ] );
+    EXPECT_DOUBLE_EQ( result.d0( 0, 7 ), f() );
+}
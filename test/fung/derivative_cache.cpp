@@ -0,0 +1,191 @@
+// Checks derivatives with cached first derivatives of subexpressions. FUNG_CACHE_DERIVATIVES changes
+// the layout of Chain, Product and Squared, thus this file must be compiled into its own executable.
+#define FUNG_ENABLE_EXCEPTIONS
+
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/examples/biomechanics/muscle_tissue_martins.hh>
+#include <fung/examples/rubber/mooney_rivlin.hh>
+#include <fung/examples/rubber/neo_hooke.hh>
+#include <fung/finalize.hh>
+#include <fung/generate.hh>
+#include <fung/linear_algebra/basis_direction.hh>
+#include <fung/util/chainer.hh>
+
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+
+#include <cmath>
+
+namespace
+{
+    using M = Eigen::Matrix3d;
+    using FunG::LinearAlgebra::BasisDirection;
+
+    M deformationGradient()
+    {
+        M F;
+        F << 1.1, 0.1, 0, 0.2, 1, 0.1, 0, -0.1, 0.9;
+        return F;
+    }
+
+    M otherDeformationGradient()
+    {
+        M F;
+        F << 0.9, -0.2, 0.1, 0, 1.2, 0, 0.1, 0.1, 1;
+        return F;
+    }
+
+    M unitDirection( int k )
+    {
+        M dF = M::Zero();
+        dF( k / 3, k % 3 ) = 1;
+        return dF;
+    }
+
+    /// Trace that counts the evaluations of its first derivative.
+    struct CountingTrace : FunG::Chainer< CountingTrace >
+    {
+        explicit CountingTrace( const M& A, int& calls_ ) : calls( &calls_ )
+        {
+            update( A );
+        }
+
+        void update( const M& A )
+        {
+            value = A.trace();
+        }
+
+        double d0() const
+        {
+            return value;
+        }
+
+        double d1( const M& dA ) const
+        {
+            ++*calls;
+            return dA.trace();
+        }
+
+    private:
+        int* calls;
+        double value = 0;
+    };
+
+    /// Compares the hessian, assembled from basis directions, and third derivatives in basis
+    /// directions with derivatives in dense directions, which are not cached.
+    template < class Function >
+    void expectSameDerivatives( const Function& f )
+    {
+        const auto H = f.template hessian< M >();
+        for ( int k = 0; k < 9; ++k )
+            for ( int l = 0; l < 9; ++l )
+            {
+                const auto d2 = f.d2( unitDirection( k ), unitDirection( l ) );
+                EXPECT_NEAR( H[ k ]( l / 3, l % 3 ), d2, 1e-10 * std::abs( d2 ) + 1e-12 );
+            }
+
+        for ( int k = 0; k < 9; k += 4 )
+            for ( int l = 0; l < 9; ++l )
+                for ( int m = 0; m < 9; m += 2 )
+                {
+                    const auto d3 = f.d3( unitDirection( k ), unitDirection( l ),
+                                          unitDirection( m ) );
+                    EXPECT_NEAR( f.d3( BasisDirection< M >( k / 3, k % 3 ),
+                                       BasisDirection< M >( l / 3, l % 3 ),
+                                       BasisDirection< M >( m / 3, m % 3 ) ),
+                                 d3, 1e-10 * std::abs( d3 ) + 1e-12 );
+                }
+    }
+
+    /// Checks derivatives at two points of evaluation, i.e. that the cache is cleared on update.
+    template < class Function >
+    void checkModel( Function f )
+    {
+        f.update( deformationGradient() );
+        expectSameDerivatives( f );
+        f.update( otherDeformationGradient() );
+        expectSameDerivatives( f );
+    }
+}
+
+TEST( DerivativeCacheTest, Models )
+{
+    using namespace FunG;
+    const M I = M::Identity();
+    M fiber = M::Zero();
+    fiber( 0, 0 ) = 1;
+    checkModel( compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., I ) );
+    checkModel( modifiedCompressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., I ) );
+    checkModel( compressibleMooneyRivlin< Pow< 2 >, LN >( 1., 1., 1., 1., I ) );
+    checkModel( compressibleMuscleTissue_Martins< Pow< 2 >, LN >( 1., 1., fiber, I ) );
+}
+
+TEST( DerivativeCacheTest, Chain )
+{
+    int calls = 0;
+    auto f = FunG::finalize( FunG::Pow< 3 >()( CountingTrace( deformationGradient(), calls ) ) );
+    const auto H = f.hessian< M >();
+    EXPECT_EQ( calls, 9 );
+    EXPECT_DOUBLE_EQ( H[ 0 ]( 1, 1 ), 6 * f.d0() / ( deformationGradient().trace() *
+                                                       deformationGradient().trace() ) );
+
+    calls = 0;
+    f.update( otherDeformationGradient() );
+    f.hessian< M >();
+    EXPECT_EQ( calls, 9 );
+
+    // dense directions are not cached
+    calls = 0;
+    f.d2( unitDirection( 0 ), unitDirection( 4 ) );
+    f.d2( unitDirection( 0 ), unitDirection( 4 ) );
+    EXPECT_EQ( calls, 4 );
+}
+
+TEST( DerivativeCacheTest, Product )
+{
+    int calls = 0;
+    const auto F = deformationGradient();
+    auto f = FunG::finalize( CountingTrace( F, calls ) * CountingTrace( F, calls ) );
+    const auto H = f.hessian< M >();
+    EXPECT_EQ( calls, 18 );
+    EXPECT_DOUBLE_EQ( H[ 0 ]( 1, 1 ), 2. );
+    EXPECT_DOUBLE_EQ( H[ 0 ]( 0, 1 ), 0. );
+
+    calls = 0;
+    f.update( otherDeformationGradient() );
+    f.hessian< M >();
+    EXPECT_EQ( calls, 18 );
+}
+
+TEST( DerivativeCacheTest, Squared )
+{
+    int calls = 0;
+    auto f = FunG::finalize( squared( CountingTrace( deformationGradient(), calls ) ) );
+    const auto H = f.hessian< M >();
+    EXPECT_EQ( calls, 9 );
+    EXPECT_DOUBLE_EQ( H[ 4 ]( 2, 2 ), 2. );
+
+    calls = 0;
+    f.update( otherDeformationGradient() );
+    f.hessian< M >();
+    EXPECT_EQ( calls, 9 );
+}
+
+TEST( DerivativeCacheTest, EntriesOfWideMatrices )
+{
+    using W = Eigen::Matrix< double, 2, 5 >;
+    FunG::Detail::DerivativeCache< double > cache;
+    for ( int i = 0; i < 2; ++i )
+        for ( int j = 0; j < 5; ++j )
+            EXPECT_NE( ( cache.insert< 0 >( BasisDirection< W >( i, j ), 5. * i + j ) ), nullptr );
+
+    for ( int i = 0; i < 2; ++i )
+        for ( int j = 0; j < 5; ++j )
+        {
+            const auto cached = cache.find< 0 >( BasisDirection< W >( i, j ) );
+            ASSERT_NE( cached, nullptr );
+            EXPECT_EQ( *cached, 5. * i + j );
+        }
+}
@@ -0,0 +1,327 @@
+#include <fung/cmath/exp.hh>
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/cmath/sine.hh>
+#include <fung/examples/biomechanics/muscle_tissue_martins.hh>
+#include <fung/examples/biomechanics/skin_tissue_hendriks.hh>
+#include <fung/examples/rubber/neo_hooke.hh>
+#include <fung/finalize.hh>
+#include <fung/generate.hh>
+#include <fung/identity.hh>
+#include <fung/linear_algebra.hh>
+#include <fung/util/chainer.hh>
+#include <fung/variable.hh>
+
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+
+namespace
+{
+    using M = Eigen::Matrix< double, 3, 3 >;
+
+    M unitDirection( int k )
+    {
+        M e = M::Zero();
+        e( k / 3, k % 3 ) = 1;
+        return e;
+    }
+
+    M deformationGradient()
+    {
+        M F;
+        F << 1.1, 0.1, 0, 0.2, 1, 0.1, 0, -0.1, 0.9;
+        return F;
+    }
+
+    /// \f$\frac{1}{2}\mathrm{tr}(A)^2\f$, counting the calls of its derivatives.
+    struct CountingLeaf : FunG::Chainer< CountingLeaf >
+    {
+        CountingLeaf( const M& A, int& d1Calls_, int& d2Calls_ )
+            : d1Calls( &d1Calls_ ), d2Calls( &d2Calls_ )
+        {
+            update( A );
+        }
+
+        void update( const M& A )
+        {
+            trace = A.trace();
+        }
+
+        double d0() const
+        {
+            return 0.5 * trace * trace;
+        }
+
+        double d1( const M& dA ) const
+        {
+            ++*d1Calls;
+            return trace * dA.trace();
+        }
+
+        double d2( const M& dA, const M& dB ) const
+        {
+            ++*d2Calls;
+            return dA.trace() * dB.trace();
+        }
+
+    private:
+        int* d1Calls;
+        int* d2Calls;
+        double trace = 0;
+    };
+}
+
+TEST( GradientTest, ScalarVariables )
+{
+    using namespace FunG;
+    auto f = finalize( ( variable< 0 >( 1. ) + variable< 1 >( 2. ) ) *
+                       pow< 2 >( variable< 1 >( 2. ) ) );
+
+    const auto g0 = f.gradient< 0 >();
+    const auto g1 = f.gradient< 1 >();
+    EXPECT_DOUBLE_EQ( g0, f.d1< 0 >() );
+    EXPECT_DOUBLE_EQ( g1, f.d1< 1 >() );
+
+    const auto H01 = f.hessian< 0, 1 >();
+    const auto H11 = f.hessian< 1, 1 >();
+    const auto d2_01 = f.d2< 0, 1 >();
+    const auto d2_11 = f.d2< 1, 1 >();
+    ASSERT_EQ( H01.size(), 1u );
+    EXPECT_DOUBLE_EQ( H01[ 0 ], d2_01 );
+    EXPECT_DOUBLE_EQ( H11[ 0 ], d2_11 );
+}
+
+TEST( GradientTest, MatrixVariable )
+{
+    using namespace FunG;
+    const M A = M::Identity();
+    auto f = finalize( LinearAlgebra::det( A )( variable< 0 >( A ) ) *
+                       pow< 2 >( variable< 1 >( 2. ) ) );
+    f.update< 0 >( deformationGradient() );
+
+    const M g = f.gradient< 0 >();
+    const auto H00 = f.hessian< 0, 0 >();
+    const auto H01 = f.hessian< 0, 1 >();
+    for ( int k = 0; k < 9; ++k )
+    {
+        const auto d1 = f.d1< 0 >( unitDirection( k ) );
+        EXPECT_DOUBLE_EQ( g( k / 3, k % 3 ), d1 );
+
+        const auto d2_01 = f.d2< 0, 1 >( unitDirection( k ), 1. );
+        EXPECT_DOUBLE_EQ( H01[ k ], d2_01 );
+        for ( int l = 0; l < 9; ++l )
+        {
+            const auto d2 = f.d2< 0, 0 >( unitDirection( k ), unitDirection( l ) );
+            EXPECT_NEAR( H00[ k ]( l / 3, l % 3 ), d2, 1e-14 );
+        }
+    }
+}
+
+TEST( GradientTest, CompressibleNeoHooke )
+{
+    using namespace FunG;
+    auto f = compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., M::Identity().eval() );
+    f.update( deformationGradient() );
+
+    const M g = f.gradient< M >();
+    const auto H = f.hessian< M >();
+    for ( int k = 0; k < 9; ++k )
+    {
+        EXPECT_DOUBLE_EQ( g( k / 3, k % 3 ), f.d1( unitDirection( k ) ) );
+        for ( int l = 0; l < 9; ++l )
+            EXPECT_NEAR( H[ k ]( l / 3, l % 3 ), f.d2( unitDirection( k ), unitDirection( l ) ),
+                         1e-13 );
+    }
+}
+
+TEST( GradientTest, SingleTraversal )
+{
+    using namespace FunG;
+    int d1Calls = 0, d2Calls = 0;
+    const auto u = CountingLeaf( deformationGradient(), d1Calls, d2Calls );
+    auto f = finalize( exp( u ) * u + 2 * squared( u ) );
+
+    // each of the three leaves is differentiated once per direction resp. pair of directions
+    const M g = f.gradient< M >();
+    EXPECT_EQ( d1Calls, 3 * 9 );
+    EXPECT_EQ( d2Calls, 0 );
+
+    d1Calls = 0;
+    const auto H = f.hessian< M >();
+    EXPECT_EQ( d1Calls, 3 * 9 );
+    EXPECT_EQ( d2Calls, 3 * 45 );
+
+    d1Calls = d2Calls = 0;
+    const auto packedH = f.packedHessian< M >();
+    EXPECT_EQ( d1Calls, 3 * 9 );
+    EXPECT_EQ( d2Calls, 3 * 45 );
+
+    for ( int k = 0; k < 9; ++k )
+    {
+        const auto d1 = f.d1( unitDirection( k ) );
+        EXPECT_NEAR( g( k / 3, k % 3 ), d1, 1e-13 * std::abs( d1 ) );
+        for ( int l = 0; l < 9; ++l )
+        {
+            const auto d2 = f.d2( unitDirection( k ), unitDirection( l ) );
+            EXPECT_NEAR( H[ k ]( l / 3, l % 3 ), d2, 1e-13 * std::abs( d2 ) + 1e-14 );
+            EXPECT_NEAR( packedH[ packedIndex( k, l, 9 ) ], d2, 1e-13 * std::abs( d2 ) + 1e-14 );
+        }
+    }
+}
+
+TEST( GradientTest, PackedIndex )
+{
+    using FunG::packedIndex;
+    EXPECT_EQ( FunG::packedSize( 9 ), 45 );
+    EXPECT_EQ( packedIndex( 0, 0, 9 ), 0 );
+    EXPECT_EQ( packedIndex( 0, 8, 9 ), 8 );
+    EXPECT_EQ( packedIndex( 1, 1, 9 ), 9 );
+    EXPECT_EQ( packedIndex( 3, 1, 9 ), packedIndex( 1, 3, 9 ) );
+    EXPECT_EQ( packedIndex( 8, 8, 9 ), 44 );
+}
+
+TEST( GradientTest, PackedHessianMuscleTissue )
+{
+    using namespace FunG;
+    M fiber = M::Zero();
+    fiber( 0, 0 ) = 1;
+    auto f = incompressibleMuscleTissue_Martins( fiber, M::Identity().eval() );
+    f.update( deformationGradient() );
+
+    const auto H = f.packedHessian< M >();
+    ASSERT_EQ( H.size(), 45u );
+    for ( int k = 0; k < 9; ++k )
+        for ( int l = 0; l < 9; ++l )
+        {
+            const auto d2 = f.d2( unitDirection( k ), unitDirection( l ) );
+            EXPECT_NEAR( H[ packedIndex( k, l, 9 ) ], d2, 1e-10 * std::abs( d2 ) + 1e-12 );
+        }
+}
+
+TEST( GradientTest, PackedHessianSkin )
+{
+    using namespace FunG;
+    auto f = compressibleSkin_Hendriks< Pow< 2 >, LN >( 1., 1., M::Identity().eval() );
+    f.update( deformationGradient() );
+
+    const auto H = f.packedHessian< M >();
+    for ( int k = 0; k < 9; ++k )
+        for ( int l = 0; l < 9; ++l )
+        {
+            const auto d2 = f.d2( unitDirection( k ), unitDirection( l ) );
+            EXPECT_NEAR( H[ packedIndex( k, l, 9 ) ], d2, 1e-10 * std::abs( d2 ) + 1e-12 );
+        }
+}
+
+TEST( FusedDerivativesTest, ScalarVariables )
+{
+    using namespace FunG;
+    auto f = finalize( ( variable< 0 >( 1. ) + 3. * variable< 1 >( 2. ) ) *
+                       pow< 2 >( variable< 0 >( 1. ) ) );
+    f.update< 1 >( 0.5 );
+
+    double value, d1, d2;
+    std::tie( value, d1, d2 ) = f.update_and_derivatives< 0 >( 2., 0.3, -0.7 );
+    EXPECT_DOUBLE_EQ( value, f() );
+    EXPECT_DOUBLE_EQ( d1, f.d1< 0 >( 0.3 ) );
+    EXPECT_DOUBLE_EQ( d2, ( f.d2< 0, 0 >( 0.3, -0.7 ) ) );
+
+    const auto d = f.derivatives< 1, 0 >( 2., 1.5 );
+    EXPECT_DOUBLE_EQ( std::get< 0 >( d ), f.d1< 1 >( 2. ) );
+    EXPECT_DOUBLE_EQ( std::get< 1 >( d ), ( f.d2< 1, 0 >( 2., 1.5 ) ) );
+}
+
+TEST( FusedDerivativesTest, NestedChain )
+{
+    using namespace FunG;
+    auto f = finalize( squared( exp( 2. * identity( 1. ) ) * sin( identity( 1. ) ) + 1. ) );
+
+    double value, d1, d2;
+    std::tie( value, d1, d2 ) = f.update_and_derivatives( 0.4, 1.5, -2. );
+    EXPECT_DOUBLE_EQ( value, f() );
+    EXPECT_DOUBLE_EQ( d1, f.d1( 1.5 ) );
+    EXPECT_DOUBLE_EQ( d2, f.d2( 1.5, -2. ) );
+
+    std::tie( value, d1 ) = f.update_and_derivatives( 0.7, 1. );
+    EXPECT_DOUBLE_EQ( value, f() );
+    EXPECT_DOUBLE_EQ( d1, f.d1( 1. ) );
+}
+
+TEST( FusedDerivativesTest, VanishingSecondDerivative )
+{
+    using namespace FunG;
+    auto f = finalize( 3. * identity( 1. ) + 2. );
+
+    double value, d1, d2;
+    std::tie( value, d1, d2 ) = f.update_and_derivatives( 2., 1.5, -1. );
+    EXPECT_DOUBLE_EQ( value, 8. );
+    EXPECT_DOUBLE_EQ( d1, 4.5 );
+    EXPECT_DOUBLE_EQ( d2, 0. );
+}
+
+TEST( FusedDerivativesTest, CompressibleNeoHooke )
+{
+    using namespace FunG;
+    auto f = compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., M::Identity().eval() );
+
+    for ( int k = 0; k < 9; ++k )
+    {
+        double value, d1, d2;
+        std::tie( value, d1, d2 ) = f.update_and_derivatives(
+            deformationGradient(), unitDirection( k ), unitDirection( ( 2 * k + 1 ) % 9 ) );
+        EXPECT_DOUBLE_EQ( value, f() );
+        EXPECT_NEAR( d1, f.d1( unitDirection( k ) ), 1e-14 );
+        EXPECT_NEAR( d2, f.d2( unitDirection( k ), unitDirection( ( 2 * k + 1 ) % 9 ) ), 1e-13 );
+    }
+}
+
+TEST( FusedDerivativesTest, MuscleTissue )
+{
+    using namespace FunG;
+    M fiber = M::Zero();
+    fiber( 0, 0 ) = 1;
+    auto f = incompressibleMuscleTissue_Martins( fiber, M::Identity().eval() );
+    f.update( deformationGradient() );
+
+    const M dF = deformationGradient() - M::Identity();
+    for ( int k = 0; k < 9; ++k )
+    {
+        const auto d = f.derivatives( dF, unitDirection( k ) );
+        const auto d1 = f.d1( dF );
+        const auto d2 = f.d2( dF, unitDirection( k ) );
+        EXPECT_NEAR( std::get< 0 >( d ), d1, 1e-10 * std::abs( d1 ) + 1e-12 );
+        EXPECT_NEAR( std::get< 1 >( d ), d2, 1e-10 * std::abs( d2 ) + 1e-12 );
+    }
+}
+
+TEST( SharedZeroTest, AbsentDerivativeOfConstantSizeMatrix )
+{
+    const M A = deformationGradient(), dA = unitDirection( 1 );
+    auto f = FunG::finalize( FunG::identity( A ) );
+    EXPECT_TRUE( f.d2( dA, dA ) == M::Zero() );
+    EXPECT_EQ( &f.d2( dA, dA ), &FunG::cachedZero< M >() );
+    EXPECT_EQ( &f.d3( dA, dA, dA ), &f.d2( dA, dA ) );
+
+    // present derivatives are returned by value, absent ones by reference
+    static_assert( std::is_same< decltype( f.d1( dA ) ), M >::value, "" );
+    static_assert( std::is_same< decltype( f.d2( dA, dA ) ), const M& >::value, "" );
+}
+
+TEST( SharedZeroTest, AbsentDerivativeOfDynamicSizeMatrix )
+{
+    using DM = Eigen::MatrixXd;
+    const DM A = deformationGradient(), dA = unitDirection( 1 );
+    auto f = FunG::finalize( FunG::identity( A ) );
+    EXPECT_TRUE( f.d2( dA, dA ) == DM::Zero( 3, 3 ) );
+    EXPECT_EQ( &f.d2( dA, dA ), &FunG::cachedZero< DM >( 3, 3 ) );
+
+    const DM B = DM::Identity( 2, 2 );
+    auto g = FunG::finalize( FunG::identity( B ) );
+    EXPECT_TRUE( g.d2( B, B ) == DM::Zero( 2, 2 ) );
+    EXPECT_NE( &g.d2( B, B ), &f.d2( dA, dA ) );
+}
@@ -0,0 +1,103 @@
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/examples/biomechanics/adipose_tissue_sommer_holzapfel.hh>
+#include <fung/examples/biomechanics/muscle_tissue_martins.hh>
+#include <fung/examples/biomechanics/skin_tissue_hendriks.hh>
+#include <fung/examples/rubber/mooney_rivlin.hh>
+#include <fung/examples/rubber/neo_hooke.hh>
+
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+namespace
+{
+    using M = Eigen::Matrix< double, 3, 3 >;
+
+    M deformationGradient()
+    {
+        M F;
+        F << 1.1, 0.1, 0, 0.2, 1, 0.1, 0, -0.1, 0.9;
+        return F;
+    }
+
+    M direction( int k )
+    {
+        M dF;
+        dF << 1, -0.5, 0.25, 0, 2, 0.5, -1, 0.3, 1;
+        return dF * ( k + 1 ) / 4.;
+    }
+
+    M structuralTensor()
+    {
+        M A = M::Zero();
+        A( 0, 0 ) = 1;
+        return A;
+    }
+
+    /// Compare the size of the model with its size for copy storage and its derivatives with
+    /// central differences. Arguments of update are kept alive until all derivatives have been
+    /// evaluated.
+    template < class Model >
+    void checkModel( const std::string& name, Model f, std::size_t sizeWithCopyStorage )
+    {
+#ifdef FUNG_REFERENCE_STORAGE
+        EXPECT_LT( sizeof( f ), sizeWithCopyStorage ) << name;
+#else
+        EXPECT_LE( sizeof( f ), sizeWithCopyStorage ) << name;
+#endif
+
+        const auto h = 1e-6;
+        const M F = deformationGradient(), dF0 = direction( 0 ), dF1 = direction( 1 );
+        const M Fp = F + h * dF1, Fm = F - h * dF1;
+
+        f.update( Fp );
+        const auto fp = f(), dfp = f.d1( dF0 );
+        f.update( Fm );
+        const auto fm = f(), dfm = f.d1( dF0 );
+
+        // copies must not refer to the state of the original function
+        auto g = f;
+        f.update( F );
+        auto copy = f;
+        f.update( Fp );
+
+        EXPECT_NEAR( g(), fm, 1e-12 * std::abs( fm ) ) << name;
+        EXPECT_NEAR( copy.d1( dF1 ), ( fp - fm ) / ( 2 * h ), 1e-6 * std::abs( copy.d1( dF1 ) ) )
+            << name;
+        EXPECT_NEAR( copy.d2( dF0, dF1 ), ( dfp - dfm ) / ( 2 * h ),
+                     1e-6 * std::abs( copy.d2( dF0, dF1 ) ) )
+            << name;
+    }
+}
+
+TEST( ModelSizeTest, Rubber )
+{
+    using namespace FunG;
+    const M I = M::Identity();
+    checkModel( "incompressibleNeoHooke", incompressibleNeoHooke( 1., I ), 160 );
+    checkModel( "compressibleNeoHooke", compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., I ),
+                336 );
+    checkModel( "modifiedCompressibleNeoHooke",
+                modifiedCompressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., I ), 480 );
+    checkModel( "compressibleMooneyRivlin",
+                compressibleMooneyRivlin< Pow< 2 >, LN >( 1., 1., 1., 1., I ), 488 );
+}
+
+TEST( ModelSizeTest, Biomechanics )
+{
+    using namespace FunG;
+    const M I = M::Identity();
+    const M A = structuralTensor();
+    checkModel( "compressibleSkin_Hendriks",
+                compressibleSkin_Hendriks< Pow< 2 >, LN >( 1., 1., I ), 464 );
+    checkModel( "compressibleMuscleTissue_Martins",
+                compressibleMuscleTissue_Martins< Pow< 2 >, LN >( 1., 1., A, I ), 808 );
+    checkModel( "compressibleAdiposeTissue_SommerHolzapfel",
+                compressibleAdiposeTissue_SommerHolzapfel< Pow< 2 >, LN >( 1., 1., A, I ),
+                720 );
+}
@@ -0,0 +1,183 @@
+// Counts the multiplications that remain in the derivatives of composite functions after
+// structurally vanishing terms have been eliminated at compile time.
+// MathOpTraits are specialized for counting, thus this file must be compiled into its own
+// executable.
+
+#include <fung/util/mathop_traits.hh>
+
+#include <Eigen/Dense>
+
+namespace
+{
+    using M = Eigen::Matrix< double, 3, 3 >;
+
+    int multiplications = 0;
+}
+
+namespace FunG
+{
+    template <>
+    struct MathOpTraits< double >
+    {
+        static double multiply( double lhs, double rhs ) noexcept
+        {
+            ++multiplications;
+            return lhs * rhs;
+        }
+
+        static double add( double lhs, double rhs ) noexcept
+        {
+            return lhs + rhs;
+        }
+    };
+
+    template <>
+    struct MathOpTraits< M >
+    {
+        template < class S >
+        static auto multiply( const M& lhs, const S& rhs )
+        {
+            ++multiplications;
+            return lhs * rhs;
+        }
+
+        template < class S, std::enable_if_t< !std::is_same< S, M >::value >* = nullptr >
+        static auto multiply( const S& lhs, const M& rhs )
+        {
+            ++multiplications;
+            return lhs * rhs;
+        }
+
+        static auto add( const M& lhs, const M& rhs )
+        {
+            return lhs + rhs;
+        }
+    };
+}
+
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/cmath/sine.hh>
+#include <fung/examples/rubber/mooney_rivlin.hh>
+#include <fung/examples/rubber/neo_hooke.hh>
+#include <fung/finalize.hh>
+#include <fung/generate.hh>
+#include <fung/identity.hh>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <tuple>
+
+namespace
+{
+    M deformationGradient()
+    {
+        M F;
+        F << 1.1, 0.1, 0, 0.2, 1, 0.1, 0, -0.1, 0.9;
+        return F;
+    }
+
+    M direction()
+    {
+        M dF;
+        dF << 1, -0.5, 0.25, 0, 2, 0.5, -1, 0.3, 1;
+        return dF;
+    }
+
+    /// Number of multiplications in update, d1, d2 and d3.
+    template < class Model >
+    std::array< int, 4 > countMultiplications( Model f )
+    {
+        const M F = deformationGradient(), dF = direction();
+        std::array< int, 4 > counts;
+
+        multiplications = 0;
+        f.update( F );
+        counts[ 0 ] = multiplications;
+        multiplications = 0;
+        f.d1( dF );
+        counts[ 1 ] = multiplications;
+        multiplications = 0;
+        f.d2( dF, dF );
+        counts[ 2 ] = multiplications;
+        multiplications = 0;
+        f.d3( dF, dF, dF );
+        counts[ 3 ] = multiplications;
+        return counts;
+    }
+}
+
+TEST( OperationCountTest, ProductWithLinearFactor )
+{
+    using namespace FunG;
+    auto f = finalize( Pow< 1 >( 2. ) * Sin( 2. ) );
+    auto g = finalize( Pow< 2, 2 >( 2. ) * Sin( 2. ) );
+    auto h = finalize( identity( 2. ) * Sin( 2. ) );
+
+    // Only d0*d3 and the three terms d1*d2 remain.
+    multiplications = 0;
+    const auto df = f.d3( 1., 1., 1. );
+    EXPECT_EQ( multiplications, 4 );
+
+    multiplications = 0;
+    const auto dg = g.d3( 1., 1., 1. );
+    EXPECT_EQ( multiplications, 4 );
+
+    multiplications = 0;
+    const auto dh = h.d3( 1., 1., 1. );
+    EXPECT_EQ( multiplications, 4 );
+
+    EXPECT_DOUBLE_EQ( df, dh );
+    EXPECT_DOUBLE_EQ( dg, dh );
+}
+
+TEST( OperationCountTest, StructurallyZeroDerivativesOfPow )
+{
+    using FunG::Pow;
+    using Arg = FunG::IndexedType< double, 0 >;
+    EXPECT_TRUE( ( FunG::Checks::Has::MemFn::d1< Pow< 1 >, Arg >::value ) );
+    EXPECT_FALSE( ( FunG::Checks::Has::MemFn::d2< Pow< 1 >, Arg, Arg >::value ) );
+    EXPECT_TRUE( ( FunG::Checks::Has::MemFn::d2< Pow< 4, 2 >, Arg, Arg >::value ) );
+    EXPECT_FALSE( ( FunG::Checks::Has::MemFn::d3< Pow< 4, 2 >, Arg, Arg, Arg >::value ) );
+    EXPECT_TRUE( ( FunG::Checks::Has::MemFn::d3< Pow< 5, 2 >, Arg, Arg, Arg >::value ) );
+    EXPECT_FALSE( ( FunG::Checks::Has::MemFn::d1< Pow< 0 >, Arg >::value ) );
+}
+
+TEST( OperationCountTest, ExampleModels )
+{
+    using namespace FunG;
+    const M I = M::Identity();
+
+    const auto neoHooke =
+        countMultiplications( compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., I ) );
+    const auto genericNeoHooke =
+        countMultiplications( compressibleNeoHooke< Pow< 4, 2 >, LN >( 1., 1., 1., I ) );
+    EXPECT_EQ( neoHooke, genericNeoHooke );
+
+    const auto mooneyRivlin =
+        countMultiplications( compressibleMooneyRivlin< Pow< 2 >, LN >( 1., 1., 1., 1., I ) );
+    const auto genericMooneyRivlin =
+        countMultiplications( compressibleMooneyRivlin< Pow< 4, 2 >, LN >( 1., 1., 1., 1., I ) );
+    EXPECT_EQ( mooneyRivlin, genericMooneyRivlin );
+}
+
+TEST( OperationCountTest, FusedDerivatives )
+{
+    using namespace FunG;
+    // The first derivatives of the product enter both derivatives of its square.
+    auto f = finalize( squared( Sin( 2. ) * Pow< 3 >( 2. ) ) );
+
+    multiplications = 0;
+    const auto d1 = f.d1( 0.5 );
+    const auto d2 = f.d2( 0.5, 2. );
+    const auto separate = multiplications;
+
+    multiplications = 0;
+    const auto d = f.derivatives( 0.5, 2. );
+    const auto fused = multiplications;
+
+    EXPECT_LT( fused, separate );
+    EXPECT_DOUBLE_EQ( std::get< 0 >( d ), d1 );
+    EXPECT_DOUBLE_EQ( std::get< 1 >( d ), d2 );
+}
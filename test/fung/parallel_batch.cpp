@@ -0,0 +1,92 @@
+#define FUNG_ENABLE_EXCEPTIONS
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/examples/rubber/neo_hooke.hh>
+#include <fung/finalize.hh>
+#include <fung/generate.hh>
+#include <fung/identity.hh>
+#include <fung/parallel_batch.hh>
+#include <fung/util/exceptions.hh>
+
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+
+namespace
+{
+    using M = Eigen::Matrix< double, 3, 3 >;
+
+    auto generateDeformationGradient( double s )
+    {
+        M F;
+        F << 1 + s, 0.1 * s, 0, 0.2 * s, 1, 0.1, 0, -0.1 * s, 1 - 0.1 * s;
+        return F;
+    }
+
+    auto generateBatch( std::size_t n )
+    {
+        FunG::Batch< M > x( n );
+        for ( std::size_t p = 0; p < n; ++p )
+            x.set( p, generateDeformationGradient( 0.001 * p ) );
+        return x;
+    }
+}
+
+TEST( ParallelBatchTest, CompressibleNeoHooke )
+{
+    using namespace FunG;
+    const auto f = compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., M::Identity().eval() );
+    auto g = f;
+    const auto x = generateBatch( 300 );
+
+    const auto expected = evaluate( g, x );
+    for ( auto threads : { 1u, 3u, 0u } )
+    {
+        BatchResult< M > result;
+        parallel_evaluate( f, x, result, threads );
+        ASSERT_EQ( result.d0.size(), x.size() );
+        ASSERT_EQ( result.d2.components(), 81 );
+        EXPECT_TRUE( std::equal( result.d0.component( 0 ), result.d0.component( 0 ) + x.size(),
+                                 expected.d0.component( 0 ) ) );
+        EXPECT_TRUE( std::equal( result.d1.component( 0 ), result.d1.component( 0 ) + 9 * x.size(),
+                                 expected.d1.component( 0 ) ) );
+        EXPECT_TRUE( std::equal( result.d2.component( 0 ),
+                                 result.d2.component( 0 ) + 81 * x.size(),
+                                 expected.d2.component( 0 ) ) );
+    }
+}
+
+TEST( ParallelBatchTest, MoreThreadsThanPoints )
+{
+    using namespace FunG;
+    const auto f = incompressibleNeoHooke( 1., M::Identity().eval() );
+    auto g = f;
+    const auto x = generateBatch( 5 );
+
+    const auto result = parallel_evaluate< 0 >( f, x, 16 );
+    EXPECT_EQ( result.d0.size(), x.size() );
+    EXPECT_EQ( result.d1.size(), 0u );
+    g.update( x[ 3 ] );
+    EXPECT_DOUBLE_EQ( result.d0( 0, 3 ), g() );
+}
+
+TEST( ParallelBatchTest, EmptyBatch )
+{
+    using namespace FunG;
+    const auto f = incompressibleNeoHooke( 1., M::Identity().eval() );
+    const auto result = parallel_evaluate( f, Batch< M >(), 4 );
+    EXPECT_EQ( result.d0.size(), 0u );
+}
+
+TEST( ParallelBatchTest, ExceptionIsRethrown )
+{
+    using namespace FunG;
+    const auto f = finalize( Sqrt() << identity( 1. ) );
+    Batch< double > x( 500 );
+    for ( std::size_t p = 0; p < x.size(); ++p )
+        x.set( p, p == 321 ? -1. : 1. + p );
+
+    EXPECT_THROW( parallel_evaluate( f, x, 4 ), OutOfDomainException );
+}
@@ -0,0 +1,128 @@
+#include <fung/cmath/cosine.hh>
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/cmath/sine.hh>
+#include <fung/examples/rubber/neo_hooke.hh>
+#include <fung/finalize.hh>
+#include <fung/generate.hh>
+#include <fung/profile.hh>
+#include <fung/variable.hh>
+
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+
+#include <sstream>
+
+namespace
+{
+    using M = Eigen::Matrix< double, 3, 3 >;
+    using FunG::ProfiledOperation;
+
+    M deformationGradient()
+    {
+        M F;
+        F << 1.1, 0.1, 0, 0.2, 1, 0.1, 0, -0.1, 0.9;
+        return F;
+    }
+}
+
+TEST( ProfileTest, RecordsEachNode )
+{
+    using namespace FunG;
+    auto f = profile( finalize( 2 * ( Sin() * Cos() ) + Pow< 3 >() ) );
+    const auto& records = f.profileData().records();
+    ASSERT_EQ( records.size(), 6u );
+    EXPECT_EQ( records[ 0 ].node, "Sum" );
+    EXPECT_EQ( records[ 0 ].depth, 0 );
+    EXPECT_EQ( records[ 1 ].node, "Scale" );
+    EXPECT_EQ( records[ 1 ].depth, 1 );
+    EXPECT_EQ( records[ 2 ].node, "Product" );
+    EXPECT_EQ( records[ 3 ].node, "Sin" );
+    EXPECT_EQ( records[ 3 ].depth, 3 );
+    EXPECT_EQ( records[ 4 ].node, "Cos" );
+    EXPECT_EQ( records[ 5 ].node, "Pow<3, 1>" );
+    EXPECT_EQ( records[ 5 ].depth, 1 );
+
+    f.resetProfile();
+    f.update( 0.5 );
+    f.d1( 1. );
+    f.d2( 1., 1. );
+    f.d2( 1., 1. );
+    for ( const auto& record : records )
+    {
+        EXPECT_EQ( record[ ProfiledOperation::update ].calls, 1u );
+        EXPECT_EQ( record[ ProfiledOperation::d2 ].calls, 2u );
+        EXPECT_EQ( record[ ProfiledOperation::d3 ].calls, 0u );
+    }
+    EXPECT_EQ( records[ 0 ][ ProfiledOperation::d1 ].calls, 1u );
+    EXPECT_EQ( records[ 2 ][ ProfiledOperation::d1 ].calls, 1u );
+    // the second derivative of the product requires the first derivatives of its factors
+    EXPECT_EQ( records[ 3 ][ ProfiledOperation::d1 ].calls, 5u );
+    EXPECT_EQ( records[ 4 ][ ProfiledOperation::d1 ].calls, 5u );
+    EXPECT_GT( records[ 0 ][ ProfiledOperation::d2 ].ticks, 0u );
+
+    f.resetProfile();
+    EXPECT_EQ( records[ 0 ][ ProfiledOperation::d2 ].calls, 0u );
+    EXPECT_EQ( records[ 0 ][ ProfiledOperation::d2 ].ticks, 0u );
+}
+
+TEST( ProfileTest, SameDerivatives )
+{
+    using namespace FunG;
+    auto f = finalize( 2 * ( Sin() * Cos() ) + Pow< 3 >() );
+    auto g = profile( f );
+    f.update( 0.5 );
+    g.update( 0.5 );
+    EXPECT_DOUBLE_EQ( g(), f() );
+    EXPECT_DOUBLE_EQ( g.d1( 1. ), f.d1( 1. ) );
+    EXPECT_DOUBLE_EQ( g.d2( 1., 1. ), f.d2( 1., 1. ) );
+    EXPECT_DOUBLE_EQ( g.d3( 1., 1., 1. ), f.d3( 1., 1., 1. ) );
+}
+
+TEST( ProfileTest, AbsentDerivativesStayAbsent )
+{
+    using namespace FunG;
+    const auto f = profile( 2 * Pow< 2 >() );
+    using IndexedArg = IndexedType< double, 0 >;
+    EXPECT_TRUE( ( Checks::Has::MemFn::d2< decltype( f ), IndexedArg, IndexedArg >::value ) );
+    EXPECT_FALSE(
+        ( Checks::Has::MemFn::d3< decltype( f ), IndexedArg, IndexedArg, IndexedArg >::value ) );
+}
+
+TEST( ProfileTest, Variables )
+{
+    using namespace FunG;
+    auto f = finalize( variable< 0 >( 1. ) * pow< 2 >( variable< 1 >( 2. ) ) );
+    auto g = profile( f );
+    EXPECT_TRUE( Checks::Has::variable< decltype( g ) >() );
+
+    g.update< 0 >( 3. );
+    g.update< 1 >( 4. );
+    f.update< 0 >( 3. );
+    f.update< 1 >( 4. );
+    EXPECT_DOUBLE_EQ( g(), f() );
+    EXPECT_DOUBLE_EQ( ( g.d1< 1 >( 1. ) ), ( f.d1< 1 >( 1. ) ) );
+    EXPECT_DOUBLE_EQ( ( g.d2< 0, 1 >( 1., 1. ) ), ( f.d2< 0, 1 >( 1., 1. ) ) );
+}
+
+TEST( ProfileTest, CompressibleNeoHooke )
+{
+    using namespace FunG;
+    auto f = compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., M::Identity().eval() );
+    auto g = profile( f );
+    const M F = deformationGradient();
+    const M dF = M::Identity();
+    f.update( F );
+    g.update( F );
+    EXPECT_DOUBLE_EQ( g(), f() );
+    EXPECT_DOUBLE_EQ( g.d1( dF ), f.d1( dF ) );
+    EXPECT_DOUBLE_EQ( g.d2( dF, dF ), f.d2( dF, dF ) );
+    EXPECT_DOUBLE_EQ( g.d3( dF, dF, dF ), f.d3( dF, dF, dF ) );
+
+    std::ostringstream report;
+    g.report( report );
+    EXPECT_NE( report.str().find( "Chain" ), std::string::npos );
+    EXPECT_NE( report.str().find( "Determinant" ), std::string::npos );
+    EXPECT_GT( g.profileData().records().size(), 5u );
+}
@@ -0,0 +1,158 @@
+#define FUNG_ENABLE_EXCEPTIONS
+#include <fung/cmath/log.hh>
+#include <fung/cmath/pow.hh>
+#include <fung/cmath/sine.hh>
+#include <fung/examples/rubber/neo_hooke.hh>
+#include <fung/finalize.hh>
+#include <fung/generate.hh>
+#include <fung/stateless.hh>
+#include <fung/util/chainer.hh>
+
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using M = Eigen::Matrix< double, 3, 3 >;
+
+    M generateDeformationGradient( double s )
+    {
+        M F;
+        F << 1 + s, 0.1 * s, 0, 0.2 * s, 1, 0.1, 0, -0.1 * s, 1 - 0.1 * s;
+        return F;
+    }
+
+    M generateDirection()
+    {
+        M dF;
+        dF << 1, -0.5, 0.25, 0, 2, 0.5, -1, 0.3, 1;
+        return dF;
+    }
+
+    /// Counts the calls of update.
+    struct CountingPow2 : FunG::Chainer< CountingPow2 >
+    {
+        void update( double x_ )
+        {
+            ++updates;
+            x = x_;
+        }
+
+        double d0() const
+        {
+            return x * x;
+        }
+
+        double d1( double dx ) const
+        {
+            return 2 * x * dx;
+        }
+
+        double d2( double dx, double dy ) const
+        {
+            return 2 * dx * dy;
+        }
+
+        static int updates;
+
+    private:
+        double x = 0;
+    };
+
+    int CountingPow2::updates = 0;
+
+    auto generateModel()
+    {
+        using namespace FunG;
+        return compressibleNeoHooke< Pow< 2 >, LN >( 1., 1., 1., M::Identity().eval() );
+    }
+}
+
+TEST( StatelessTest, Scalar )
+{
+    using namespace FunG;
+    const auto f = stateless( finalize( Sin() * Pow< 3 >() ) );
+    auto g = finalize( Sin() * Pow< 3 >() );
+    g.update( 0.5 );
+
+    EXPECT_DOUBLE_EQ( f( 0.5 ), g() );
+    EXPECT_DOUBLE_EQ( f.d1( 0.5, 2. ), g.d1( 2. ) );
+    EXPECT_DOUBLE_EQ( f.d2( 0.5, 2., 3. ), g.d2( 2., 3. ) );
+    EXPECT_DOUBLE_EQ( f.d3( 0.5, 2., 3., 4. ), g.d3( 2., 3., 4. ) );
+
+    const auto s = f.state( 0.5 );
+    EXPECT_DOUBLE_EQ( f( s ), g() );
+    EXPECT_DOUBLE_EQ( f.d3( s, 2., 3., 4. ), g.d3( 2., 3., 4. ) );
+}
+
+TEST( StatelessTest, PrototypeIsNotModified )
+{
+    using namespace FunG;
+    const auto f = stateless( generateModel() );
+    auto g = generateModel();
+    const M F = generateDeformationGradient( 0.1 ), dF = generateDirection();
+
+    const auto s = f.state( F );
+    EXPECT_DOUBLE_EQ( f.function()(), g() );
+    EXPECT_DOUBLE_EQ( f.function().d1( dF ), g.d1( dF ) );
+
+    g.update( F );
+    EXPECT_DOUBLE_EQ( f( s ), g() );
+    EXPECT_DOUBLE_EQ( f.d1( s, dF ), g.d1( dF ) );
+    EXPECT_DOUBLE_EQ( f.d2( s, dF, dF ), g.d2( dF, dF ) );
+    EXPECT_DOUBLE_EQ( f.d3( s, dF, dF, dF ), g.d3( dF, dF, dF ) );
+}
+
+TEST( StatelessTest, DerivativesDoNotUpdate )
+{
+    using namespace FunG;
+    const auto f = stateless( finalize( 2 * CountingPow2() + Sin()( CountingPow2() ) ) );
+    auto g = finalize( 2 * Pow< 2 >() + Sin()( Pow< 2 >() ) );
+    g.update( 0.5 );
+
+    CountingPow2::updates = 0;
+    const auto s = f.state( 0.5 );
+    EXPECT_EQ( CountingPow2::updates, 2 );
+    EXPECT_DOUBLE_EQ( f( s ), g() );
+    EXPECT_DOUBLE_EQ( f.d1( s, 2. ), g.d1( 2. ) );
+    EXPECT_DOUBLE_EQ( f.d2( s, 2., 3. ), g.d2( 2., 3. ) );
+    EXPECT_DOUBLE_EQ( f.d3( s, 2., 3., 4. ), g.d3( 2., 3., 4. ) );
+    EXPECT_EQ( CountingPow2::updates, 2 );
+
+    EXPECT_DOUBLE_EQ( f.d2( 0.5, 2., 3. ), g.d2( 2., 3. ) );
+    EXPECT_EQ( CountingPow2::updates, 4 );
+}
+
+TEST( StatelessTest, SharedBetweenThreads )
+{
+    using namespace FunG;
+    const auto f = stateless( generateModel() );
+    const M dF = generateDirection();
+    const int n = 200, numberOfThreads = 4;
+
+    std::vector< double > values( n ), derivatives( n );
+    std::vector< std::thread > threads;
+    for ( int t = 0; t < numberOfThreads; ++t )
+        threads.emplace_back( [&f, &values, &derivatives, &dF, t] {
+            for ( int p = t; p < n; p += numberOfThreads )
+            {
+                const M F = generateDeformationGradient( 0.001 * p );
+                values[ p ] = f( F );
+                derivatives[ p ] = f.d2( F, dF, dF );
+            }
+        } );
+    for ( auto& thread : threads )
+        thread.join();
+
+    auto g = generateModel();
+    for ( int p = 0; p < n; ++p )
+    {
+        g.update( generateDeformationGradient( 0.001 * p ) );
+        EXPECT_DOUBLE_EQ( values[ p ], g() );
+        EXPECT_DOUBLE_EQ( derivatives[ p ], g.d2( dF, dF ) );
+    }
+}
@@ -0,0 +1,224 @@
+#define FUNG_ENABLE_EXCEPTIONS
+#include <fung/cmath/pow.hh>
+#include <fung/finalize.hh>
+#include <fung/generate.hh>
+#include <fung/linear_algebra/basis_direction.hh>
+#include <fung/linear_algebra/determinant.hh>
+#include <fung/linear_algebra/frobenius_norm.hh>
+#include <fung/linear_algebra/principal_invariants.hh>
+#include <fung/linear_algebra/strain_tensor.hh>
+#include <fung/linear_algebra/trace.hh>
+
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+
+#include <type_traits>
+
+namespace
+{
+    using M = Eigen::Matrix3d;
+    using DM = Eigen::MatrixXd;
+    using FunG::LinearAlgebra::BasisDirection;
+    using FunG::LinearAlgebra::UnitDirection;
+
+    template < class Matrix >
+    Matrix deformationGradient()
+    {
+        Matrix F( 3, 3 );
+        F << 1.1, 0.1, 0, 0.2, 1, 0.1, 0, -0.1, 0.9;
+        return F;
+    }
+
+    template < class Matrix >
+    Matrix dense( const Matrix& A )
+    {
+        return A;
+    }
+
+    template < class Matrix, class Scalar, int n >
+    Matrix dense( const FunG::LinearAlgebra::SymmetricMatrix< Scalar, n >& A )
+    {
+        Matrix B( 3, 3 );
+        for ( int i = 0; i < 3; ++i )
+            for ( int j = 0; j < 3; ++j )
+                B( i, j ) = A( i, j );
+        return B;
+    }
+
+    /// Compares derivatives in basis directions with derivatives in the corresponding dense
+    /// directions for all pairs of basis directions.
+    template < class Matrix, class Direction, class StrainTensor >
+    void expectSameDerivatives( const StrainTensor& f, Direction makeDirection )
+    {
+        for ( int k = 0; k < 9; ++k )
+        {
+            const auto dF = makeDirection( k / 3, k % 3 );
+            const Matrix denseDF = dF;
+            EXPECT_TRUE(
+                dense< Matrix >( f.d1( dF ) ).isApprox( dense< Matrix >( f.d1( denseDF ) ) ) );
+            for ( int l = 0; l < 9; ++l )
+            {
+                const auto dG = makeDirection( l / 3, l % 3 );
+                const Matrix denseDG = dG;
+                EXPECT_EQ( dense< Matrix >( f.d2( dF, dG ) ),
+                           dense< Matrix >( f.d2( denseDF, denseDG ) ) );
+            }
+        }
+    }
+
+    /// Compares first and second derivatives of a scalar valued function in basis directions
+    /// with derivatives in the corresponding dense directions.
+    template < class Matrix, class Function, class Direction >
+    void expectSameScalarDerivatives( const Function& f, Direction makeDirection, int n = 3 )
+    {
+        for ( int k = 0; k < n * n; ++k )
+        {
+            const auto dF = makeDirection( k / n, k % n );
+            const Matrix denseDF = dF;
+            EXPECT_NEAR( f.d1( dF ), f.d1( denseDF ), 1e-12 );
+            for ( int l = 0; l < n * n; ++l )
+            {
+                const auto dG = makeDirection( l / n, l % n );
+                const Matrix denseDG = dG;
+                EXPECT_NEAR( f.d2( dF, dG ), f.d2( denseDF, denseDG ), 1e-12 );
+            }
+        }
+    }
+
+    /// Compares third derivatives of a scalar valued function in basis directions with
+    /// derivatives in the corresponding dense directions.
+    template < class Matrix, class Function, class Direction >
+    void expectSameThirdDerivatives( const Function& f, Direction makeDirection, int n = 3 )
+    {
+        for ( int k = 0; k < n * n; ++k )
+            for ( int l = 0; l < n * n; ++l )
+                for ( int m = 0; m < n * n; ++m )
+                {
+                    const auto dF = makeDirection( k / n, k % n ),
+                               dG = makeDirection( l / n, l % n ),
+                               dH = makeDirection( m / n, m % n );
+                    const Matrix denseDF = dF, denseDG = dG, denseDH = dH;
+                    EXPECT_NEAR( f.d3( dF, dG, dH ), f.d3( denseDF, denseDG, denseDH ), 1e-12 );
+                }
+    }
+}
+
+TEST( BasisDirectionTest, IsUnitMatrix )
+{
+    const BasisDirection< M > E( 1, 2 );
+    EXPECT_EQ( E.rowIndex(), 1 );
+    EXPECT_EQ( E.colIndex(), 2 );
+    EXPECT_EQ( E.matrix()( 1, 2 ), 1. );
+    EXPECT_EQ( E.matrix().sum(), 1. );
+
+    const BasisDirection< DM > dynamicE( 2, 0, 3, 3 );
+    EXPECT_EQ( dynamicE.matrix().rows(), 3 );
+    EXPECT_EQ( dynamicE.matrix()( 2, 0 ), 1. );
+    EXPECT_EQ( dynamicE.matrix().sum(), 1. );
+}
+
+TEST( BasisDirectionTest, DefaultIsFirstUnitMatrix )
+{
+    const BasisDirection< M > E;
+    EXPECT_EQ( E.rowIndex(), 0 );
+    EXPECT_EQ( E.colIndex(), 0 );
+    EXPECT_EQ( E.matrix(), BasisDirection< M >( 0, 0 ).matrix() );
+    static_assert( !std::is_default_constructible< BasisDirection< DM > >::value, "" );
+}
+
+TEST( BasisDirectionTest, UnitDirection )
+{
+    const UnitDirection< M, 1, 2 > E;
+    static_assert( UnitDirection< M, 1, 2 >::rowIndex() == 1, "" );
+    static_assert( UnitDirection< M, 1, 2 >::colIndex() == 2, "" );
+    EXPECT_EQ( E.matrix(), BasisDirection< M >( 1, 2 ).matrix() );
+
+    const UnitDirection< DM, 2, 0 > dynamicE( 3, 3 );
+    EXPECT_EQ( dynamicE.matrix(), BasisDirection< DM >( 2, 0, 3, 3 ).matrix() );
+
+    const auto F = deformationGradient< M >();
+    const auto f = FunG::LinearAlgebra::det( F );
+    EXPECT_EQ( f.d1( E ), f.d1( BasisDirection< M >( 1, 2 ) ) );
+    EXPECT_DOUBLE_EQ( f.d1( E ), f.d1( M( E ) ) );
+}
+
+TEST( BasisDirectionTest, StrainTensors )
+{
+    using namespace FunG::LinearAlgebra;
+    const auto F = deformationGradient< M >();
+    const auto constantSize = []( int i, int j ) { return BasisDirection< M >( i, j ); };
+    expectSameDerivatives< M >( RightCauchyGreenStrainTensor< M >( F ), constantSize );
+    expectSameDerivatives< M >( LeftCauchyGreenStrainTensor< M >( F ), constantSize );
+    expectSameDerivatives< M >( SymmetricRightCauchyGreenStrainTensor< M >( F ), constantSize );
+}
+
+TEST( BasisDirectionTest, StrainTensors_Dynamic )
+{
+    using namespace FunG::LinearAlgebra;
+    const auto F = deformationGradient< DM >();
+    const auto dynamicSize = []( int i, int j ) { return BasisDirection< DM >( i, j, 3, 3 ); };
+    expectSameDerivatives< DM >( RightCauchyGreenStrainTensor< DM >( F ), dynamicSize );
+    expectSameDerivatives< DM >( LeftCauchyGreenStrainTensor< DM >( F ), dynamicSize );
+}
+
+TEST( BasisDirectionTest, ScalarFunctions )
+{
+    using namespace FunG::LinearAlgebra;
+    const auto F = deformationGradient< M >();
+    const auto constantSize = []( int i, int j ) { return BasisDirection< M >( i, j ); };
+    expectSameScalarDerivatives< M >( FunG::finalize( trace( F ) ), constantSize );
+    expectSameScalarDerivatives< M >( SquaredFrobeniusNorm< M >( F ), constantSize );
+    expectSameScalarDerivatives< M >( det( F ), constantSize );
+    expectSameThirdDerivatives< M >( det( F ), constantSize );
+    expectSameScalarDerivatives< M >( i2( F ), constantSize );
+
+    using M2 = Eigen::Matrix2d;
+    const M2 G = F.topLeftCorner< 2, 2 >();
+    const auto twoByTwo = []( int i, int j ) { return BasisDirection< M2 >( i, j ); };
+    expectSameScalarDerivatives< M2 >( det( G ), twoByTwo, 2 );
+    expectSameScalarDerivatives< M2 >( i2( G ), twoByTwo, 2 );
+}
+
+TEST( BasisDirectionTest, ScalarFunctions_Dynamic )
+{
+    using namespace FunG::LinearAlgebra;
+    const auto F = deformationGradient< DM >();
+    const auto dynamicSize = []( int i, int j ) { return BasisDirection< DM >( i, j, 3, 3 ); };
+    expectSameScalarDerivatives< DM >( FunG::finalize( trace( F ) ), dynamicSize );
+    expectSameScalarDerivatives< DM >( SquaredFrobeniusNorm< DM >( F ), dynamicSize );
+    expectSameScalarDerivatives< DM >( det( F ), dynamicSize );
+    expectSameThirdDerivatives< DM >( det( F ), dynamicSize );
+    expectSameScalarDerivatives< DM >( i2( F ), dynamicSize );
+}
+
+TEST( BasisDirectionTest, Determinant4x4 )
+{
+    using M4 = Eigen::Matrix4d;
+    M4 A;
+    A << 2, 1, 0, 0.5, 1, 3, 1, 0, 0, 1, 4, 1, 0.5, 0, 1, 5;
+    const auto makeDirection = []( int i, int j ) { return BasisDirection< M4 >( i, j ); };
+    const auto f = FunG::LinearAlgebra::det( A );
+    expectSameScalarDerivatives< M4 >( f, makeDirection, 4 );
+    expectSameThirdDerivatives< M4 >( f, makeDirection, 4 );
+    expectSameScalarDerivatives< M4 >( FunG::LinearAlgebra::i2( A ), makeDirection, 4 );
+
+    // singular matrix, derivatives fall back to replacing rows
+    A.row( 3 ) = A.row( 0 );
+    const auto g = FunG::LinearAlgebra::det( A );
+    expectSameScalarDerivatives< M4 >( g, makeDirection, 4 );
+}
+
+TEST( BasisDirectionTest, Compositions )
+{
+    using namespace FunG::LinearAlgebra;
+    const auto F = deformationGradient< M >();
+    const auto constantSize = []( int i, int j ) { return BasisDirection< M >( i, j ); };
+    const auto f = FunG::finalize( det( F ) * trace( F ) + FunG::Pow< 2 >()( det( F ) ) +
+                                   2 * SquaredFrobeniusNorm< M >( F ) + i2( F ) );
+    expectSameScalarDerivatives< M >( f, constantSize );
+    expectSameThirdDerivatives< M >( f, constantSize );
+
+    const auto g = FunG::finalize( i2( strainTensor( F ) ) * trace( F ) );
+    expectSameScalarDerivatives< M >( g, constantSize );
+}
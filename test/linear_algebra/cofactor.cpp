@@ -109,3 +109,21 @@ TEST(CofactorTest,D1)
   EXPECT_DOUBLE_EQ( value , A(0,0) + A(1,1) );
 }
 
+
+TEST(CofactorTest,4x4)
+{
+  using M4 = Eigen::Matrix<double,4,4>;
+  M4 A;
+  A << 2, 1, 0, 3,
+       1, 4, 1, 0,
+       0, 2, 5, 1,
+       1, 0, 1, 6;
+  const M4 cofA = A.determinant() * A.inverse().transpose();
+
+  EXPECT_NEAR( (computeCofactor<0,0>(A)), cofA(0,0), 1e-12 );
+  EXPECT_NEAR( (computeCofactor<0,3>(A)), cofA(0,3), 1e-12 );
+  EXPECT_NEAR( (computeCofactor<1,2>(A)), cofA(1,2), 1e-12 );
+  EXPECT_NEAR( (computeCofactor<2,1>(A)), cofA(2,1), 1e-12 );
+  EXPECT_NEAR( (computeCofactor<3,0>(A)), cofA(3,0), 1e-12 );
+  EXPECT_NEAR( (computeCofactor<3,3>(A)), cofA(3,3), 1e-12 );
+}
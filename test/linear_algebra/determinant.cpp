@@ -63,3 +63,157 @@ TEST(DeterminantTest,D3)
   auto d = det(generateA());
   EXPECT_DOUBLE_EQ( d.d3(generateDA(),generateDA(),generateDA()) , 6. );
 }
+
+namespace
+{
+  template <int n>
+  using MN = Eigen::Matrix<double,n,n>;
+
+  template <int n>
+  MN<n> generateRegularA()
+  {
+    MN<n> m;
+    for(int i=0; i<n; ++i)
+      for(int j=0; j<n; ++j)
+        m(i,j) = 1./(i+j+1) + ( (i*n+j)%3 == 0 ? 1. : 0. ) + ( i==j ? n : 0 );
+    return m;
+  }
+
+  template <int n>
+  MN<n> generateSingularA()
+  {
+    MN<n> m = generateRegularA<n>();
+    m.row(n-1) = m.row(0) - 2 * m.row(1);
+    return m;
+  }
+
+  template <int n>
+  MN<n> generateDirection(int k)
+  {
+    MN<n> m;
+    for(int i=0; i<n; ++i)
+      for(int j=0; j<n; ++j)
+        m(i,j) = ( (i+2*j+k)%5 ) - 2.;
+    return m;
+  }
+
+  constexpr double h = 1e-5;
+  constexpr double tol = 1e-6;
+
+  template <int n>
+  void checkDerivatives(const MN<n>& A)
+  {
+    const MN<n> dA1 = generateDirection<n>(1), dA2 = generateDirection<n>(2), dA3 = generateDirection<n>(3);
+    auto d = det(A);
+    auto dp = det(MN<n>(A + h*dA3)), dm = det(MN<n>(A - h*dA3));
+
+    EXPECT_NEAR( d.d0(), A.determinant(), tol * std::abs(A.determinant()) + tol );
+    EXPECT_NEAR( d.d1(dA3), ( dp.d0() - dm.d0() ) / (2*h), tol * std::abs(d.d1(dA3)) + tol );
+    EXPECT_NEAR( d.d2(dA1,dA3), ( dp.d1(dA1) - dm.d1(dA1) ) / (2*h), tol * std::abs(d.d2(dA1,dA3)) + tol );
+    EXPECT_NEAR( d.d3(dA1,dA2,dA3), ( dp.d2(dA1,dA2) - dm.d2(dA1,dA2) ) / (2*h), tol * std::abs(d.d3(dA1,dA2,dA3)) + tol );
+    EXPECT_NEAR( d.d2(dA1,dA2), d.d2(dA2,dA1), tol * std::abs(d.d2(dA1,dA2)) + tol );
+    EXPECT_NEAR( d.d3(dA1,dA2,dA3), d.d3(dA3,dA1,dA2), tol * std::abs(d.d3(dA1,dA2,dA3)) + tol );
+  }
+}
+
+TEST(DeterminantTest,4x4)
+{
+  checkDerivatives(generateRegularA<4>());
+}
+
+TEST(DeterminantTest,4x4_Singular)
+{
+  const auto A = generateSingularA<4>();
+  EXPECT_NEAR( det(A).d0(), 0., 1e-12 );
+  checkDerivatives(A);
+}
+
+TEST(DeterminantTest,6x6)
+{
+  checkDerivatives(generateRegularA<6>());
+}
+
+TEST(DeterminantTest,6x6_Singular)
+{
+  const auto A = generateSingularA<6>();
+  EXPECT_NEAR( det(A).d0(), 0., 1e-12 );
+  checkDerivatives(A);
+}
+
+TEST(DeterminantTest,6x6_Identity)
+{
+  const MN<6> I = MN<6>::Identity(), dA = generateDirection<6>(1);
+  auto d = det(I);
+  EXPECT_DOUBLE_EQ( d.d0(), 1. );
+  EXPECT_DOUBLE_EQ( d.d1(dA), dA.trace() );
+  EXPECT_DOUBLE_EQ( d.d2(dA,I), 5*dA.trace() );
+  EXPECT_DOUBLE_EQ( d.d3(I,I,I), 120. );
+}
+
+TEST(SecondPrincipalInvariantTest,4x4)
+{
+  using FunG::LinearAlgebra::i2;
+  const auto A = generateRegularA<4>();
+  const MN<4> dA1 = generateDirection<4>(1), dA2 = generateDirection<4>(2);
+  auto f = i2(A);
+
+  auto sumOfPrincipalMinors = 0.;
+  for(int i=0; i<4; ++i)
+    for(int j=i+1; j<4; ++j)
+      sumOfPrincipalMinors += A(i,i)*A(j,j) - A(i,j)*A(j,i);
+  EXPECT_NEAR( f.d0(), sumOfPrincipalMinors, 1e-12 );
+
+  auto fp = i2(MN<4>(A + h*dA2)), fm = i2(MN<4>(A - h*dA2));
+  EXPECT_NEAR( f.d1(dA2), ( fp.d0() - fm.d0() ) / (2*h), tol );
+  EXPECT_NEAR( f.d2(dA1,dA2), ( fp.d1(dA1) - fm.d1(dA1) ) / (2*h), tol );
+}
+
+TEST(DeterminantTest,Dynamic_ChangeOfDimension)
+{
+  using DM = Eigen::MatrixXd;
+  using FunG::LinearAlgebra::i2;
+  const DM A3 = generateA(), dA3 = generateDA();
+  const DM A2 = A3.topLeftCorner(2,2), dA2 = dA3.topLeftCorner(2,2);
+
+  auto d = det(A3);
+  auto f = i2(A3);
+  EXPECT_DOUBLE_EQ( d.d0(), 21. );
+  EXPECT_DOUBLE_EQ( d.d1(dA3), -46. );
+  EXPECT_DOUBLE_EQ( d.d3(dA3,dA3,dA3), 6. );
+  EXPECT_DOUBLE_EQ( f.d2(dA3,dA3), 6. );
+
+  d.update(A2);
+  f.update(A2);
+  EXPECT_DOUBLE_EQ( d.d0(), -3. );
+  EXPECT_DOUBLE_EQ( d.d1(dA2), 4. );
+  EXPECT_DOUBLE_EQ( d.d2(dA2,dA2), 2. );
+  EXPECT_DOUBLE_EQ( d.d3(dA2,dA2,dA2), 0. );
+  EXPECT_DOUBLE_EQ( f.d0(), 4. );
+
+  d.update(A3);
+  f.update(A3);
+  EXPECT_DOUBLE_EQ( d.d0(), 21. );
+  EXPECT_DOUBLE_EQ( d.d2(dA3,dA3), 10. );
+  EXPECT_DOUBLE_EQ( f.d2(dA3,dA3), 6. );
+}
+
+TEST(DeterminantTest,Dynamic_DefaultConstructed)
+{
+  using DM = Eigen::MatrixXd;
+  const DM dA = generateDA();
+  FunG::LinearAlgebra::Determinant<DM> d;
+  FunG::LinearAlgebra::SecondPrincipalInvariant<DM> f;
+  EXPECT_DOUBLE_EQ( d.d0(), 0. );
+  EXPECT_DOUBLE_EQ( d.d1(dA), 0. );
+  EXPECT_DOUBLE_EQ( d.d3(dA,dA,dA), 0. );
+  EXPECT_DOUBLE_EQ( f.d1(dA), 0. );
+}
+
+TEST(DeterminantTest,Dynamic_UnsupportedDimension)
+{
+  using DM = Eigen::MatrixXd;
+  using FunG::LinearAlgebra::i2;
+  const DM A = DM::Identity(4,4);
+  EXPECT_THROW( det(A), FunG::OutOfDomainException );
+  EXPECT_THROW( i2(A), FunG::OutOfDomainException );
+}
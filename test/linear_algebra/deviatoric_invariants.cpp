@@ -0,0 +1,88 @@
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+
+#define FUNG_ENABLE_EXCEPTIONS
+#include <fung/finalize.hh>
+#include <fung/linear_algebra.hh>
+
+namespace
+{
+  constexpr int dim = 3;
+
+  using M = Eigen::Matrix<double,dim,dim>;
+  using DM = Eigen::MatrixXd;
+
+  template <class Matrix>
+  Matrix generateSigma()
+  {
+    Matrix sigma = Matrix::Identity(dim,dim);
+    sigma(0,1) = 1;
+    return sigma;
+  }
+
+  template <class Matrix>
+  Matrix generateDSigma()
+  {
+    Matrix dSigma = Matrix::Zero(dim,dim);
+    dSigma(0,1) = 1;
+    return dSigma;
+  }
+}
+
+TEST(DeviatorTest,D1)
+{
+  using namespace FunG::LinearAlgebra;
+  const M sigma = generateSigma<M>();
+  auto f = deviator(sigma);
+  const M expected = sigma - M::Identity();
+  EXPECT_TRUE( f() == expected );
+  EXPECT_TRUE( M(f.d1<0>(sigma)) == expected );
+}
+
+TEST(DeviatorTest,D1_Dynamic)
+{
+  using namespace FunG::LinearAlgebra;
+  const DM sigma = generateSigma<DM>();
+  auto f = deviator(sigma);
+  const DM expected = sigma - DM::Identity(3,3);
+  EXPECT_TRUE( f() == expected );
+  EXPECT_TRUE( DM(f.d1<0>(sigma)) == expected );
+}
+
+TEST(DeviatorTest,SharedUnitMatrix)
+{
+  using namespace FunG::LinearAlgebra;
+  EXPECT_TRUE( cachedUnitMatrix<DM>(3) == DM::Identity(3,3) );
+  EXPECT_TRUE( cachedUnitMatrix<DM>(2) == DM::Identity(2,2) );
+  EXPECT_EQ( &cachedUnitMatrix<DM>(3), &cachedUnitMatrix<DM>(3) );
+  EXPECT_EQ( &cachedUnitMatrix<M>(), &cachedUnitMatrix<M>() );
+
+  const DM sigma = generateSigma<DM>();
+  auto f = deviator(sigma);
+  auto g = deviator(DM(2*sigma));
+  EXPECT_TRUE( f() == sigma - DM::Identity(3,3) );
+  EXPECT_TRUE( g() == 2*sigma - 2*DM::Identity(3,3) );
+}
+
+TEST(SecondDeviatoricInvariantTest,Derivatives)
+{
+  using namespace FunG::LinearAlgebra;
+  const M sigma = generateSigma<M>(), dSigma = generateDSigma<M>();
+  auto f = FunG::finalize( j2(sigma) );
+  EXPECT_DOUBLE_EQ( f(), 1 );
+  EXPECT_DOUBLE_EQ( f.d1(sigma), 1 );
+  EXPECT_DOUBLE_EQ( f.d1(dSigma), 1 );
+  EXPECT_DOUBLE_EQ( f.d2(dSigma,dSigma), 0 );
+  EXPECT_DOUBLE_EQ( f.d2(M::Identity(),dSigma), 0 );
+}
+
+TEST(SecondDeviatoricInvariantTest,Derivatives_Dynamic)
+{
+  using namespace FunG::LinearAlgebra;
+  const DM sigma = generateSigma<DM>(), dSigma = generateDSigma<DM>();
+  auto f = FunG::finalize( j2(sigma) );
+  EXPECT_DOUBLE_EQ( f(), 1 );
+  EXPECT_DOUBLE_EQ( f.d1(sigma), 1 );
+  EXPECT_DOUBLE_EQ( f.d1(dSigma), 1 );
+  EXPECT_DOUBLE_EQ( f.d2(dSigma,dSigma), 0 );
+}
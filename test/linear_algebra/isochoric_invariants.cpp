@@ -0,0 +1,113 @@
+#define FUNG_ENABLE_EXCEPTIONS
+
+#include <fung/finalize.hh>
+#include <fung/identity.hh>
+#include <fung/linear_algebra.hh>
+
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+
+namespace
+{
+    template < class Matrix >
+    Matrix generateA( int n )
+    {
+        Matrix A( n, n );
+        if ( n == 2 )
+            A << 1.1, 0.2, -0.1, 0.9;
+        else
+            A << 1.1, 0.1, 0, 0.2, 1, 0.1, 0, -0.1, 0.9;
+        return A;
+    }
+
+    template < class Matrix >
+    Matrix generateM( int n )
+    {
+        Matrix M( n, n );
+        if ( n == 2 )
+            M << 0.6, 0.3, 0.1, 0.4;
+        else
+            M << 0.6, 0.3, 0, 0.1, 0.3, 0.2, 0.1, 0, 0.1;
+        return M;
+    }
+
+    template < class Matrix >
+    Matrix direction( int n, int i, int j )
+    {
+        Matrix dA = Matrix::Identity( n, n );
+        dA( i, j ) += 1;
+        return dA;
+    }
+
+    template < class Matrix, class F, class G >
+    void expectSameDerivatives( F f, G g, int n )
+    {
+        const Matrix A = generateA< Matrix >( n );
+        const Matrix dA = direction< Matrix >( n, 0, 1 ), dB = direction< Matrix >( n, 1, 0 ),
+                     dC = direction< Matrix >( n, n - 1, 0 );
+        f.update( A );
+        g.update( A );
+        EXPECT_NEAR( f(), g(), 1e-13 );
+        EXPECT_NEAR( f.d1( dA ), g.d1( dA ), 1e-13 );
+        EXPECT_NEAR( f.d2( dA, dB ), g.d2( dA, dB ), 1e-13 );
+        EXPECT_NEAR( f.d3( dA, dB, dC ), g.d3( dA, dB, dC ), 1e-12 );
+    }
+
+    template < class Matrix, int n >
+    void compareWithComposition( int rows = n )
+    {
+        using namespace FunG;
+        using namespace FunG::LinearAlgebra;
+        const Matrix A = generateA< Matrix >( rows );
+        const Matrix M = generateM< Matrix >( rows );
+        const auto id = identity( A );
+
+        expectSameDerivatives< Matrix >( finalize( mi1< Matrix, n >( A ) ),
+                                         finalize( i1( A ) * pow< -1, n >( det( A ) ) ), rows );
+        expectSameDerivatives< Matrix >( finalize( mi2< Matrix, n >( A ) ),
+                                         finalize( i2( A ) * pow< -2, n >( det( A ) ) ), rows );
+        expectSameDerivatives< Matrix >( finalize( mi4< Matrix, Matrix, n >( A, M ) ),
+                                         finalize( i4( A, M ) * pow< -1, n >( det( A ) ) ), rows );
+        expectSameDerivatives< Matrix >(
+            finalize( mi5< Matrix, Matrix, n >( A, M ) ),
+            finalize( i1( id * id * M ) * pow< -2, n >( det( A ) ) ), rows );
+        expectSameDerivatives< Matrix >( finalize( mi6< Matrix, Matrix, n >( A, M ) ),
+                                         finalize( i6( A, M ) * pow< -1, n >( det( A ) ) ), rows );
+    }
+}
+
+TEST( IsochoricInvariantTest, Matrix3x3 )
+{
+    compareWithComposition< Eigen::Matrix3d, 3 >();
+}
+
+TEST( IsochoricInvariantTest, Matrix2x2 )
+{
+    compareWithComposition< Eigen::Matrix2d, 2 >();
+}
+
+TEST( IsochoricInvariantTest, DynamicMatrix )
+{
+    compareWithComposition< Eigen::MatrixXd, 3 >( 3 );
+    compareWithComposition< Eigen::MatrixXd, 2 >( 2 );
+}
+
+TEST( IsochoricInvariantTest, ChainedWithStrainTensor )
+{
+    using namespace FunG;
+    using namespace FunG::LinearAlgebra;
+    using Matrix = Eigen::Matrix3d;
+    const Matrix F = generateA< Matrix >( 3 );
+    const Matrix M = generateM< Matrix >( 3 );
+    const auto S = strainTensor( F );
+
+    expectSameDerivatives< Matrix >(
+        finalize( mi1< decltype( S ), 3 >( S ) + mi6< decltype( S ), Matrix, 3 >( S, M ) ),
+        finalize( i1( S ) * pow< -1, 3 >( det( S ) ) +
+                  i1( ( constant( M ) ^ 2 ) * S ) * pow< -1, 3 >( det( S ) ) ),
+        3 );
+    expectSameDerivatives< Matrix >(
+        finalize( mi5< decltype( S ), Matrix, 3 >( S, M ) ),
+        finalize( i1( S * S * M ) * pow< -2, 3 >( det( S ) ) ), 3 );
+}
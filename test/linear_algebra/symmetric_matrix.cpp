@@ -0,0 +1,163 @@
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+
+#define FUNG_ENABLE_EXCEPTIONS
+#include <fung/finalize.hh>
+#include <fung/linear_algebra.hh>
+#include <fung/linear_algebra/cofactor.hh>
+#include <fung/linear_algebra/symmetric_matrix.hh>
+
+namespace
+{
+  using M = Eigen::Matrix<double,3,3>;
+  using S = FunG::LinearAlgebra::SymmetricMatrix<double,3>;
+  using M2 = Eigen::Matrix<double,2,2>;
+  using S2 = FunG::LinearAlgebra::SymmetricMatrix<double,2>;
+
+  template <class Symmetric, class Matrix>
+  Symmetric toSymmetric(const Matrix& A)
+  {
+    Symmetric B;
+    for(int i=0; i<A.rows(); ++i)
+      for(int j=i; j<A.cols(); ++j)
+        B(i,j) = A(i,j);
+    return B;
+  }
+
+  M generateA()
+  {
+    M A;
+    A << 2, 1, 0.5,
+         1, 3, -1,
+         0.5, -1, 4;
+    return A;
+  }
+
+  M generateDA1()
+  {
+    M A;
+    A << 1, 0.2, -0.3,
+         0.2, -1, 0.7,
+         -0.3, 0.7, 0.5;
+    return A;
+  }
+
+  M generateDA2()
+  {
+    M A;
+    A << -0.5, 1, 0.1,
+         1, 2, 0.3,
+         0.1, 0.3, -1;
+    return A;
+  }
+
+  M generateF()
+  {
+    M F;
+    F << 1.1, 0.1, 0,
+         0.2, 1, 0.1,
+         0, -0.1, 0.9;
+    return F;
+  }
+}
+
+TEST(SymmetricMatrixTest,Access)
+{
+  S A(0.);
+  A(2,1) = 3;
+  EXPECT_EQ( A(1,2), 3 );
+  EXPECT_EQ( A.packed(FunG::packedIndex(1,2,3)), 3 );
+  EXPECT_EQ( S::size(), 6 );
+  EXPECT_EQ( FunG::LinearAlgebra::dim<S>(), 3 );
+  EXPECT_EQ( FunG::LinearAlgebra::rows<S2>(), 2 );
+  EXPECT_EQ( FunG::LinearAlgebra::cols<S2>(), 2 );
+  EXPECT_TRUE( FunG::Checks::isConstantSize<S>() );
+  EXPECT_EQ( FunG::zero<S>(), S(0.) );
+  EXPECT_EQ( FunG::at(A,1,2), 3 );
+  EXPECT_EQ( (2*A - A)(1,2), 3 );
+}
+
+TEST(SymmetricMatrixTest,Determinant)
+{
+  using FunG::LinearAlgebra::det;
+  const M A = generateA(), dA1 = generateDA1(), dA2 = generateDA2();
+  const S sA = toSymmetric<S>(A), sdA1 = toSymmetric<S>(dA1), sdA2 = toSymmetric<S>(dA2);
+  auto f = det(A);
+  auto g = det(sA);
+
+  EXPECT_NEAR( g(), f(), 1e-13 );
+  EXPECT_NEAR( g.d1(sdA1), f.d1(dA1), 1e-13 );
+  EXPECT_NEAR( g.d2(sdA1,sdA2), f.d2(dA1,dA2), 1e-13 );
+  EXPECT_NEAR( g.d3(sdA1,sdA2,sdA1), f.d3(dA1,dA2,dA1), 1e-13 );
+
+  const M2 B = A.topLeftCorner<2,2>(), dB1 = dA1.topLeftCorner<2,2>(), dB2 = dA2.topLeftCorner<2,2>();
+  auto f2 = det(B);
+  auto g2 = det(toSymmetric<S2>(B));
+  EXPECT_NEAR( g2(), f2(), 1e-13 );
+  EXPECT_NEAR( g2.d1(toSymmetric<S2>(dB1)), f2.d1(dB1), 1e-13 );
+  EXPECT_NEAR( g2.d2(toSymmetric<S2>(dB1),toSymmetric<S2>(dB2)), f2.d2(dB1,dB2), 1e-13 );
+}
+
+TEST(SymmetricMatrixTest,SecondPrincipalInvariant)
+{
+  using FunG::LinearAlgebra::i2;
+  const M A = generateA(), dA1 = generateDA1(), dA2 = generateDA2();
+  const S sA = toSymmetric<S>(A), sdA1 = toSymmetric<S>(dA1), sdA2 = toSymmetric<S>(dA2);
+  auto f = i2(A);
+  auto g = i2(sA);
+
+  EXPECT_NEAR( g(), f(), 1e-13 );
+  EXPECT_NEAR( g.d1(sdA1), f.d1(dA1), 1e-13 );
+  EXPECT_NEAR( g.d2(sdA1,sdA2), f.d2(dA1,dA2), 1e-13 );
+}
+
+TEST(SymmetricMatrixTest,TraceAndFrobeniusNorm)
+{
+  using namespace FunG::LinearAlgebra;
+  const M A = generateA(), dA1 = generateDA1(), dA2 = generateDA2();
+  const S sA = toSymmetric<S>(A), sdA1 = toSymmetric<S>(dA1), sdA2 = toSymmetric<S>(dA2);
+
+  EXPECT_DOUBLE_EQ( trace(sA)(), trace(A)() );
+  EXPECT_DOUBLE_EQ( trace(sA).d1(sdA1), trace(A).d1(dA1) );
+
+  auto f = SquaredFrobeniusNorm<M>(A);
+  auto g = SquaredFrobeniusNorm<S>(sA);
+  EXPECT_NEAR( g(), f(), 1e-13 );
+  EXPECT_NEAR( g.d1(sdA1), f.d1(dA1), 1e-13 );
+  EXPECT_NEAR( g.d2(sdA1,sdA2), f.d2(dA1,dA2), 1e-13 );
+}
+
+TEST(SymmetricMatrixTest,Cofactor)
+{
+  using FunG::LinearAlgebra::computeCofactor;
+  const M A = generateA();
+  const S sA = toSymmetric<S>(A);
+
+  EXPECT_DOUBLE_EQ( (computeCofactor<0,1>(sA)), (computeCofactor<0,1>(A)) );
+  EXPECT_DOUBLE_EQ( (computeCofactor<2,0>(sA)), (computeCofactor<2,0>(A)) );
+  EXPECT_DOUBLE_EQ( (computeCofactor<1,1>(sA)), (computeCofactor<1,1>(A)) );
+}
+
+TEST(SymmetricMatrixTest,StrainTensor)
+{
+  using namespace FunG::LinearAlgebra;
+  const M F = generateF(), dF1 = generateDA1() + M::Identity(), dF2 = generateDA2() * generateF();
+  auto f = strainTensor(F);
+  auto g = symmetricStrainTensor(F);
+
+  const M C = f(), dC = f.d1(dF1), ddC = f.d2(dF1,dF2);
+  const S sC = g(), sdC = g.d1(dF1), sddC = g.d2(dF1,dF2);
+  for(int i=0; i<3; ++i)
+    for(int j=0; j<3; ++j)
+    {
+      EXPECT_NEAR( sC(i,j), C(i,j), 1e-14 );
+      EXPECT_NEAR( sdC(i,j), dC(i,j), 1e-14 );
+      EXPECT_NEAR( sddC(i,j), ddC(i,j), 1e-14 );
+    }
+
+  auto h = FunG::finalize( det(symmetricStrainTensor(F)) );
+  auto k = FunG::finalize( det(strainTensor(F)) );
+  EXPECT_NEAR( h(), k(), 1e-13 );
+  EXPECT_NEAR( h.d1(dF1), k.d1(dF1), 1e-13 );
+  EXPECT_NEAR( h.d2(dF1,dF2), k.d2(dF1,dF2), 1e-13 );
+}
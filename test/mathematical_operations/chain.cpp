@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
+#include "fung/cmath/cosine.hh"
+#include "fung/cmath/log.hh"
 #include "fung/cmath/pow.hh"
+#include "fung/cmath/sine.hh"
 #include "fung/finalize.hh"
 #include "fung/generate.hh"
 
@@ -40,3 +43,19 @@ TEST(ChainTest, D3) {
   auto val = 3. / 8 * Pow<-5, 2>(4.)();
   EXPECT_DOUBLE_EQ(fun.d3(1, 1, 1), val);
 }
+
+TEST(ChainTest, UpdateWithEvaluationOrder) {
+  using namespace FunG;
+  auto fun = finalize(2 * (ln(Pow<1, 4>(1.) << Pow<2>(1.)) + Sin(1.) * Cos(1.)));
+  auto ref = fun;
+  ref.update(4.);
+
+  fun.update(4., ValueOnly());
+  EXPECT_DOUBLE_EQ(fun(), ref());
+  fun.update(4., UpToFirstDerivative());
+  EXPECT_DOUBLE_EQ(fun(), ref());
+  EXPECT_DOUBLE_EQ(fun.d1(1.), ref.d1(1.));
+  fun.update(4., UpToSecondDerivative());
+  EXPECT_DOUBLE_EQ(fun.d1(1.), ref.d1(1.));
+  EXPECT_DOUBLE_EQ(fun.d2(1., 1.), ref.d2(1., 1.));
+}